@@ -47,5 +47,15 @@ if(NOT ${MCRL2_ENABLE_DEBUG_SOUNDNESS_CHECKS})
   add_definitions(-DMCRL2_NO_SOUNDNESS_CHECKS)
 endif()
 
+# Add the definition that makes the term library thread-safe.
+if(${MCRL2_ENABLE_THREADSAFE})
+  add_definitions(-DMCRL2_THREADSAFE)
+endif()
+
+# Add the definition that selects open addressing hash sets for the term storages.
+if(${MCRL2_ENABLE_OPEN_ADDRESSING_TERM_SETS})
+  add_definitions(-DMCRL2_TERM_POOL_OPEN_ADDRESSING)
+endif()
+
 # Check supported C++11 features
 include(CheckCXX11Features)
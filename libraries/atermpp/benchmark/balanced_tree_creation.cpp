@@ -0,0 +1,68 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark_shared.h"
+
+#include "mcrl2/atermpp/aterm_balanced_tree.h"
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+using namespace atermpp;
+
+int main(int argc, char* argv[])
+{
+  std::size_t length = 20;
+  std::size_t amount = 250000;
+
+  // Accept one argument for the length of the state vectors.
+  if (argc > 1)
+  {
+    length = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+
+  // The values of the state vector, where each state changes only a few positions like successor states do.
+  std::vector<aterm_int> values(length, aterm_int(0));
+  std::vector<term_balanced_tree<aterm_int>> states;
+  states.reserve(amount);
+
+  stopwatch stopwatch;
+  for (std::size_t i = 0; i < amount; ++i)
+  {
+    values[i % length] = aterm_int(i % 97);
+    values[(i * 7) % length] = aterm_int(i % 13);
+    states.emplace_back(values.begin(), length);
+  }
+  std::cerr << "Creating " << amount << " state vectors of length " << length << " took " << stopwatch.time() << " milliseconds.\n";
+
+  // Read every value of every state, which is logarithmic in the length for each value.
+  stopwatch.reset();
+  std::size_t sum = 0;
+  for (const term_balanced_tree<aterm_int>& state : states)
+  {
+    for (std::size_t j = 0; j < length; ++j)
+    {
+      sum += state[j].value();
+    }
+  }
+  std::cerr << "Reading all values of " << amount << " state vectors of length " << length << " took " << stopwatch.time() << " milliseconds (sum " << sum << ").\n";
+
+  // Iterate over every value of every state.
+  stopwatch.reset();
+  sum = 0;
+  for (const term_balanced_tree<aterm_int>& state : states)
+  {
+    for (const aterm_int& value : state)
+    {
+      sum += value.value();
+    }
+  }
+  std::cerr << "Iterating over " << amount << " state vectors of length " << length << " took " << stopwatch.time() << " milliseconds (sum " << sum << ").\n";
+
+  return 0;
+}
@@ -15,3 +15,26 @@ echo "Running nested function application with trivial converter benchmark from
 for i in 0 1 2 4 7 8 12 16 20 26 32; do
   perf stat benchmark_atermpp_function_application_with_converter_creation $i
 done;
+
+echo "Running term input and output benchmarks"
+for format in binary streamable text; do
+  perf stat benchmark_atermpp_term_io $format
+done;
+
+echo "Running hash table load benchmarks for 100 thousand to 4 million terms"
+for i in 100 1000 4000; do
+  perf stat benchmark_atermpp_hashtable_load $i
+done;
+
+echo "Running balanced tree benchmarks for state vectors of length 10 to 200"
+for i in 10 50 200; do
+  perf stat benchmark_atermpp_balanced_tree_creation $i
+done;
+
+echo "Running builder traversal benchmark"
+perf stat benchmark_atermpp_builder_traversal
+
+echo "Running threaded term creation benchmarks from 1 to 8 threads"
+for i in 1 2 4 8; do
+  perf stat benchmark_atermpp_threaded_creation $i
+done;
@@ -10,6 +10,7 @@
 #include "mcrl2/atermpp/aterm_appl.h"
 
 #include "mcrl2/atermpp/detail/aterm_list.h"
+#include "mcrl2/atermpp/term_pool_thread.h"
 
 #include <vector>
 #include <thread>
@@ -23,13 +24,19 @@ void benchmark_threads(std::size_t number_of_threads, F f)
   std::vector<std::thread> threads(number_of_threads - 1);
   for (auto& thread : threads)
   {
-    thread = std::thread(f);
+    thread = std::thread([&f]()
+      {
+        // Every thread that accesses terms must be registered with the term pool.
+        term_pool_thread_guard guard;
+        f();
+      });
   }
 
   // Run the benchmark on the main thread as well.
   f();
 
-  // Wait for all threads to complete.
+  // Wait for all threads to complete, which might collect garbage in the mean time.
+  term_pool_safe_region region;
   for (auto& thread : threads)
   {
     thread.join();
@@ -0,0 +1,76 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark_shared.h"
+
+#include "mcrl2/atermpp/builder.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+using namespace atermpp;
+
+/// \brief Rebuilds every term, which results in the same term.
+struct identity_builder : public builder<identity_builder>
+{
+  using builder<identity_builder>::apply;
+};
+
+/// \brief Replaces every leaf c by d.
+struct replace_builder : public builder<replace_builder>
+{
+  using builder<replace_builder>::apply;
+
+  aterm apply(const aterm_appl& x)
+  {
+    if (x.function() == m_from)
+    {
+      return m_to;
+    }
+    return builder<replace_builder>::apply(x);
+  }
+
+  function_symbol m_from = function_symbol("c", 0);
+  aterm_appl m_to = aterm_appl(function_symbol("d", 0));
+};
+
+int main(int argc, char* argv[])
+{
+  std::size_t depth = 20;
+  std::size_t iterations = 5;
+
+  // Accept one argument for the depth of the term.
+  if (argc > 1)
+  {
+    depth = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+
+  // The builders do not maintain a cache, so the traversal visits 2^depth subterms of this maximally shared term.
+  aterm_appl term = create_nested_function("f", "c", 2, depth);
+
+  stopwatch stopwatch;
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    identity_builder builder;
+    if (builder.apply(term) != term)
+    {
+      std::cerr << "The identity builder changed the term.\n";
+      return 1;
+    }
+  }
+  std::cerr << "Rebuilding a term of depth " << depth << " took " << stopwatch.time() / iterations << " milliseconds.\n";
+
+  stopwatch.reset();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    replace_builder builder;
+    builder.apply(term);
+  }
+  std::cerr << "Replacing the leaves of a term of depth " << depth << " took " << stopwatch.time() / iterations << " milliseconds.\n";
+
+  return 0;
+}
@@ -0,0 +1,70 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark_shared.h"
+
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+using namespace atermpp;
+
+int main(int argc, char* argv[])
+{
+  std::size_t amount = 1000000;
+  std::size_t lookups = 10000000;
+
+  // Accept one argument for the number of terms (in thousands) that are stored in the term pool.
+  if (argc > 1)
+  {
+    amount = static_cast<std::size_t>(std::stoi(argv[1])) * 1000;
+  }
+
+  detail::g_term_pool().enable_garbage_collection(false);
+
+  // Create the terms f(i, i) for all i, which are distributed over the hash table by their arguments.
+  function_symbol f("f", 2);
+  std::vector<aterm_int> integers;
+  integers.reserve(amount);
+  std::vector<aterm_appl> terms;
+  terms.reserve(amount);
+
+  stopwatch stopwatch;
+  for (std::size_t i = 0; i < amount; ++i)
+  {
+    integers.emplace_back(i);
+    terms.emplace_back(f, integers[i], integers[i]);
+  }
+  std::cerr << "Creating " << amount << " terms took " << stopwatch.time() << " milliseconds.\n";
+
+  const std::size_t size = detail::g_term_pool().size();
+  const std::size_t capacity = detail::g_term_pool().capacity();
+  std::cerr << "The term pool stores " << size << " terms in " << capacity << " buckets, a load factor of "
+            << static_cast<double>(size) / static_cast<double>(capacity) << ".\n";
+
+  // Look up existing terms in a different order than they were created, i.e., a pseudo random walk.
+  stopwatch.reset();
+  std::size_t index = 0;
+  for (std::size_t i = 0; i < lookups; ++i)
+  {
+    index = (index + 7919) % amount;
+    aterm_appl term(f, integers[index], integers[index]);
+  }
+  std::cerr << "Finding " << lookups << " existing terms took " << stopwatch.time() << " milliseconds.\n";
+
+  // Look up existing terms in the order that they were created.
+  stopwatch.reset();
+  for (std::size_t i = 0; i < lookups; ++i)
+  {
+    index = i % amount;
+    aterm_appl term(f, integers[index], integers[index]);
+  }
+  std::cerr << "Finding " << lookups << " existing terms in creation order took " << stopwatch.time() << " milliseconds.\n";
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark_shared.h"
+
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/atermpp/aterm_io.h"
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <sstream>
+
+using namespace atermpp;
+
+/// \brief Creates a list of terms f(i, g(i mod 100), [i, i + 1]) that share many of their subterms.
+static aterm_list create_terms(std::size_t amount)
+{
+  function_symbol f("f", 3);
+  function_symbol g("g", 1);
+
+  aterm_list result;
+  for (std::size_t i = 0; i < amount; ++i)
+  {
+    aterm_list arguments;
+    arguments.push_front(aterm_int(i + 1));
+    arguments.push_front(aterm_int(i));
+    result.push_front(aterm_appl(f, aterm_int(i), aterm_appl(g, aterm_int(i % 100)), arguments));
+  }
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t amount = 200000;
+  std::size_t iterations = 10;
+
+  // Accept one argument for the format, which is either binary, streamable or text.
+  std::string format = "binary";
+  if (argc > 1)
+  {
+    format = argv[1];
+  }
+
+  aterm_list terms = create_terms(amount);
+
+  long long write_time = 0;
+  long long read_time = 0;
+  std::size_t bytes = 0;
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    std::stringstream stream;
+
+    stopwatch stopwatch;
+    if (format == "text")
+    {
+      write_term_to_text_stream(terms, stream);
+    }
+    else if (format == "streamable")
+    {
+      binary_aterm_ostream output(stream);
+      for (const aterm& term : terms)
+      {
+        output << term;
+      }
+    }
+    else
+    {
+      write_term_to_binary_stream(terms, stream);
+    }
+    write_time += stopwatch.time();
+    bytes = stream.str().size();
+
+    stopwatch.reset();
+    if (format == "text")
+    {
+      read_term_from_text_stream(stream);
+    }
+    else if (format == "streamable")
+    {
+      binary_aterm_istream input(stream);
+      aterm term;
+      while (input.get(term)) {}
+    }
+    else
+    {
+      read_term_from_binary_stream(stream);
+    }
+    read_time += stopwatch.time();
+  }
+
+  std::cerr << "Writing " << amount << " terms in the " << format << " format (" << bytes << " bytes) took " << write_time / iterations << " milliseconds.\n";
+  std::cerr << "Reading " << amount << " terms in the " << format << " format (" << bytes << " bytes) took " << read_time / iterations << " milliseconds.\n";
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark_shared.h"
+
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <atomic>
+
+using namespace atermpp;
+
+int main(int argc, char* argv[])
+{
+  std::size_t number_of_threads = 1;
+  std::size_t amount = 4000000;
+
+  // Accept one argument for the number of threads.
+  if (argc > 1)
+  {
+    number_of_threads = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+
+  if (!detail::GlobalThreadSafe && number_of_threads > 1)
+  {
+    std::cerr << "The term library is not thread-safe (MCRL2_ENABLE_THREADSAFE is OFF), using a single thread.\n";
+    number_of_threads = 1;
+  }
+
+  // Every thread creates the same amount of terms, so the total time remains equal when creation scales perfectly.
+  std::atomic<std::size_t> next_thread(0);
+  auto create_terms = [amount, &next_thread]() -> void
+    {
+      function_symbol f("f", 2);
+
+      // Half of the terms are shared between the threads, the other half is unique to each thread.
+      const std::size_t offset = (next_thread++ + 1) * amount;
+      aterm_appl shared(function_symbol("c", 0));
+      for (std::size_t i = 0; i < amount / 2; ++i)
+      {
+        shared = aterm_appl(f, aterm_int(i), shared);
+        aterm_appl unique(f, aterm_int(offset + i), shared);
+      }
+    };
+
+  stopwatch stopwatch;
+  benchmark_threads(number_of_threads, create_terms);
+  std::cerr << "Creating " << amount << " terms on each of " << number_of_threads << " threads took " << stopwatch.time() << " milliseconds.\n";
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/atermpp/aterm_io_binary.h
+/// \brief Append-only streams of terms in a compact binary format.
+
+#ifndef MCRL2_ATERMPP_ATERM_IO_BINARY_H
+#define MCRL2_ATERMPP_ATERM_IO_BINARY_H
+
+#include "mcrl2/atermpp/aterm.h"
+#include "mcrl2/atermpp/function_symbol.h"
+#include "mcrl2/utilities/bitstream.h"
+#include "mcrl2/utilities/indexed_set.h"
+
+#include <vector>
+
+namespace atermpp
+{
+
+/// \brief Writes terms to a stream one at a time in a streamable binary format.
+/// \details Every term is written as a sequence of packets that define the function symbols and
+///          subterms that were not written before, followed by a reference to the term itself. The
+///          tables of function symbols and subterms grow incrementally, so subterms are shared between
+///          all terms written to the same stream and no term is collected before writing starts.
+///          The end of the stream is written on destruction.
+class binary_aterm_ostream : private mcrl2::utilities::noncopyable
+{
+public:
+  /// \brief Writes the header of the stream.
+  explicit binary_aterm_ostream(std::ostream& os);
+
+  /// \brief Writes the end of the stream.
+  ~binary_aterm_ostream();
+
+  /// \brief Writes the given term to the stream.
+  void put(const aterm& term);
+
+private:
+  /// \returns The index of the given function symbol, which is written to the stream when it is new.
+  std::size_t write_function_symbol(const function_symbol& symbol);
+
+  mcrl2::utilities::obitstream m_stream;
+
+  mcrl2::utilities::indexed_set<function_symbol> m_function_symbols; ///< The function symbols that have been written.
+  mcrl2::utilities::indexed_set<aterm> m_terms;                      ///< The (sub)terms that have been written.
+};
+
+/// \brief Reads terms written by a binary_aterm_ostream lazily, i.e., one at a time.
+class binary_aterm_istream : private mcrl2::utilities::noncopyable
+{
+public:
+  /// \brief Reads the header of the stream.
+  /// \throws mcrl2::runtime_error when the stream is not a binary term stream.
+  explicit binary_aterm_istream(std::istream& is);
+
+  /// \brief Reads the next term of the stream.
+  /// \returns False when the end of the stream has been reached, in which case term is unchanged.
+  /// \throws mcrl2::runtime_error when the stream is malformed.
+  bool get(aterm& term);
+
+private:
+  mcrl2::utilities::ibitstream m_stream;
+  bool m_end_of_stream = false;
+
+  std::vector<function_symbol> m_function_symbols; ///< The function symbols that have been read.
+  std::vector<aterm> m_terms;                      ///< The (sub)terms that have been read.
+};
+
+/// \brief Writes the given term to the binary term stream.
+inline binary_aterm_ostream& operator<<(binary_aterm_ostream& stream, const aterm& term)
+{
+  stream.put(term);
+  return stream;
+}
+
+/// \brief Writes the term to the given file as a snapshot, which is a binary term stream that only contains this term.
+void write_term_to_snapshot(const aterm& term, const std::string& filename);
+
+/// \brief Reads the term from a snapshot written by write_term_to_snapshot.
+/// \details The file is mapped into memory and the terms are created directly from the mapped
+///          region, which avoids copying its contents into intermediate stream buffers.
+/// \throws mcrl2::runtime_error when the file cannot be read or is not a snapshot.
+aterm read_term_from_snapshot(const std::string& filename);
+
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_ATERM_IO_BINARY_H
@@ -17,6 +17,7 @@
 #include "mcrl2/utilities/shared_reference.h"
 #include "mcrl2/atermpp/type_traits.h"
 
+#include <atomic>
 #include <limits>
 
 namespace atermpp
@@ -44,7 +45,8 @@ public:
 
   /// \brief Create a term from a function symbol.
   _aterm(const function_symbol& symbol) :
-    m_function_symbol(symbol)
+    m_function_symbol(symbol),
+    m_normal_form_tag(0)
   {}
 
   function_symbol& function() noexcept
@@ -66,6 +68,20 @@ public:
     increment_reference_count_changes();
   }
 
+  /// \brief Mark this term whenever it is not reachable.
+  /// \details Can be called concurrently for the same term when GlobalThreadSafe is true.
+  /// \returns True iff the term was marked by this call.
+  bool try_mark()
+  {
+    if (compare_and_set(m_reference_count, 0, MarkedReferenceCount))
+    {
+      increment_reference_count_changes();
+      return true;
+    }
+
+    return false;
+  }
+
   /// \brief Remove the mark from a term.
   /// \details Changes the reference count, so only apply whenever it was marked.
   void reset()
@@ -91,8 +107,63 @@ public:
     return m_reference_count > 0;
   }
 
+  /// \returns The tag of the rewriter that has established that this term is a normal form, or zero.
+  std::size_t normal_form_tag() const noexcept
+  {
+    return load(m_normal_form_tag);
+  }
+
+  /// \brief Record that this term is a normal form for the rewriter with the given tag.
+  /// \details Terms are shared, so a term can only remember the last rewriter that tagged it. This does not
+  ///          change the term itself, and can therefore also be applied to terms that are already shared.
+  void set_normal_form_tag(std::size_t tag) const noexcept
+  {
+    store(m_normal_form_tag, tag);
+  }
+
 private:
+  using TagType = typename std::conditional<GlobalThreadSafe, std::atomic<std::size_t>, std::size_t>::type;
+
+  static std::size_t load(const std::atomic<std::size_t>& value) noexcept
+  {
+    return value.load(std::memory_order_relaxed);
+  }
+
+  static std::size_t load(const std::size_t& value) noexcept
+  {
+    return value;
+  }
+
+  static void store(std::atomic<std::size_t>& value, std::size_t desired) noexcept
+  {
+    value.store(desired, std::memory_order_relaxed);
+  }
+
+  static void store(std::size_t& value, std::size_t desired) noexcept
+  {
+    value = desired;
+  }
+
+  /// \brief Sets value to desired when it is equal to expected.
+  /// \returns True iff the value was changed.
+  static bool compare_and_set(std::atomic<std::size_t>& value, std::size_t expected, std::size_t desired)
+  {
+    return value.compare_exchange_strong(expected, desired);
+  }
+
+  static bool compare_and_set(std::size_t& value, std::size_t expected, std::size_t desired)
+  {
+    if (value == expected)
+    {
+      value = desired;
+      return true;
+    }
+
+    return false;
+  }
+
   function_symbol m_function_symbol;
+  mutable TagType m_normal_form_tag;
 };
 
 inline _aterm* address(const unprotected_aterm& t);
@@ -16,7 +16,17 @@ namespace detail
 {
 
 /// \brief Enables thread safety for the global term and function symbol pools.
+/// \details Set by the MCRL2_ENABLE_THREADSAFE CMake option. Threads other than the one
+///          that initialised the term pool must register themselves using a
+///          term_pool_thread_guard before they access terms.
+#ifdef MCRL2_THREADSAFE
+constexpr static bool GlobalThreadSafe = true;
+#else
 constexpr static bool GlobalThreadSafe = false;
+#endif
+
+// The metrics below are compiled in when enabled, they can also be enabled at run time using
+// aterm_pool::enable_metrics() or by setting the MCRL2_TERM_POOL_METRICS environment variable.
 
 /// \brief Enable to print garbage collection statistics.
 constexpr static bool EnableGarbageCollectionMetrics = false;
@@ -27,8 +37,17 @@ constexpr static bool EnableTermHashtableMetrics = false;
 /// \brief Enable to obtain the percentage of terms found compared to allocated.
 constexpr static bool EnableTermCreationMetrics = false;
 
+/// \brief Enable to store the terms with a fixed number of arguments in hash sets that use open addressing
+///        instead of chaining, which avoids following a pointer for every collision during term creation.
+/// \details Set by the MCRL2_ENABLE_OPEN_ADDRESSING_TERM_SETS CMake option.
+#ifdef MCRL2_TERM_POOL_OPEN_ADDRESSING
+constexpr static bool EnableOpenAddressingTermSets = true;
+#else
+constexpr static bool EnableOpenAddressingTermSets = false;
+#endif
+
 /// \brief Enable garbage collection.
-constexpr static bool EnableGarbageCollection = true && !GlobalThreadSafe;
+constexpr static bool EnableGarbageCollection = true;
 
 } // namespace detail
 } // namespace atermpp
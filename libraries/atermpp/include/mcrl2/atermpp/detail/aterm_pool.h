@@ -14,8 +14,18 @@
 #include "mcrl2/atermpp/detail/aterm_configuration.h"
 #include "mcrl2/atermpp/detail/aterm_pool_storage.h"
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
-
+#include "mcrl2/atermpp/term_heap_profile.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace atermpp
 {
@@ -23,29 +33,37 @@ namespace detail
 {
 
 /// Define several specializations of the term pool storage objects.
-using integer_term_storage = aterm_pool_storage<_aterm_int, aterm_int_hasher, aterm_int_equals, 0, GlobalThreadSafe>;
-using term_storage = aterm_pool_storage<_aterm, aterm_hasher_finite<0>, aterm_equals_finite<0>, 0, GlobalThreadSafe>;
+/// The storages of terms with a fixed number of arguments, which contain most terms, use open addressing when
+/// EnableOpenAddressingTermSets is set. The storage of terms with a large number of arguments always uses chaining.
+using integer_term_storage = aterm_pool_storage<_aterm_int, aterm_int_hasher, aterm_int_equals, 0, GlobalThreadSafe, EnableOpenAddressingTermSets>;
+using term_storage = aterm_pool_storage<_aterm, aterm_hasher_finite<0>, aterm_equals_finite<0>, 0, GlobalThreadSafe, EnableOpenAddressingTermSets>;
 using arbitrary_function_application_storage = aterm_pool_storage<_aterm_appl<1>,
   aterm_hasher<DynamicNumberOfArguments>,
   aterm_equals<DynamicNumberOfArguments>,
   DynamicNumberOfArguments,
-  GlobalThreadSafe>;
+  GlobalThreadSafe,
+  false>;
 
 template<std::size_t N>
-using function_application_storage = aterm_pool_storage<_aterm_appl<N>, aterm_hasher_finite<N>, aterm_equals_finite<N>, N, GlobalThreadSafe>;
+using function_application_storage = aterm_pool_storage<_aterm_appl<N>, aterm_hasher_finite<N>, aterm_equals_finite<N>, N, GlobalThreadSafe, EnableOpenAddressingTermSets>;
 
 /// \brief The interface for the term library. Provides the storage of
 ///        of all classes of terms.
 /// \details Internally uses different storage objects to store specific
 ///          classes of terms. For a given term creation it can decide what
 ///          storage to use at run-time using its function symbol.
+///
+///          When GlobalThreadSafe is true terms can be created by multiple registered
+///          threads. Garbage collection then stops the world: the collecting thread waits
+///          until every other registered thread is blocked in a safepoint, which is reached
+///          at the end of each term creation, or has entered a safe region.
 class aterm_pool : public mcrl2::utilities::noncopyable
 {
 public:
 
   /// \brief Should be able to call mark() from any storage.
   /// \todo Make mark() private and change enable this friend class.
-  template<typename Element, typename Hash, typename Equals, std::size_t N, bool ThreadSafe>
+  template<typename Element, typename Hash, typename Equals, std::size_t N, bool ThreadSafe, bool OpenAddressing>
   friend class aterm_pool_storage;
 
   inline aterm_pool();
@@ -69,6 +87,35 @@ public:
   /// \brief Enable garbage collection when passing true and disable otherwise.
   inline void enable_garbage_collection(bool enable);
 
+  /// \brief Enables generational garbage collection when passing true and disable otherwise.
+  /// \details In this mode the automatically triggered collections only consider the terms created since the
+  ///          previous collection (the young generation), which happens after young_generation_size new terms.
+  ///          The whole pool is only collected when it has doubled in size since the last full collection.
+  inline void enable_generational_collection(bool enable, std::size_t young_generation_size = 1 << 20);
+
+  /// \brief Sets the number of threads used to mark and sweep terms during garbage collection.
+  /// \details Only has effect when GlobalThreadSafe is true, as sweeping concurrently requires
+  ///          thread-safe function symbols. Defaults to the number of hardware threads.
+  inline void set_garbage_collection_threads(std::size_t number_of_threads);
+
+  /// \brief Blocks the calling thread while another thread is collecting garbage.
+  /// \details Must only be called when all terms used by the calling thread are protected.
+  inline void safepoint();
+
+  /// \brief Registers the calling thread as a thread that accesses terms.
+  /// \details The thread that constructed the pool is registered implicitly.
+  inline void register_thread();
+
+  /// \brief Deregisters the calling thread, it should no longer access terms.
+  inline void deregister_thread();
+
+  /// \brief Indicates that the calling thread does not access terms until leave_safe_region() is called,
+  ///        such that other threads can collect garbage in the mean time.
+  inline void enter_safe_region();
+
+  /// \brief Indicates that the calling thread accesses terms again, waits for an ongoing garbage collection.
+  inline void leave_safe_region();
+
   /// \brief Creates a integral term with the given value.
   inline aterm create_int(std::size_t val);
 
@@ -99,6 +146,46 @@ public:
   /// \brief Prints various performance statistics for the term pool.
   inline void print_performance_statistics() const;
 
+  /// \brief Enables counting the number of terms found and created per storage at run time.
+  /// \details Also enabled on start-up when the MCRL2_TERM_POOL_METRICS environment variable is set to a filename,
+  ///          or "-" for standard error. The metrics are then written to it on exit, and at the next garbage
+  ///          collection after receiving the SIGUSR1 signal.
+  inline void enable_metrics(bool enable);
+
+  /// \returns True iff the metrics are counted at run time.
+  bool metrics_enabled() const noexcept { return m_enable_metrics.load(std::memory_order_relaxed); }
+
+  /// \brief Writes the metrics of the term pool, and of every storage, as a JSON object.
+  /// \details Assumes that no other thread is accessing terms.
+  inline void write_metrics(std::ostream& os) const;
+
+  /// \brief Writes the metrics to the file given by MCRL2_TERM_POOL_METRICS, if it was set.
+  inline void write_metrics_file() const;
+
+  /// \returns A histogram of the terms in the pool per function symbol.
+  /// \details Includes the terms that are not reachable, but have not been collected yet. Assumes
+  ///          that no other thread is accessing terms.
+  inline term_heap_profile heap_profile() const;
+
+  /// \returns A histogram of the terms in the pool grouped by the key term returned by classify(t) for each term t.
+  /// \details The keys are printed using print(key), where terms for which classify returns an undefined term
+  ///          are grouped as "other". The classifier must not create terms. Assumes that no other thread is
+  ///          accessing terms.
+  template<typename Classifier, typename Printer>
+  term_heap_profile heap_profile(Classifier classify, Printer print) const;
+
+  /// \brief Enables keeping the heap profile per function symbol of the full garbage collection after which
+  ///        the most terms remained, i.e., the peak of the live term population.
+  /// \details Also enabled on start-up when the MCRL2_TERM_HEAP_PROFILE environment variable is set to a filename,
+  ///          or "-" for standard error. The peak profile is then written to it on exit.
+  inline void enable_heap_profiling(bool enable);
+
+  /// \returns The heap profile at the peak of the live term population, when heap profiling is enabled.
+  const term_heap_profile& peak_heap_profile() const { return m_peak_heap_profile; }
+
+  /// \brief Writes the peak heap profile to the file given by MCRL2_TERM_HEAP_PROFILE, if it was set.
+  inline void write_heap_profile_file() const;
+
   /// \returns The total number of terms residing in the pool.
   inline std::size_t size() const;
 
@@ -118,6 +205,44 @@ public:
   function_symbol_pool& get_symbol_pool() { return m_function_symbol_pool; }
 private:
 
+  /// \brief Collects garbage, only the young generation when young_generation_only is true and
+  ///        generational collection is enabled.
+  inline void collect_garbage(bool young_generation_only);
+
+  /// \brief Marks and sweeps all storages, assumes that no other thread is accessing terms.
+  inline void collect_impl();
+
+  /// \brief Marks and sweeps the young generation in all storages, assumes that no other thread is accessing terms.
+  inline void collect_young_impl();
+
+  /// \returns The creation depth of the calling thread.
+  inline std::size_t& creation_depth();
+
+  /// \returns True iff garbage collection was deferred for the calling thread.
+  inline bool& deferred_garbage_collection();
+
+  /// \brief Adds one task for each shard of the given storage that marks the terms in that shard.
+  template<typename Storage>
+  void add_mark_tasks(Storage& storage, std::vector<std::function<void()>>& tasks);
+
+  /// \brief Executes the given tasks using m_number_of_collection_threads threads.
+  inline void run_collection_tasks(const std::vector<std::function<void()>>& tasks);
+
+  /// \brief Blocks the calling thread until the ongoing garbage collection has finished.
+  inline void wait_for_collection(std::unique_lock<std::mutex>& lock);
+
+  /// \brief Calls function(term, bytes) for every term in every storage.
+  template<typename Function>
+  void for_each_term(Function function) const;
+
+  /// \brief Updates the peak heap profile when the current population is larger, assumes that no
+  ///        other thread is accessing terms.
+  inline void update_peak_heap_profile();
+
+  /// \brief Writes the metrics to the file given by MCRL2_TERM_POOL_METRICS when this was requested
+  ///        by a signal, assumes that no other thread is accessing terms.
+  inline void write_metrics_if_requested() const;
+
   /// Storage for the function symbols.
   function_symbol_pool m_function_symbol_pool;
 
@@ -140,7 +265,7 @@ private:
   arbitrary_function_application_storage m_appl_dynamic_storage;
 
   /// Track the number of  terms destroyed and reduce the freelist.
-  std::size_t m_countUntilCollection;
+  typename std::conditional<GlobalThreadSafe, std::atomic<std::size_t>, std::size_t>::type m_countUntilCollection;
 
   /// It can happen that during create_appl with converter the converter generates new terms.
   /// As such these terms might only be protected after the term_appl was actually created.
@@ -152,6 +277,50 @@ private:
   /// Enable automatically triggered garbage collection.
   bool m_enable_garbage_collection = true;
 
+  /// The number of terms created between collections of the young generation, zero if generational collection is disabled.
+  std::size_t m_young_generation_size = 0;
+
+  /// The number of terms that remained after the last full garbage collection.
+  std::size_t m_size_after_full_collection = 0;
+
+  /// The number of collections of only the young generation.
+  std::size_t m_number_of_young_collections = 0;
+
+  /// The number of threads used to mark and sweep during garbage collection.
+  std::size_t m_number_of_collection_threads = 1;
+
+  /// Statistics on the garbage collections performed, times are in milliseconds.
+  std::size_t m_number_of_collections = 0;
+  long long m_total_mark_duration = 0;
+  long long m_total_sweep_duration = 0;
+  long long m_maximum_pause_duration = 0;
+
+  /// Protects the fields below that are used to stop all threads for garbage collection.
+  std::mutex m_collection_mutex;
+  std::condition_variable m_collection_condition;
+
+  /// True iff a thread is waiting to collect garbage, or is collecting garbage.
+  std::atomic<bool> m_collection_requested{false};
+
+  /// The number of registered threads.
+  std::size_t m_number_of_threads = 1;
+
+  /// The number of registered threads that are blocked in a safepoint or are in a safe region.
+  std::size_t m_number_of_safe_threads = 0;
+
+  /// Count the metrics at run time.
+  std::atomic<bool> m_enable_metrics{false};
+
+  /// The file to which the metrics are written, or "-" for standard error.
+  std::string m_metrics_filename;
+
+  /// Keep the heap profile at the peak of the live term population.
+  bool m_enable_heap_profiling = false;
+  term_heap_profile m_peak_heap_profile;
+
+  /// The file to which the peak heap profile is written, or "-" for standard error.
+  std::string m_heap_profile_filename;
+
   /// Represents an empty list.
   aterm m_empty_list;
 };
@@ -13,14 +13,47 @@
 
 #include "aterm_pool.h"
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/page_allocator.h"
+#include "mcrl2/utilities/platform.h"
+#include "mcrl2/utilities/trace.h"
 
+#include <algorithm>
 #include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
 
 namespace atermpp
 {
 namespace detail
 {
 
+/// \returns A flag that is set when the term pool metrics are requested by a signal.
+inline volatile std::sig_atomic_t& term_pool_metrics_requested()
+{
+  static volatile std::sig_atomic_t requested = 0;
+  return requested;
+}
+
+/// \returns The term pool of which the metrics and heap profile are written on exit.
+inline const aterm_pool*& term_pool_with_metrics()
+{
+  static const aterm_pool* pool = nullptr;
+  return pool;
+}
+
+inline void request_term_pool_metrics(int)
+{
+  term_pool_metrics_requested() = 1;
+}
+
+inline void write_term_pool_reports_at_exit()
+{
+  term_pool_with_metrics()->write_metrics_file();
+  term_pool_with_metrics()->write_heap_profile_file();
+}
+
 aterm_pool::aterm_pool() :
   m_int_storage(*this),
   m_appl_storage(
@@ -36,9 +69,38 @@ aterm_pool::aterm_pool() :
   m_appl_dynamic_storage(*this)
 {
   m_countUntilCollection = capacity();
-  
+
+  if (GlobalThreadSafe)
+  {
+    set_garbage_collection_threads(std::thread::hardware_concurrency());
+  }
+
   // Initialize the empty list.
   m_empty_list = create_appl(m_function_symbol_pool.as_empty_list());
+
+  const char* metrics_filename = std::getenv("MCRL2_TERM_POOL_METRICS");
+  if (metrics_filename != nullptr && *metrics_filename != '\0')
+  {
+    m_metrics_filename = metrics_filename;
+    enable_metrics(true);
+#ifndef MCRL2_PLATFORM_WINDOWS
+    std::signal(SIGUSR1, request_term_pool_metrics);
+#endif
+  }
+
+  const char* heap_profile_filename = std::getenv("MCRL2_TERM_HEAP_PROFILE");
+  if (heap_profile_filename != nullptr && *heap_profile_filename != '\0')
+  {
+    m_heap_profile_filename = heap_profile_filename;
+    enable_heap_profiling(true);
+  }
+
+  if (!m_metrics_filename.empty() || !m_heap_profile_filename.empty())
+  {
+    // The global term pool is never destroyed, so write the reports when the program exits.
+    term_pool_with_metrics() = this;
+    std::atexit(write_term_pool_reports_at_exit);
+  }
 }
 
 aterm_pool::~aterm_pool()
@@ -157,47 +219,115 @@ void aterm_pool::trigger_collection()
     return;
   }
 
-  if (m_countUntilCollection > 0)
-  {
-    --m_countUntilCollection;
-  }
-  else
+  // The counter is compared before it is decremented, such that exactly one thread observes
+  // that it reached zero when multiple threads decrement it concurrently.
+  if (m_countUntilCollection-- == 0)
   {
     if (m_enable_garbage_collection)
     {
-      collect();
+      collect_garbage(true);
     }
-
-    // Use some heuristics to determine when the next collection is called.
-    m_countUntilCollection = size();
+    else
+    {
+      // Use some heuristics to determine when the next collection is called.
+      m_countUntilCollection = size();
+    }
+  }
+  else
+  {
+    safepoint();
   }
 }
 
 void aterm_pool::collect()
 {
-  if (m_creation_depth > 0)
+  collect_garbage(false);
+}
+
+void aterm_pool::collect_garbage(bool young_generation_only)
+{
+  if (creation_depth() > 0)
   {
-    m_deferred_garbage_collection = true;
+    deferred_garbage_collection() = true;
     return;
   }
 
+  if (GlobalThreadSafe)
+  {
+    std::unique_lock<std::mutex> lock(m_collection_mutex);
+    if (m_collection_requested)
+    {
+      // Another thread is already collecting garbage.
+      wait_for_collection(lock);
+      return;
+    }
+
+    // Wait until all other threads are blocked in a safepoint or are in a safe region.
+    m_collection_requested = true;
+    m_collection_condition.wait(lock, [this]() { return m_number_of_safe_threads + 1 >= m_number_of_threads; });
+
+    if (young_generation_only && m_young_generation_size > 0 && size() < 2 * m_size_after_full_collection)
+    {
+      collect_young_impl();
+    }
+    else
+    {
+      collect_impl();
+    }
+
+    m_collection_requested = false;
+    m_collection_condition.notify_all();
+  }
+  else
+  {
+    if (young_generation_only && m_young_generation_size > 0 && size() < 2 * m_size_after_full_collection)
+    {
+      collect_young_impl();
+    }
+    else
+    {
+      collect_impl();
+    }
+  }
+}
+
+void aterm_pool::collect_impl()
+{
+  mcrl2::utilities::trace_span span("garbage collection", "atermpp");
   auto timestamp = std::chrono::system_clock::now();
 
-  m_deferred_garbage_collection = false;
+  deferred_garbage_collection() = false;
   std::size_t old_size = size();
 
   // Marks all terms that are reachable via any reachable term to
   // not be garbage collected.
   // For integer and terms without arguments the marking is not needed, because
   // they do not have arguments that might have to be marked.
-  std::get<1>(m_appl_storage).mark();
-  std::get<2>(m_appl_storage).mark();
-  std::get<3>(m_appl_storage).mark();
-  std::get<4>(m_appl_storage).mark();
-  std::get<5>(m_appl_storage).mark();
-  std::get<6>(m_appl_storage).mark();
-  std::get<7>(m_appl_storage).mark();
-  m_appl_dynamic_storage.mark();
+  if (GlobalThreadSafe && m_number_of_collection_threads > 1)
+  {
+    // Every shard can be marked independently, as terms are marked atomically.
+    std::vector<std::function<void()>> tasks;
+    add_mark_tasks(std::get<1>(m_appl_storage), tasks);
+    add_mark_tasks(std::get<2>(m_appl_storage), tasks);
+    add_mark_tasks(std::get<3>(m_appl_storage), tasks);
+    add_mark_tasks(std::get<4>(m_appl_storage), tasks);
+    add_mark_tasks(std::get<5>(m_appl_storage), tasks);
+    add_mark_tasks(std::get<6>(m_appl_storage), tasks);
+    add_mark_tasks(std::get<7>(m_appl_storage), tasks);
+    add_mark_tasks(m_appl_dynamic_storage, tasks);
+    run_collection_tasks(tasks);
+  }
+  else
+  {
+    std::get<1>(m_appl_storage).mark();
+    std::get<2>(m_appl_storage).mark();
+    std::get<3>(m_appl_storage).mark();
+    std::get<4>(m_appl_storage).mark();
+    std::get<5>(m_appl_storage).mark();
+    std::get<6>(m_appl_storage).mark();
+    std::get<7>(m_appl_storage).mark();
+    m_appl_dynamic_storage.mark();
+  }
 
   assert(std::get<0>(m_appl_storage).verify_mark());
   assert(std::get<1>(m_appl_storage).verify_mark());
@@ -212,17 +342,39 @@ void aterm_pool::collect()
   // Keep track of the duration for marking and reset for sweep.
   auto mark_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
   timestamp = std::chrono::system_clock::now();
+
   // Collect all terms that are not reachable or marked.
-  m_int_storage.sweep();
-  std::get<0>(m_appl_storage).sweep();
-  std::get<1>(m_appl_storage).sweep();
-  std::get<2>(m_appl_storage).sweep();
-  std::get<3>(m_appl_storage).sweep();
-  std::get<4>(m_appl_storage).sweep();
-  std::get<5>(m_appl_storage).sweep();
-  std::get<6>(m_appl_storage).sweep();
-  std::get<7>(m_appl_storage).sweep();
-  m_appl_dynamic_storage.sweep();
+  if (GlobalThreadSafe && m_number_of_collection_threads > 1)
+  {
+    // The storages are independent, but destroying terms changes the (atomic) function symbol reference
+    // counts and calls the deletion hooks concurrently.
+    std::vector<std::function<void()>> tasks = {
+      [this]() { m_int_storage.sweep(); },
+      [this]() { std::get<0>(m_appl_storage).sweep(); },
+      [this]() { std::get<1>(m_appl_storage).sweep(); },
+      [this]() { std::get<2>(m_appl_storage).sweep(); },
+      [this]() { std::get<3>(m_appl_storage).sweep(); },
+      [this]() { std::get<4>(m_appl_storage).sweep(); },
+      [this]() { std::get<5>(m_appl_storage).sweep(); },
+      [this]() { std::get<6>(m_appl_storage).sweep(); },
+      [this]() { std::get<7>(m_appl_storage).sweep(); },
+      [this]() { m_appl_dynamic_storage.sweep(); }
+    };
+    run_collection_tasks(tasks);
+  }
+  else
+  {
+    m_int_storage.sweep();
+    std::get<0>(m_appl_storage).sweep();
+    std::get<1>(m_appl_storage).sweep();
+    std::get<2>(m_appl_storage).sweep();
+    std::get<3>(m_appl_storage).sweep();
+    std::get<4>(m_appl_storage).sweep();
+    std::get<5>(m_appl_storage).sweep();
+    std::get<6>(m_appl_storage).sweep();
+    std::get<7>(m_appl_storage).sweep();
+    m_appl_dynamic_storage.sweep();
+  }
 
   // Check that after sweeping the terms are consistent.
   assert(m_int_storage.verify_sweep());
@@ -236,12 +388,27 @@ void aterm_pool::collect()
   assert(std::get<7>(m_appl_storage).verify_sweep());
   assert(m_appl_dynamic_storage.verify_sweep());
 
+  // Function symbols are only removed during garbage collection when they can be shared between threads.
+  if (GlobalThreadSafe)
+  {
+    m_function_symbol_pool.sweep();
+  }
+
+  // Use some heuristics to determine when the next collection is called.
+  m_size_after_full_collection = size();
+  m_countUntilCollection = m_young_generation_size > 0 ? m_young_generation_size : size();
+  mcrl2::utilities::tracer::counter("terms", static_cast<std::int64_t>(size()));
+
+  // Update the statistics.
+  auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
+  ++m_number_of_collections;
+  m_total_mark_duration += mark_duration;
+  m_total_sweep_duration += sweep_duration;
+  m_maximum_pause_duration = std::max<long long>(m_maximum_pause_duration, mark_duration + sweep_duration);
+
   // Print some statistics.
   if (EnableGarbageCollectionMetrics)
   {
-    // Update the times
-    auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
-
     // Print the relevant information.
     mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Garbage collected " << old_size - size() << " terms, " << size() << " terms remaining in "
       << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
@@ -249,6 +416,143 @@ void aterm_pool::collect()
 
   get_symbol_pool().print_performance_stats();
   print_performance_statistics();
+  update_peak_heap_profile();
+  write_metrics_if_requested();
+}
+
+void aterm_pool::collect_young_impl()
+{
+  mcrl2::utilities::trace_span span("young garbage collection", "atermpp");
+  auto timestamp = std::chrono::system_clock::now();
+
+  deferred_garbage_collection() = false;
+  std::size_t old_size = size();
+
+  // Old terms cannot refer to young terms, so the young terms that are protected or reachable from other
+  // young terms are exactly the young terms that are reachable.
+  std::unordered_set<const _aterm*> young_terms;
+  m_int_storage.insert_young(young_terms);
+  std::get<0>(m_appl_storage).insert_young(young_terms);
+  std::get<1>(m_appl_storage).insert_young(young_terms);
+  std::get<2>(m_appl_storage).insert_young(young_terms);
+  std::get<3>(m_appl_storage).insert_young(young_terms);
+  std::get<4>(m_appl_storage).insert_young(young_terms);
+  std::get<5>(m_appl_storage).insert_young(young_terms);
+  std::get<6>(m_appl_storage).insert_young(young_terms);
+  std::get<7>(m_appl_storage).insert_young(young_terms);
+  m_appl_dynamic_storage.insert_young(young_terms);
+
+  std::get<1>(m_appl_storage).mark_young(young_terms);
+  std::get<2>(m_appl_storage).mark_young(young_terms);
+  std::get<3>(m_appl_storage).mark_young(young_terms);
+  std::get<4>(m_appl_storage).mark_young(young_terms);
+  std::get<5>(m_appl_storage).mark_young(young_terms);
+  std::get<6>(m_appl_storage).mark_young(young_terms);
+  std::get<7>(m_appl_storage).mark_young(young_terms);
+  m_appl_dynamic_storage.mark_young(young_terms);
+
+  auto mark_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
+  timestamp = std::chrono::system_clock::now();
+
+  m_int_storage.sweep_young();
+  std::get<0>(m_appl_storage).sweep_young();
+  std::get<1>(m_appl_storage).sweep_young();
+  std::get<2>(m_appl_storage).sweep_young();
+  std::get<3>(m_appl_storage).sweep_young();
+  std::get<4>(m_appl_storage).sweep_young();
+  std::get<5>(m_appl_storage).sweep_young();
+  std::get<6>(m_appl_storage).sweep_young();
+  std::get<7>(m_appl_storage).sweep_young();
+  m_appl_dynamic_storage.sweep_young();
+
+  assert(m_int_storage.verify_sweep());
+  assert(std::get<0>(m_appl_storage).verify_sweep());
+  assert(std::get<1>(m_appl_storage).verify_sweep());
+  assert(std::get<2>(m_appl_storage).verify_sweep());
+  assert(std::get<3>(m_appl_storage).verify_sweep());
+  assert(std::get<4>(m_appl_storage).verify_sweep());
+  assert(std::get<5>(m_appl_storage).verify_sweep());
+  assert(std::get<6>(m_appl_storage).verify_sweep());
+  assert(std::get<7>(m_appl_storage).verify_sweep());
+  assert(m_appl_dynamic_storage.verify_sweep());
+
+  m_countUntilCollection = m_young_generation_size;
+
+  // Update the statistics.
+  auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
+  ++m_number_of_young_collections;
+  m_total_mark_duration += mark_duration;
+  m_total_sweep_duration += sweep_duration;
+  m_maximum_pause_duration = std::max<long long>(m_maximum_pause_duration, mark_duration + sweep_duration);
+
+  if (EnableGarbageCollectionMetrics)
+  {
+    mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Garbage collected " << old_size - size() << " young terms out of " << young_terms.size()
+      << ", " << size() << " terms remaining in " << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
+  }
+
+  write_metrics_if_requested();
+}
+
+void aterm_pool::enable_generational_collection(bool enable, std::size_t young_generation_size)
+{
+  m_young_generation_size = enable ? std::max<std::size_t>(young_generation_size, 1) : 0;
+  m_size_after_full_collection = size();
+  m_countUntilCollection = enable ? m_young_generation_size : size();
+
+  m_int_storage.enable_young_generation(enable);
+  std::get<0>(m_appl_storage).enable_young_generation(enable);
+  std::get<1>(m_appl_storage).enable_young_generation(enable);
+  std::get<2>(m_appl_storage).enable_young_generation(enable);
+  std::get<3>(m_appl_storage).enable_young_generation(enable);
+  std::get<4>(m_appl_storage).enable_young_generation(enable);
+  std::get<5>(m_appl_storage).enable_young_generation(enable);
+  std::get<6>(m_appl_storage).enable_young_generation(enable);
+  std::get<7>(m_appl_storage).enable_young_generation(enable);
+  m_appl_dynamic_storage.enable_young_generation(enable);
+}
+
+void aterm_pool::set_garbage_collection_threads(std::size_t number_of_threads)
+{
+  m_number_of_collection_threads = std::max<std::size_t>(number_of_threads, 1);
+}
+
+template<typename Storage>
+void aterm_pool::add_mark_tasks(Storage& storage, std::vector<std::function<void()>>& tasks)
+{
+  for (std::size_t i = 0; i < storage.number_of_shards(); ++i)
+  {
+    tasks.emplace_back([&storage, i]()
+      {
+        typename Storage::term_stack todo;
+        storage.mark(i, todo);
+      });
+  }
+}
+
+void aterm_pool::run_collection_tasks(const std::vector<std::function<void()>>& tasks)
+{
+  // Each thread repeatedly takes the next task that has not been started yet.
+  std::atomic<std::size_t> next_task(0);
+  auto worker = [&tasks, &next_task]()
+    {
+      for (std::size_t index = next_task++; index < tasks.size(); index = next_task++)
+      {
+        tasks[index]();
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < std::min(m_number_of_collection_threads, tasks.size()); ++i)
+  {
+    threads.emplace_back(worker);
+  }
+
+  worker();
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
 }
 
 void aterm_pool::enable_garbage_collection(bool enable)
@@ -256,6 +560,58 @@ void aterm_pool::enable_garbage_collection(bool enable)
   m_enable_garbage_collection = enable;
 }
 
+void aterm_pool::safepoint()
+{
+  // Terms that are being constructed by this thread are not yet protected at a creation depth larger than zero.
+  if (GlobalThreadSafe && m_collection_requested.load(std::memory_order_acquire) && creation_depth() == 0)
+  {
+    std::unique_lock<std::mutex> lock(m_collection_mutex);
+    wait_for_collection(lock);
+  }
+}
+
+void aterm_pool::register_thread()
+{
+  if (GlobalThreadSafe)
+  {
+    std::unique_lock<std::mutex> lock(m_collection_mutex);
+    m_collection_condition.wait(lock, [this]() { return !m_collection_requested; });
+    ++m_number_of_threads;
+  }
+}
+
+void aterm_pool::deregister_thread()
+{
+  if (GlobalThreadSafe)
+  {
+    std::unique_lock<std::mutex> lock(m_collection_mutex);
+    assert(m_number_of_threads > 1);
+    --m_number_of_threads;
+    m_collection_condition.notify_all();
+  }
+}
+
+void aterm_pool::enter_safe_region()
+{
+  if (GlobalThreadSafe)
+  {
+    std::unique_lock<std::mutex> lock(m_collection_mutex);
+    ++m_number_of_safe_threads;
+    m_collection_condition.notify_all();
+  }
+}
+
+void aterm_pool::leave_safe_region()
+{
+  if (GlobalThreadSafe)
+  {
+    std::unique_lock<std::mutex> lock(m_collection_mutex);
+    m_collection_condition.wait(lock, [this]() { return !m_collection_requested; });
+    assert(m_number_of_safe_threads > 0);
+    --m_number_of_safe_threads;
+  }
+}
+
 aterm aterm_pool::create_int(size_t val)
 {
   return m_int_storage.create_int(val);
@@ -316,7 +672,7 @@ aterm aterm_pool::create_appl_dynamic(const function_symbol& sym,
                             InputIterator begin,
                             InputIterator end)
 {
-  ++m_creation_depth;
+  ++creation_depth();
 
   const std::size_t arity = sym.arity();
   aterm result;
@@ -351,16 +707,16 @@ aterm aterm_pool::create_appl_dynamic(const function_symbol& sym,
     result = m_appl_dynamic_storage.create_appl_dynamic(sym, converter, begin, end);
   }
 
-  --m_creation_depth;
+  --creation_depth();
 
   // Trigger a deferred garbage collection when it was requested and the term has been protected.
-  if (m_creation_depth == 0 && m_deferred_garbage_collection)
+  if (creation_depth() == 0 && deferred_garbage_collection())
   {
     if (EnableGarbageCollectionMetrics)
     {
       mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Deferred garbage collection.\n";
     }
-    collect();
+    collect_garbage(true);
   }
 
   return result;
@@ -380,10 +736,240 @@ void aterm_pool::print_performance_statistics() const
 
   m_appl_dynamic_storage.print_performance_stats("arbitrary_function_application_storage");
 
+  if (EnableGarbageCollectionMetrics && m_number_of_collections + m_number_of_young_collections > 0)
+  {
+    mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): " << m_number_of_collections << " full and "
+      << m_number_of_young_collections << " young generation garbage collections using "
+      << m_number_of_collection_threads << " thread(s) paused for " << m_total_mark_duration + m_total_sweep_duration << " ms in total (marking "
+      << m_total_mark_duration << " ms + sweep " << m_total_sweep_duration << " ms), the longest pause took " << m_maximum_pause_duration << " ms.\n";
+  }
+
   if (mcrl2::utilities::EnableReferenceCountMetrics)
   {
     mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): all reference counts changed " << _aterm::reference_count_changes() << " times.\n";
   }
+
+  if (EnableGarbageCollectionMetrics)
+  {
+    const mcrl2::utilities::page_statistics pages = mcrl2::utilities::get_page_statistics();
+    mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): blocks use " << to_string(pages.backing) << " pages, "
+      << pages.regions << " regions (" << pages.huge_page_regions << " of reserved huge pages) occupy " << pages.bytes << " bytes, the process caused "
+      << pages.minor_page_faults << " minor and " << pages.major_page_faults << " major page faults.\n";
+  }
+}
+
+void aterm_pool::enable_metrics(bool enable)
+{
+  m_enable_metrics = enable;
+}
+
+void aterm_pool::write_metrics(std::ostream& os) const
+{
+  os << "{\"terms\": " << size()
+     << ", \"capacity\": " << capacity()
+     << ", \"function_symbols\": " << m_function_symbol_pool.size()
+     << ", \"garbage_collection\": {"
+     << "\"full_collections\": " << m_number_of_collections
+     << ", \"young_collections\": " << m_number_of_young_collections
+     << ", \"threads\": " << m_number_of_collection_threads
+     << ", \"mark_ms\": " << m_total_mark_duration
+     << ", \"sweep_ms\": " << m_total_sweep_duration
+     << ", \"maximum_pause_ms\": " << m_maximum_pause_duration
+     << "}";
+
+  if (mcrl2::utilities::EnableReferenceCountMetrics)
+  {
+    os << ", \"reference_count_changes\": " << _aterm::reference_count_changes();
+  }
+
+  const mcrl2::utilities::page_statistics pages = mcrl2::utilities::get_page_statistics();
+  os << ", \"pages\": {"
+     << "\"backing\": \"" << to_string(pages.backing) << "\""
+     << ", \"regions\": " << pages.regions
+     << ", \"huge_page_regions\": " << pages.huge_page_regions
+     << ", \"huge_page_fallbacks\": " << pages.huge_page_fallbacks
+     << ", \"bytes\": " << pages.bytes
+     << ", \"minor_faults\": " << pages.minor_page_faults
+     << ", \"major_faults\": " << pages.major_page_faults
+     << "}";
+
+  os << ", \"storages\": [\n  ";
+  m_int_storage.write_metrics(os, "integral_storage", 0);
+  os << ",\n  ";
+  std::get<0>(m_appl_storage).write_metrics(os, "term_storage", 0);
+  os << ",\n  ";
+  std::get<1>(m_appl_storage).write_metrics(os, "function_application_storage_1", 1);
+  os << ",\n  ";
+  std::get<2>(m_appl_storage).write_metrics(os, "function_application_storage_2", 2);
+  os << ",\n  ";
+  std::get<3>(m_appl_storage).write_metrics(os, "function_application_storage_3", 3);
+  os << ",\n  ";
+  std::get<4>(m_appl_storage).write_metrics(os, "function_application_storage_4", 4);
+  os << ",\n  ";
+  std::get<5>(m_appl_storage).write_metrics(os, "function_application_storage_5", 5);
+  os << ",\n  ";
+  std::get<6>(m_appl_storage).write_metrics(os, "function_application_storage_6", 6);
+  os << ",\n  ";
+  std::get<7>(m_appl_storage).write_metrics(os, "function_application_storage_7", 7);
+  os << ",\n  ";
+  m_appl_dynamic_storage.write_metrics(os, "arbitrary_function_application_storage", DynamicNumberOfArguments);
+  os << "\n]}\n";
+}
+
+void aterm_pool::write_metrics_file() const
+{
+  if (m_metrics_filename.empty())
+  {
+    return;
+  }
+
+  if (m_metrics_filename == "-")
+  {
+    write_metrics(std::cerr);
+  }
+  else
+  {
+    std::ofstream os(m_metrics_filename);
+    if (!os)
+    {
+      mCRL2log(mcrl2::log::warning) << "Could not write the term pool metrics to " << m_metrics_filename << ".\n";
+      return;
+    }
+    write_metrics(os);
+  }
+}
+
+void aterm_pool::write_metrics_if_requested() const
+{
+  if (term_pool_metrics_requested())
+  {
+    term_pool_metrics_requested() = 0;
+    write_metrics_file();
+  }
+}
+
+template<typename Function>
+void aterm_pool::for_each_term(Function function) const
+{
+  m_int_storage.for_each_term(function);
+  std::get<0>(m_appl_storage).for_each_term(function);
+  std::get<1>(m_appl_storage).for_each_term(function);
+  std::get<2>(m_appl_storage).for_each_term(function);
+  std::get<3>(m_appl_storage).for_each_term(function);
+  std::get<4>(m_appl_storage).for_each_term(function);
+  std::get<5>(m_appl_storage).for_each_term(function);
+  std::get<6>(m_appl_storage).for_each_term(function);
+  std::get<7>(m_appl_storage).for_each_term(function);
+  m_appl_dynamic_storage.for_each_term(function);
+}
+
+term_heap_profile aterm_pool::heap_profile() const
+{
+  // The number of terms and bytes per function symbol.
+  std::unordered_map<function_symbol, std::pair<std::size_t, std::size_t>> histogram;
+  for_each_term([&histogram](const _aterm& term, std::size_t bytes)
+    {
+      std::pair<std::size_t, std::size_t>& counts = histogram[term.function()];
+      ++counts.first;
+      counts.second += bytes;
+    });
+
+  std::vector<term_heap_profile::entry> entries;
+  for (const auto& pair : histogram)
+  {
+    entries.push_back(term_heap_profile::entry{pair.first.name() + "/" + std::to_string(pair.first.arity()), pair.second.first, pair.second.second});
+  }
+  return term_heap_profile(std::move(entries));
+}
+
+template<typename Classifier, typename Printer>
+term_heap_profile aterm_pool::heap_profile(Classifier classify, Printer print) const
+{
+  // The number of terms and bytes per key.
+  std::unordered_map<aterm, std::pair<std::size_t, std::size_t>> histogram;
+  for_each_term([&histogram, &classify](const _aterm& term, std::size_t bytes)
+    {
+      std::pair<std::size_t, std::size_t>& counts = histogram[classify(aterm(const_cast<_aterm*>(&term)))];
+      ++counts.first;
+      counts.second += bytes;
+    });
+
+  std::vector<term_heap_profile::entry> entries;
+  for (const auto& pair : histogram)
+  {
+    entries.push_back(term_heap_profile::entry{pair.first.defined() ? print(pair.first) : "other", pair.second.first, pair.second.second});
+  }
+  return term_heap_profile(std::move(entries));
+}
+
+void aterm_pool::enable_heap_profiling(bool enable)
+{
+  m_enable_heap_profiling = enable;
+}
+
+void aterm_pool::update_peak_heap_profile()
+{
+  if (m_enable_heap_profiling && size() > m_peak_heap_profile.terms())
+  {
+    m_peak_heap_profile = heap_profile();
+  }
+}
+
+void aterm_pool::write_heap_profile_file() const
+{
+  if (m_heap_profile_filename.empty())
+  {
+    return;
+  }
+
+  // Also consider the current population, which might be larger than at any garbage collection.
+  term_heap_profile profile = heap_profile();
+  const term_heap_profile& peak = profile.terms() > m_peak_heap_profile.terms() ? profile : m_peak_heap_profile;
+
+  if (m_heap_profile_filename == "-")
+  {
+    peak.write(std::cerr);
+  }
+  else
+  {
+    std::ofstream os(m_heap_profile_filename);
+    if (!os)
+    {
+      mCRL2log(mcrl2::log::warning) << "Could not write the term heap profile to " << m_heap_profile_filename << ".\n";
+      return;
+    }
+    peak.write(os, std::numeric_limits<std::size_t>::max());
+  }
+}
+
+std::size_t& aterm_pool::creation_depth()
+{
+  if (GlobalThreadSafe)
+  {
+    static thread_local std::size_t depth = 0;
+    return depth;
+  }
+
+  return m_creation_depth;
+}
+
+bool& aterm_pool::deferred_garbage_collection()
+{
+  if (GlobalThreadSafe)
+  {
+    static thread_local bool deferred = false;
+    return deferred;
+  }
+
+  return m_deferred_garbage_collection;
+}
+
+void aterm_pool::wait_for_collection(std::unique_lock<std::mutex>& lock)
+{
+  ++m_number_of_safe_threads;
+  m_collection_condition.notify_all();
+  m_collection_condition.wait(lock, [this]() { return !m_collection_requested; });
+  --m_number_of_safe_threads;
 }
 
 std::size_t aterm_pool::size() const
@@ -16,10 +16,15 @@
 #include "mcrl2/atermpp/detail/aterm_int.h"
 #include "mcrl2/utilities/block_allocator.h"
 #include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/utilities/open_addressing_set.h"
 #include "mcrl2/utilities/unordered_set.h"
 
+#include <array>
 #include <limits>
+#include <mutex>
+#include <ostream>
 #include <stack>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -33,26 +38,36 @@ class aterm_pool;
 
 /// \brief This class provides for all types of term storage. It also
 ///       provides garbage collection via its mark and sweep functions.
-/// \details Internally a hash set is used to ensure that the created terms are unique.
+/// \details Internally a hash set is used to ensure that the created terms are unique. When
+///          ThreadSafe is true the terms are distributed over a number of hash sets (shards)
+///          that are each protected by their own mutex, so that threads creating unrelated
+///          terms do not contend for the same lock.
+///
+///          When OpenAddressing is true the hash sets use open addressing with tags of the hashes that
+///          are probed in groups, see open_addressing_set, instead of chaining the terms in buckets.
 template<typename Element,
          typename Hash = aterm_hasher<>,
          typename Equals = aterm_equals<>,
          std::size_t N = DynamicNumberOfArguments,
-         bool ThreadSafe = false>
+         bool ThreadSafe = false,
+         bool OpenAddressing = false>
 class aterm_pool_storage : private mcrl2::utilities::noncopyable
 {
 public:
-  using unordered_set = mcrl2::utilities::unordered_set<
-    Element,
-    Hash,
-    Equals,
-    typename std::conditional<N == DynamicNumberOfArguments,
-      atermpp::detail::_aterm_appl_allocator<>,
-      mcrl2::utilities::block_allocator<Element, 1024, ThreadSafe>>::type,
-    ThreadSafe>;
+  using allocator_type = typename std::conditional<N == DynamicNumberOfArguments,
+    atermpp::detail::_aterm_appl_allocator<>,
+    mcrl2::utilities::block_allocator<Element, 1024, false>>::type;
+
+  /// \brief Each shard is protected by its own mutex, so the set and its allocator do not need to be thread-safe.
+  using unordered_set = typename std::conditional<OpenAddressing,
+    mcrl2::utilities::open_addressing_set<Element, Hash, Equals, allocator_type, false>,
+    mcrl2::utilities::unordered_set<Element, Hash, Equals, allocator_type, false>>::type;
   using iterator = typename unordered_set::iterator;
   using const_iterator = typename unordered_set::const_iterator;
 
+  /// \brief A stack of terms that still have to be marked.
+  using term_stack = std::stack<std::reference_wrapper<_aterm>>;
+
   /// \brief The local pool is a friend class so it can mark terms.
   friend class aterm_pool;
 
@@ -65,7 +80,7 @@ public:
   void add_deletion_hook(function_symbol sym, term_callback callback);
 
   /// \returns The total number of terms that can be stored without resizing.
-  std::size_t capacity() const noexcept { return m_term_set.capacity(); }
+  std::size_t capacity() const noexcept;
 
   /// \brief Creates a integral term with the given value.
   aterm create_int(std::size_t value);
@@ -115,20 +130,56 @@ public:
   /// \param identifier A string to identify the printed message for this storage.
   void print_performance_stats(const char* identifier) const;
 
+  /// \brief Writes the performance statistics of this storage as a JSON object.
+  /// \param identifier A string to identify this storage.
+  /// \param arity The arity of the terms in this storage, or DynamicNumberOfArguments if arbitrary.
+  void write_metrics(std::ostream& os, const char* identifier, std::size_t arity) const;
+
+  /// \brief Calls function(term, bytes) for every term in this storage, where bytes is the
+  ///        (approximate) amount of memory occupied by that term.
+  template<typename Function>
+  void for_each_term(Function function) const;
+
   /// \brief Marks all terms that are reachable and should not be destroyed.
   void mark();
 
+  /// \brief Marks the terms in the given shard that are reachable.
+  /// \details Different shards (of any storage) can be marked concurrently by using different stacks.
+  /// \param todo A stack that is used to store the terms that still have to be marked.
+  void mark(std::size_t shard, term_stack& todo);
+
+  /// \brief Marks the young terms that are reachable from young terms that are protected.
+  /// \details Terms only refer to terms that were created before them, so old terms never refer to young terms.
+  /// \param young_terms The young terms of all storages.
+  void mark_young(const std::unordered_set<const _aterm*>& young_terms);
+
+  /// \brief Destroys the young terms that are not reachable and promotes the others to the old generation.
+  ///        Requires that mark_young() was called first.
+  void sweep_young();
+
+  /// \brief Inserts the young terms of this storage into the given set.
+  void insert_young(std::unordered_set<const _aterm*>& young_terms) const;
+
+  /// \brief Promotes all young terms to the old generation.
+  void clear_young();
+
+  /// \brief Enables that created terms are recorded as young terms for generational garbage collection.
+  void enable_young_generation(bool enable);
+
+  /// \returns The number of shards in this storage.
+  static constexpr std::size_t number_of_shards() { return NumberOfShards; }
+
   /// \brief sweep Destroys all terms that are not reachable. Requires that
   ///        mark() was called first.
   void sweep();
 
   /// \returns The number of terms stored in this storage.
-  std::size_t size() const { return m_term_set.size(); }
+  std::size_t size() const;
 
   /// \brief A fake copy constructor to fix the issues with GCC 4 and 5.
   aterm_pool_storage(const aterm_pool_storage& other) :
     m_pool(other.m_pool),
-    m_term_set(std::move(other.m_term_set))
+    m_shards(other.m_shards)
   {}
 
   /// \brief Check that all arguments of a term application are marked properly.
@@ -140,14 +191,44 @@ public:
 private:
   using callback_pair = std::pair<function_symbol, term_callback>;
 
+  /// \brief The terms are distributed over 2^ShardBits shards.
+  static constexpr std::size_t ShardBits = ThreadSafe ? 6 : 0;
+  static constexpr std::size_t NumberOfShards = static_cast<std::size_t>(1) << ShardBits;
+
+  /// \brief A hash set of terms together with the mutex that protects it.
+  struct shard
+  {
+    shard() :
+      term_set((1 << 14) / NumberOfShards)
+    {}
+
+    /// \brief A fake copy constructor, the mutex cannot be copied.
+    shard(const shard& other) :
+      term_set(std::move(other.term_set))
+    {}
+
+    unordered_set term_set;
+    std::mutex mutex;
+
+    /// Counts the number of times a term has been found in (hit) or is added to (miss) this shard.
+    mcrl2::utilities::cache_metric term_metric;
+
+    /// The terms that were created since the last garbage collection, only used for generational collection.
+    std::vector<Element*> young_terms;
+  };
+
+  /// \returns The shard in which the term constructed from the given arguments must be stored.
+  template<typename ...Args>
+  shard& find_shard(const Args&... args);
+
   /// \brief Calls the creation hook attached to the function symbol of this term.
   void call_creation_hook(unprotected_aterm term);
 
   /// \brief Calls the deletion hook attached to the function symbol of this term.
   void call_deletion_hook(unprotected_aterm term);
 
-  /// \brief Removes an element from the unordered set and deallocates it.
-  iterator destroy(iterator it);
+  /// \brief Removes an element from the unordered set of the given shard and deallocates it.
+  iterator destroy(shard& shard, iterator it);
 
   /// \brief Inserts a term constructed by the given arguments, checks for existing term.
   template<typename ...Args>
@@ -158,7 +239,7 @@ private:
   constexpr bool is_dynamic_storage() const;
 
   /// \brief Marks a term and recursively all arguments that are not reachable.
-  void mark_term(_aterm& root);
+  void mark_term(_aterm& root, term_stack& todo);
 
   /// \brief Verify that the given term was constructed properly.
   template<std::size_t Arity = N>
@@ -167,20 +248,23 @@ private:
   /// The pool that this storage belongs to.
   aterm_pool& m_pool;
 
-  /// This is the set of term pointers to keep the terms unique.
-  unordered_set m_term_set;
+  /// These are the sets of term pointers to keep the terms unique.
+  std::array<shard, NumberOfShards> m_shards;
 
   /// This array stores creation, resp deletion, hooks for function symbols.
   std::vector<callback_pair> m_creation_hooks;
   std::vector<callback_pair> m_deletion_hooks;
 
   /// A reusable todo stack.
-  std::stack<std::reference_wrapper<_aterm>> todo;
+  term_stack m_todo;
+
+  /// Keep track of young terms for generational garbage collection.
+  bool m_record_young_terms = false;
 
   // Various performance statistics.
 
-  mcrl2::utilities::cache_metric m_term_metric; ///< Count the number of times a term has been found in or is added to the set.
-  std::size_t m_erasedBlocks = 0; /// The number of blocks that have been erased in the block allocator.
+  std::size_t m_erasedBlocks = 0; ///< The number of blocks that have been erased in the block allocator during the last sweep.
+  std::size_t m_total_erased_blocks = 0; ///< The number of blocks that have been erased in total.
 };
 
 } // namespace detail
@@ -47,13 +47,12 @@ static inline std::array<unprotected_aterm, N> construct_arguments(InputIterator
   return arguments;
 }
 
-#define ATERM_POOL_STORAGE_TEMPLATES template<typename Element, typename Hash, typename Equals, std::size_t N, bool ThreadSafe>
-#define ATERM_POOL_STORAGE aterm_pool_storage<Element, Hash, Equals, N, ThreadSafe>
+#define ATERM_POOL_STORAGE_TEMPLATES template<typename Element, typename Hash, typename Equals, std::size_t N, bool ThreadSafe, bool OpenAddressing>
+#define ATERM_POOL_STORAGE aterm_pool_storage<Element, Hash, Equals, N, ThreadSafe, OpenAddressing>
 
 ATERM_POOL_STORAGE_TEMPLATES
 ATERM_POOL_STORAGE::aterm_pool_storage(aterm_pool& pool) :
-  m_pool(pool),
-  m_term_set(1 << 14)
+  m_pool(pool)
 {}
 
 ATERM_POOL_STORAGE_TEMPLATES
@@ -82,6 +81,17 @@ void ATERM_POOL_STORAGE::add_deletion_hook(function_symbol sym, term_callback ca
   m_deletion_hooks.emplace_back(sym, callback);
 }
 
+ATERM_POOL_STORAGE_TEMPLATES
+std::size_t ATERM_POOL_STORAGE::capacity() const noexcept
+{
+  std::size_t result = 0;
+  for (const shard& shard : m_shards)
+  {
+    result += shard.term_set.capacity();
+  }
+  return result;
+}
+
 ATERM_POOL_STORAGE_TEMPLATES
 aterm ATERM_POOL_STORAGE::create_int(std::size_t value)
 {
@@ -155,7 +165,10 @@ void ATERM_POOL_STORAGE::print_performance_stats(const char* identifier) const
   if (EnableTermHashtableMetrics)
   {
     mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(" << identifier << ") hashtable:\n";
-    m_term_set.print_performance_statistics();
+    for (const shard& shard : m_shards)
+    {
+      shard.term_set.print_performance_statistics();
+    }
   }
 
   if (EnableGarbageCollectionMetrics && m_erasedBlocks > 0)
@@ -165,21 +178,95 @@ void ATERM_POOL_STORAGE::print_performance_stats(const char* identifier) const
 
   if (EnableTermCreationMetrics)
   {
-    mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(" << identifier << "): emplace() " << m_term_metric.message() << ".\n";
+    for (const shard& shard : m_shards)
+    {
+      mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(" << identifier << "): emplace() " << shard.term_metric.message() << ".\n";
+    }
   }
 }
 
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::write_metrics(std::ostream& os, const char* identifier, std::size_t arity) const
+{
+  std::size_t terms = 0;
+  std::size_t buckets = 0;
+  std::size_t empty_buckets = 0;
+  std::size_t longest_bucket = 0;
+  std::size_t found = 0;
+  std::size_t created = 0;
+  for (const shard& shard : m_shards)
+  {
+    std::vector<std::size_t> histogram = shard.term_set.bucket_length_histogram();
+    terms += shard.term_set.size();
+    buckets += shard.term_set.capacity();
+    empty_buckets += histogram.empty() ? 0 : histogram[0];
+    longest_bucket = std::max(longest_bucket, histogram.empty() ? 0 : histogram.size() - 1);
+    found += shard.term_metric.hit_count();
+    created += shard.term_metric.miss_count();
+  }
+
+  os << "{\"name\": \"" << identifier << "\", \"arity\": ";
+  if (arity == DynamicNumberOfArguments)
+  {
+    os << "\"dynamic\"";
+  }
+  else
+  {
+    os << arity;
+  }
+  os << ", \"terms\": " << terms
+     << ", \"buckets\": " << buckets
+     << ", \"empty_buckets\": " << empty_buckets
+     << ", \"longest_bucket\": " << longest_bucket
+     << ", \"load_factor\": " << (buckets > 0 ? static_cast<double>(terms) / static_cast<double>(buckets) : 0.0)
+     << ", \"shards\": " << NumberOfShards
+     << ", \"found\": " << found
+     << ", \"created\": " << created
+     << ", \"erased_blocks\": " << m_total_erased_blocks
+     << "}";
+}
+
+
+ATERM_POOL_STORAGE_TEMPLATES
+template<typename Function>
+void ATERM_POOL_STORAGE::for_each_term(Function function) const
+{
+  for (const shard& shard : m_shards)
+  {
+    for (const Element& term : shard.term_set)
+    {
+      // Every term is stored in a node of a bucket list that has an additional pointer.
+      std::size_t bytes = sizeof(Element) + sizeof(void*);
+      if (is_dynamic_storage())
+      {
+        bytes += (term.function().arity() - 1) * sizeof(aterm);
+      }
+
+      function(static_cast<const _aterm&>(term), bytes);
+    }
+  }
+}
 
 ATERM_POOL_STORAGE_TEMPLATES
 void ATERM_POOL_STORAGE::mark()
 {
-  for (Element& term : m_term_set)
+  for (std::size_t i = 0; i < NumberOfShards; ++i)
+  {
+    mark(i, m_todo);
+  }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::mark(std::size_t shard, term_stack& todo)
+{
+  assert(shard < NumberOfShards);
+  for (Element& term : m_shards[shard].term_set)
   {
     // If a term is marked its arguments have been marked as well.
     if (term.is_reachable() && !term.is_marked())
     {
       // Mark all terms (and their subterms) that are reachable, i.e the root set.
-      mark_term(term);
+      mark_term(term, todo);
     }
   }
 }
@@ -187,28 +274,129 @@ void ATERM_POOL_STORAGE::mark()
 ATERM_POOL_STORAGE_TEMPLATES
 void ATERM_POOL_STORAGE::sweep()
 {
-  // Iterate over all terms and removes the ones that are marked.
-  for (auto it = m_term_set.begin(); it != m_term_set.end(); )
+  m_erasedBlocks = 0;
+  for (shard& shard : m_shards)
   {
-    Element& term = *it;
+    // Iterate over all terms and removes the ones that are marked.
+    for (auto it = shard.term_set.begin(); it != shard.term_set.end(); )
+    {
+      Element& term = *it;
 
-    if (!term.is_reachable())
+      if (!term.is_reachable())
+      {
+        it = destroy(shard, it);
+      }
+      else
+      {
+        // Reset terms that have been marked.
+        if (term.is_marked())
+        {
+          term.reset();
+        }
+        ++it;
+      }
+    }
+
+    // Clean up unnecessary blocks.
+    const std::size_t erased_blocks = shard.term_set.allocator().consolidate();
+    m_erasedBlocks += erased_blocks;
+    m_total_erased_blocks += erased_blocks;
+
+    // All remaining terms belong to the old generation.
+    shard.young_terms.clear();
+  }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::mark_young(const std::unordered_set<const _aterm*>& young_terms)
+{
+  for (shard& shard : m_shards)
+  {
+    for (Element* term : shard.young_terms)
     {
-      it = destroy(it);
+      if (term->is_reachable() && !term->is_marked())
+      {
+        m_todo.push(*term);
+
+        // Only explore young arguments, the old generation is not collected.
+        while (!m_todo.empty())
+        {
+          _term_appl& term_appl = static_cast<_term_appl&>(m_todo.top().get());
+          m_todo.pop();
+
+          const std::size_t arity = term_appl.function().arity();
+          for (std::size_t i = 0; i < arity; ++i)
+          {
+            _aterm& argument = *detail::address(term_appl.arg(i));
+            if (young_terms.count(&argument) > 0 && argument.try_mark())
+            {
+              m_todo.push(argument);
+            }
+          }
+        }
+      }
     }
-    else
+  }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::sweep_young()
+{
+  for (shard& shard : m_shards)
+  {
+    for (Element* term : shard.young_terms)
     {
-      // Reset terms that have been marked.
-      if (term.is_marked())
+      if (!term->is_reachable())
+      {
+        // Trigger the deletion hook before the term is actually destroyed.
+        call_deletion_hook(term);
+        shard.term_set.erase(*term);
+      }
+      else if (term->is_marked())
       {
-        term.reset();
+        term->reset();
       }
-      ++it;
     }
+
+    // The remaining young terms are promoted to the old generation.
+    shard.young_terms.clear();
   }
+}
 
-  // Clean up unnecessary blocks.
-  m_erasedBlocks = m_term_set.allocator().consolidate();
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::insert_young(std::unordered_set<const _aterm*>& young_terms) const
+{
+  for (const shard& shard : m_shards)
+  {
+    young_terms.insert(shard.young_terms.begin(), shard.young_terms.end());
+  }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::clear_young()
+{
+  for (shard& shard : m_shards)
+  {
+    shard.young_terms.clear();
+  }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::enable_young_generation(bool enable)
+{
+  m_record_young_terms = enable;
+  clear_young();
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+std::size_t ATERM_POOL_STORAGE::size() const
+{
+  std::size_t result = 0;
+  for (const shard& shard : m_shards)
+  {
+    result += shard.term_set.size();
+  }
+  return result;
 }
 
 /// PRIVATE FUNCTIONS
@@ -242,15 +430,18 @@ ATERM_POOL_STORAGE_TEMPLATES
 bool ATERM_POOL_STORAGE::verify_mark()
 {
   // Check for consistency that if a term is reachable its arguments are as well.
-  for (Element& term : m_term_set)
+  for (shard& shard : m_shards)
   {
-    if (term.is_reachable() && term.function().arity() > 0)
+    for (Element& term : shard.term_set)
     {
-       const _term_appl& ta = static_cast<const _term_appl&>(term);
-       for (std::size_t i = 0; i < ta.function().arity(); ++i)
-       {
-         assert(detail::address(ta.arg(i))->is_reachable());
-       }
+      if (term.is_reachable() && term.function().arity() > 0)
+      {
+         const _term_appl& ta = static_cast<const _term_appl&>(term);
+         for (std::size_t i = 0; i < ta.function().arity(); ++i)
+         {
+           assert(detail::address(ta.arg(i))->is_reachable());
+         }
+      }
     }
   }
   return true;
@@ -260,10 +451,13 @@ ATERM_POOL_STORAGE_TEMPLATES
 bool ATERM_POOL_STORAGE::verify_sweep()
 {
   // Check that no argument was removed from a reachable term.
-  for (Element& term : m_term_set)
+  for (shard& shard : m_shards)
   {
-    (void)term;
-    assert(verify_term(term));
+    for (Element& term : shard.term_set)
+    {
+      (void)term;
+      assert(verify_term(term));
+    }
   }
   return true;
 }
@@ -271,7 +465,7 @@ bool ATERM_POOL_STORAGE::verify_sweep()
 /// Private definitions
 
 ATERM_POOL_STORAGE_TEMPLATES
-typename ATERM_POOL_STORAGE::iterator ATERM_POOL_STORAGE::destroy(iterator it)
+typename ATERM_POOL_STORAGE::iterator ATERM_POOL_STORAGE::destroy(shard& shard, iterator it)
 {
   // Store the term temporarily to be able to deallocate it after removing it from the set.
   Element& term = *it;
@@ -281,32 +475,69 @@ typename ATERM_POOL_STORAGE::iterator ATERM_POOL_STORAGE::destroy(iterator it)
   call_deletion_hook(&term);
 
   // Remove them from the hash table, will also destroy terms with fixed arity.
-  return m_term_set.erase(it);
+  return shard.term_set.erase(it);
 }
 
 ATERM_POOL_STORAGE_TEMPLATES
 template<typename ...Args>
 aterm ATERM_POOL_STORAGE::emplace(Args&&... args)
 {
+  shard& shard = find_shard(args...);
 
-  auto result = m_term_set.emplace(std::forward<Args>(args)...);
-  aterm term(&(*result.first));
-  if (result.second)
+  aterm term;
+  bool inserted = false;
+  {
+    // The lock is released before the hooks are called and garbage is collected as these can create terms.
+    std::unique_lock<std::mutex> lock(shard.mutex, std::defer_lock);
+    if (ThreadSafe) { lock.lock(); }
+
+    auto result = shard.term_set.emplace(std::forward<Args>(args)...);
+    term = aterm(&(*result.first));
+    inserted = result.second;
+
+    if (EnableTermCreationMetrics || m_pool.metrics_enabled())
+    {
+      if (inserted) { shard.term_metric.miss(); } else { shard.term_metric.hit(); }
+    }
+
+    if (inserted && m_record_young_terms)
+    {
+      shard.young_terms.push_back(&(*result.first));
+    }
+  }
+
+  if (inserted)
   {
     // A new term was created
-    if (EnableTermCreationMetrics) { m_term_metric.miss(); }
     m_pool.trigger_collection();
     call_creation_hook(term);
   }
-  else if (EnableTermCreationMetrics)
+  else
   {
     // A term was already found in the set.
-    m_term_metric.hit();
+    m_pool.safepoint();
   }
 
   return term;
 }
 
+ATERM_POOL_STORAGE_TEMPLATES
+template<typename ...Args>
+typename ATERM_POOL_STORAGE::shard& ATERM_POOL_STORAGE::find_shard(const Args&... args)
+{
+  if (NumberOfShards == 1)
+  {
+    return m_shards[0];
+  }
+
+  // The hash tables use the lowest bits of the hash, so use Fibonacci hashing to select the shard
+  // based on all bits of the hash.
+  const std::size_t hash = Hash()(args...);
+  const std::size_t index = (hash * static_cast<std::size_t>(11400714819323198485ULL)) >> (std::numeric_limits<std::size_t>::digits - (ShardBits > 0 ? ShardBits : 1));
+  assert(index < NumberOfShards);
+  return m_shards[index];
+}
+
 ATERM_POOL_STORAGE_TEMPLATES
 constexpr bool ATERM_POOL_STORAGE::is_dynamic_storage() const
 {
@@ -314,7 +545,7 @@ constexpr bool ATERM_POOL_STORAGE::is_dynamic_storage() const
 }
 
 ATERM_POOL_STORAGE_TEMPLATES
-void ATERM_POOL_STORAGE::mark_term(_aterm& root)
+void ATERM_POOL_STORAGE::mark_term(_aterm& root, term_stack& todo)
 {
   // Do not use the stack, because this might run out of stack memory for large lists.
   todo.push(root);
@@ -334,12 +565,11 @@ void ATERM_POOL_STORAGE::mark_term(_aterm& root)
       // Marks all arguments that are not already (marked as) reachable, because the current
       // term is reachable and as such its arguments are reachable as well.
       _aterm& argument = *detail::address(term_appl.arg(i));
-      if (!argument.is_reachable())
-      {
-        // Only mark this term if it current is unreachable, because the marking is applied to
-        // the reference counter.
-        argument.mark();
 
+      // Only mark this term if it current is unreachable, because the marking is applied to
+      // the reference counter. When another thread marked it first then that thread explores it.
+      if (argument.try_mark())
+      {
         // Add the argument to be explored as well.
         todo.push(argument);
       }
@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace atermpp
@@ -48,8 +49,13 @@ public:
   function_symbol create(const std::string& name, const std::size_t arity, const bool check_for_registered_functions = false);
 
   /// \brief Frees the memory used by the passed element and remove it from the set.
+  /// \details When GlobalThreadSafe is true the element is only removed by sweep().
   void destroy(_function_symbol* f);
 
+  /// \brief Removes all function symbols that are no longer referenced.
+  /// \details Assumes that no other thread accesses function symbols concurrently.
+  void sweep();
+
   /// \brief Restore the index back to index before registering this prefix.
   void deregister(const std::string& prefix);
 
@@ -78,16 +84,23 @@ public:
   std::size_t size() const noexcept { return m_symbol_set.size(); }
 
 private:
+  /// \brief Implements get_sufficiently_large_postfix_index without acquiring the lock.
+  std::size_t sufficiently_large_postfix_index(const std::string& prefix) const;
+
+  /// \brief The set is protected by m_mutex, so the set itself does not have to be thread-safe.
   using unordered_set = mcrl2::utilities::unordered_set<
     _function_symbol,
     function_symbol_hasher,
     function_symbol_equals,
-    mcrl2::utilities::block_allocator<_function_symbol, 1024, GlobalThreadSafe>,
-    GlobalThreadSafe>;
+    mcrl2::utilities::block_allocator<_function_symbol, 1024, false>,
+    false>;
 
   /// \brief Stores the underlying function symbols.
   unordered_set m_symbol_set;
 
+  /// \brief Protects the symbol set and the prefix map whenever GlobalThreadSafe is true.
+  mutable std::mutex m_mutex;
+
   /// \brief A map that records a function for each prefix that must be called to set the
   ///        postfix number to a sufficiently high number if a function symbol with the same
   ///        prefix string is registered.
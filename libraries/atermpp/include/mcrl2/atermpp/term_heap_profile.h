@@ -0,0 +1,93 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_TERM_HEAP_PROFILE_H
+#define MCRL2_ATERMPP_TERM_HEAP_PROFILE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace atermpp
+{
+
+/// \brief A histogram of the terms in the term pool, and the number of bytes that they occupy, grouped
+///        by a key such as their function symbol.
+class term_heap_profile
+{
+public:
+  /// \brief The terms that belong to one group of the histogram.
+  struct entry
+  {
+    std::string name;
+    std::size_t terms;
+    std::size_t bytes;
+  };
+
+  term_heap_profile() = default;
+
+  /// \brief A profile with the given entries, which are sorted by the number of bytes in descending order.
+  explicit term_heap_profile(std::vector<entry> entries)
+    : m_entries(std::move(entries))
+  {
+    std::sort(m_entries.begin(), m_entries.end(), [](const entry& left, const entry& right)
+      {
+        return left.bytes > right.bytes || (left.bytes == right.bytes && left.name < right.name);
+      });
+
+    for (const entry& entry : m_entries)
+    {
+      m_terms += entry.terms;
+      m_bytes += entry.bytes;
+    }
+  }
+
+  /// \returns The entries of the histogram, sorted by the number of bytes in descending order.
+  const std::vector<entry>& entries() const { return m_entries; }
+
+  /// \returns The total number of terms in this profile.
+  std::size_t terms() const { return m_terms; }
+
+  /// \returns The total number of bytes occupied by the terms in this profile.
+  std::size_t bytes() const { return m_bytes; }
+
+  /// \brief Writes the largest entries of the histogram as a table.
+  void write(std::ostream& os, std::size_t maximum_entries = 25) const
+  {
+    os << "Term heap profile of " << m_terms << " terms occupying " << m_bytes << " bytes.\n";
+    os << std::setw(14) << "terms" << std::setw(16) << "bytes" << std::setw(8) << "%" << "  name\n";
+
+    std::size_t printed = 0;
+    for (const entry& entry : m_entries)
+    {
+      if (printed++ == maximum_entries)
+      {
+        os << "... and " << m_entries.size() - maximum_entries << " more.\n";
+        break;
+      }
+
+      const double percentage = m_bytes > 0 ? 100.0 * static_cast<double>(entry.bytes) / static_cast<double>(m_bytes) : 0.0;
+      os << std::setw(14) << entry.terms << std::setw(16) << entry.bytes
+         << std::setw(8) << std::fixed << std::setprecision(2) << percentage << "  " << entry.name << "\n";
+    }
+  }
+
+private:
+  std::vector<entry> m_entries;
+  std::size_t m_terms = 0;
+  std::size_t m_bytes = 0;
+};
+
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_TERM_HEAP_PROFILE_H
@@ -0,0 +1,56 @@
+// Author(s): Maurice Laveaux.
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_TERM_POOL_THREAD_H
+#define MCRL2_ATERMPP_TERM_POOL_THREAD_H
+
+#include "mcrl2/atermpp/detail/global_aterm_pool.h"
+#include "mcrl2/utilities/noncopyable.h"
+
+namespace atermpp
+{
+
+/// \brief Registers the current thread as a thread that creates and accesses terms during the
+///        lifetime of this object. Every thread, except the one that initialised the term
+///        library, must be registered before it uses terms.
+/// \details Has no effect unless the toolset was built with MCRL2_ENABLE_THREADSAFE.
+class term_pool_thread_guard : private mcrl2::utilities::noncopyable
+{
+public:
+  term_pool_thread_guard()
+  {
+    detail::g_term_pool().register_thread();
+  }
+
+  ~term_pool_thread_guard()
+  {
+    detail::g_term_pool().deregister_thread();
+  }
+};
+
+/// \brief Indicates that the current thread does not access terms during the lifetime of this object,
+///        for example while it waits for other threads, such that these can collect garbage.
+/// \details Has no effect unless the toolset was built with MCRL2_ENABLE_THREADSAFE.
+class term_pool_safe_region : private mcrl2::utilities::noncopyable
+{
+public:
+  term_pool_safe_region()
+  {
+    detail::g_term_pool().enter_safe_region();
+  }
+
+  ~term_pool_safe_region()
+  {
+    detail::g_term_pool().leave_safe_region();
+  }
+};
+
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_TERM_POOL_THREAD_H
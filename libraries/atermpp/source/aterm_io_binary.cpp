@@ -17,6 +17,7 @@
 #include "mcrl2/atermpp/aterm.h"
 #include "mcrl2/atermpp/aterm_int.h"
 #include "mcrl2/atermpp/aterm_io.h"
+#include "mcrl2/atermpp/aterm_io_binary.h"
 #include "mcrl2/atermpp/aterm_list.h"
 #include "mcrl2/atermpp/detail/aterm_io_implementation.h"
 
@@ -24,6 +25,7 @@
 #include "mcrl2/utilities/exception.h"
 #include "mcrl2/utilities/indexed_set.h"
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/memory_mapped_file.h"
 #include "mcrl2/utilities/platform.h"
 #include "mcrl2/utilities/unordered_map.h"
 #include "mcrl2/utilities/unused.h"
@@ -34,6 +36,7 @@
 #include <cassert>
 #include <stdexcept>
 #include <bitset>
+#include <fstream>
 
 #ifdef MCRL2_PLATFORM_WINDOWS
 #include <io.h>
@@ -50,6 +53,7 @@ namespace atermpp
 
 using detail::readInt;
 using detail::writeInt;
+using mcrl2::utilities::bit_width;
 
 using namespace std;
 
@@ -357,28 +361,6 @@ static std::size_t get_fn_symbol_index(const aterm& t, const mcrl2::utilities::i
   return result;
 }
 
-/**
- * How many bits are needed to represent val?
- * Basically, this function is equal to log2(val), except that it maps 0 to 0
- */
-static std::size_t bit_width(std::size_t val)
-{
-  std::size_t nr_bits = 0;
-
-  if (val <= 1)
-  {
-    return 0;
-  }
-
-  while (val)
-  {
-    val>>=1;
-    nr_bits++;
-  }
-
-  return nr_bits;
-}
-
 /**
  * \brief Get argument number i (zero indexed) from term t.
  */
@@ -811,4 +793,253 @@ aterm read_term_from_binary_stream(istream& is)
   return result;
 }
 
+// The version of the streamable binary format written by binary_aterm_ostream, which is distinct
+// from BAF_VERSION such that both formats are never confused.
+//
+// History:
+//
+// 16 October 2026 : version 0x8305 (introduction of the streamable format)
+
+static const std::size_t BAF_STREAM_VERSION = 0x8305;
+
+/// \brief The packets of the streamable binary format.
+enum class packet_type : std::size_t
+{
+  end_of_stream = 0,   ///< Marks the end of the stream.
+  function_symbol = 1, ///< Defines the next function symbol by its name and arity.
+  aterm = 2,           ///< Defines the next subterm by its function symbol and previously defined arguments.
+  aterm_int = 3,       ///< Defines the next subterm as an integer.
+  aterm_output = 4     ///< Refers to a previously defined subterm that is the next term of the stream.
+};
+
+/// \brief The number of bits used to encode the packet type.
+static const unsigned int packet_bits = 3;
+
+binary_aterm_ostream::binary_aterm_ostream(std::ostream& os)
+  : m_stream(os)
+{
+  aterm_io_init(os);
+
+  // The header is written byte aligned in the same way as the header of BAF.
+  writeInt(0, os);
+  writeInt(BAF_MAGIC, os);
+  writeInt(BAF_STREAM_VERSION, os);
+}
+
+binary_aterm_ostream::~binary_aterm_ostream()
+{
+  m_stream.write_bits(static_cast<std::size_t>(packet_type::end_of_stream), packet_bits);
+}
+
+std::size_t binary_aterm_ostream::write_function_symbol(const function_symbol& symbol)
+{
+  auto result = m_function_symbols.insert(symbol);
+  if (result.second)
+  {
+    m_stream.write_bits(static_cast<std::size_t>(packet_type::function_symbol), packet_bits);
+    m_stream.write_string(symbol.name());
+    m_stream.write_integer(symbol.arity());
+  }
+
+  return (*result.first).second;
+}
+
+void binary_aterm_ostream::put(const aterm& term)
+{
+  if (m_terms.find(term) == m_terms.end())
+  {
+    // Write the subterms that were not written before in a postfix order, such that
+    // the arguments of every term have been defined before the term itself.
+    std::stack<write_todo> stack;
+    stack.emplace(term);
+
+    do
+    {
+      write_todo& current = stack.top();
+      if (current.term.type_is_int())
+      {
+        m_stream.write_bits(static_cast<std::size_t>(packet_type::aterm_int), packet_bits);
+        m_stream.write_integer(down_cast<aterm_int>(current.term).value());
+        m_terms.insert(current.term);
+        stack.pop();
+      }
+      else if (current.arg >= get_function_symbol(current.term).arity())
+      {
+        // All arguments have been written.
+        const function_symbol& symbol = get_function_symbol(current.term);
+        std::size_t symbol_index = write_function_symbol(symbol);
+
+        m_stream.write_bits(static_cast<std::size_t>(packet_type::aterm), packet_bits);
+        m_stream.write_bits(symbol_index, bit_width(m_function_symbols.size()));
+
+        const std::size_t term_width = bit_width(m_terms.size());
+        for (std::size_t i = 0; i < symbol.arity(); ++i)
+        {
+          m_stream.write_bits(m_terms.at(subterm(current.term, i)), term_width);
+        }
+
+        m_terms.insert(current.term);
+        stack.pop();
+      }
+      else
+      {
+        const aterm& argument = subterm(current.term, current.arg++);
+        if (m_terms.find(argument) == m_terms.end())
+        {
+          stack.emplace(argument);
+        }
+      }
+    }
+    while (!stack.empty());
+  }
+
+  m_stream.write_bits(static_cast<std::size_t>(packet_type::aterm_output), packet_bits);
+  m_stream.write_bits(m_terms.at(term), bit_width(m_terms.size()));
+}
+
+binary_aterm_istream::binary_aterm_istream(std::istream& is)
+  : m_stream(is)
+{
+  aterm_io_init(is);
+
+  std::size_t value = readInt(is);
+  if (value == 0)
+  {
+    value = readInt(is);
+  }
+  if (value != BAF_MAGIC)
+  {
+    throw mcrl2::runtime_error("Error while reading the input: it does not have the BAF_MAGIC control sequence at the right place.");
+  }
+
+  std::size_t version = readInt(is);
+  if (version != BAF_STREAM_VERSION)
+  {
+    throw mcrl2::runtime_error("The binary term stream version (" + std::to_string(version) + ") of the input is incompatible with the version (" +
+                               std::to_string(BAF_STREAM_VERSION) + ") of this tool. The input must be regenerated.");
+  }
+}
+
+bool binary_aterm_istream::get(aterm& term)
+{
+  if (m_end_of_stream)
+  {
+    return false;
+  }
+
+  std::vector<aterm> arguments;
+  while (true)
+  {
+    switch (static_cast<packet_type>(m_stream.read_bits(packet_bits)))
+    {
+      case packet_type::end_of_stream:
+      {
+        m_end_of_stream = true;
+        return false;
+      }
+      case packet_type::function_symbol:
+      {
+        std::string name = m_stream.read_string();
+        std::size_t arity = m_stream.read_integer();
+        m_function_symbols.emplace_back(name, arity);
+        break;
+      }
+      case packet_type::aterm_int:
+      {
+        m_terms.emplace_back(aterm_int(m_stream.read_integer()));
+        break;
+      }
+      case packet_type::aterm:
+      {
+        std::size_t symbol_index = m_stream.read_bits(bit_width(m_function_symbols.size()));
+        if (symbol_index >= m_function_symbols.size())
+        {
+          throw mcrl2::runtime_error("Could not read valid aterm from stream, it refers to an undefined function symbol.");
+        }
+        const function_symbol& symbol = m_function_symbols[symbol_index];
+
+        const std::size_t term_width = bit_width(m_terms.size());
+        arguments.clear();
+        for (std::size_t i = 0; i < symbol.arity(); ++i)
+        {
+          std::size_t term_index = m_stream.read_bits(term_width);
+          if (term_index >= m_terms.size())
+          {
+            throw mcrl2::runtime_error("Could not read valid aterm from stream, it refers to an undefined subterm.");
+          }
+          arguments.push_back(m_terms[term_index]);
+        }
+
+        if (symbol == detail::g_term_pool().as_empty_list())
+        {
+          m_terms.emplace_back(aterm_list());
+        }
+        else if (symbol == detail::g_term_pool().as_list())
+        {
+          if (!arguments[1].type_is_list())
+          {
+            throw mcrl2::runtime_error("Could not read valid aterm from stream, the tail of a list is not a list.");
+          }
+
+          aterm_list list = down_cast<aterm_list>(arguments[1]);
+          list.push_front(arguments[0]);
+          m_terms.emplace_back(list);
+        }
+        else
+        {
+          m_terms.emplace_back(aterm_appl(symbol, arguments.begin(), arguments.end()));
+        }
+        break;
+      }
+      case packet_type::aterm_output:
+      {
+        std::size_t term_index = m_stream.read_bits(bit_width(m_terms.size()));
+        if (term_index >= m_terms.size())
+        {
+          throw mcrl2::runtime_error("Could not read valid aterm from stream, it refers to an undefined term.");
+        }
+
+        term = m_terms[term_index];
+        return true;
+      }
+      default:
+        throw mcrl2::runtime_error("Could not read valid aterm from stream, it contains an unknown packet.");
+    }
+  }
+}
+
+void write_term_to_snapshot(const aterm& term, const std::string& filename)
+{
+  std::ofstream os(filename, std::ios::binary);
+  if (!os)
+  {
+    throw mcrl2::runtime_error("Could not open file " + filename + " for writing.");
+  }
+
+  {
+    binary_aterm_ostream stream(os);
+    stream << term;
+  }
+
+  if (os.fail())
+  {
+    throw mcrl2::runtime_error("Failed to write the snapshot to file " + filename + ".");
+  }
+}
+
+aterm read_term_from_snapshot(const std::string& filename)
+{
+  mcrl2::utilities::memory_mapped_file file(filename);
+  mcrl2::utilities::memory_streambuf buffer(file.data(), file.size());
+  std::istream is(&buffer);
+
+  binary_aterm_istream stream(is);
+  aterm result;
+  if (!stream.get(result))
+  {
+    throw mcrl2::runtime_error("The snapshot " + filename + " does not contain a term.");
+  }
+  return result;
+}
+
 } // namespace atermpp
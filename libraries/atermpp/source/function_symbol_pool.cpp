@@ -38,6 +38,8 @@ function_symbol_pool::~function_symbol_pool()
 
 function_symbol function_symbol_pool::create(const std::string& name, const std::size_t arity, const bool check_for_registered_functions)
 {
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (GlobalThreadSafe) { lock.lock(); }
 
   auto it = m_symbol_set.find(name, arity);
   if (it != m_symbol_set.end())
@@ -86,19 +88,47 @@ function_symbol function_symbol_pool::create(const std::string& name, const std:
 void function_symbol_pool::destroy(_function_symbol* f)
 {
   assert(f != nullptr);
+
+  // Another thread might obtain this function symbol again before it is removed, so leave it to sweep().
+  if (GlobalThreadSafe)
+  {
+    return;
+  }
+
   assert(f->reference_count() == 0);
 
   // Remove it from the function symbol pool.
   m_symbol_set.erase(*f);
 }
 
+void function_symbol_pool::sweep()
+{
+  for (auto it = m_symbol_set.begin(); it != m_symbol_set.end(); )
+  {
+    if (it->reference_count() == 0)
+    {
+      it = m_symbol_set.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
 void function_symbol_pool::deregister(const std::string& prefix)
 {
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (GlobalThreadSafe) { lock.lock(); }
+
   m_prefix_to_register_function_map.erase(prefix);
 }
 
 std::shared_ptr<std::size_t> function_symbol_pool::register_prefix(const std::string& prefix)
 {
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (GlobalThreadSafe) { lock.lock(); }
+
   auto it = m_prefix_to_register_function_map.find(prefix);
   if (it != m_prefix_to_register_function_map.end())
   {
@@ -106,7 +136,7 @@ std::shared_ptr<std::size_t> function_symbol_pool::register_prefix(const std::st
   }
   else
   {
-    std::size_t index = get_sufficiently_large_postfix_index(prefix);
+    std::size_t index = sufficiently_large_postfix_index(prefix);
     std::shared_ptr<std::size_t> shared_index = std::make_shared<std::size_t>(index);
     m_prefix_to_register_function_map[prefix] = shared_index;
     return shared_index;
@@ -114,6 +144,14 @@ std::shared_ptr<std::size_t> function_symbol_pool::register_prefix(const std::st
 }
 
 std::size_t function_symbol_pool::get_sufficiently_large_postfix_index(const std::string& prefix) const
+{
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (GlobalThreadSafe) { lock.lock(); }
+
+  return sufficiently_large_postfix_index(prefix);
+}
+
+std::size_t function_symbol_pool::sufficiently_large_postfix_index(const std::string& prefix) const
 {
   std::size_t index = 0;
   for (const auto& f : m_symbol_set)
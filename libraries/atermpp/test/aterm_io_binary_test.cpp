@@ -0,0 +1,140 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file aterm_io_binary_test.cpp
+/// \brief Tests writing and reading terms in the binary formats.
+
+#include <boost/test/minimal.hpp>
+
+#include "mcrl2/atermpp/aterm_appl.h"
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/atermpp/aterm_io.h"
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/atermpp/aterm_list.h"
+
+#include <cstdio>
+#include <sstream>
+
+using namespace atermpp;
+
+static std::vector<aterm> example_terms()
+{
+  function_symbol f("f", 2);
+  function_symbol g("g", 1);
+  aterm_appl c(function_symbol("c", 0));
+
+  std::vector<aterm> result;
+  result.push_back(c);
+  result.push_back(aterm_appl(f, c, aterm_int(42)));
+  result.push_back(aterm_appl(g, aterm_appl(f, c, aterm_int(42))));
+  result.push_back(aterm_list());
+  result.push_back(aterm_list({ aterm_int(1), aterm_int(2), c }));
+  result.push_back(aterm_int(std::numeric_limits<std::size_t>::max()));
+  result.push_back(aterm_appl(f, aterm_list({ aterm_int(1), aterm_int(2), c }), aterm_appl(g, c)));
+  result.push_back(c);
+  return result;
+}
+
+void test_binary_stream()
+{
+  std::vector<aterm> terms = example_terms();
+
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(stream);
+    for (const aterm& term : terms)
+    {
+      output << term;
+    }
+  }
+
+  BOOST_CHECK(is_binary_aterm_stream(stream));
+  stream.seekg(0);
+
+  binary_aterm_istream input(stream);
+  aterm term;
+  for (const aterm& expected : terms)
+  {
+    BOOST_CHECK(input.get(term));
+    BOOST_CHECK(term == expected);
+  }
+
+  BOOST_CHECK(!input.get(term));
+  BOOST_CHECK(!input.get(term));
+}
+
+void test_empty_binary_stream()
+{
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(stream);
+  }
+
+  binary_aterm_istream input(stream);
+  aterm term;
+  BOOST_CHECK(!input.get(term));
+}
+
+void test_large_binary_stream()
+{
+  // Write many terms that share subterms with previously written terms.
+  function_symbol f("f", 2);
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(stream);
+    aterm_appl term(function_symbol("c", 0));
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+      term = aterm_appl(f, aterm_int(i % 100), term);
+      output << term;
+    }
+  }
+
+  binary_aterm_istream input(stream);
+  aterm_appl expected(function_symbol("c", 0));
+  aterm term;
+  for (std::size_t i = 0; i < 10000; ++i)
+  {
+    expected = aterm_appl(f, aterm_int(i % 100), expected);
+    BOOST_CHECK(input.get(term));
+    BOOST_CHECK(term == expected);
+  }
+  BOOST_CHECK(!input.get(term));
+}
+
+void test_baf()
+{
+  for (const aterm& term : example_terms())
+  {
+    std::stringstream stream;
+    write_term_to_binary_stream(term, stream);
+    BOOST_CHECK(read_term_from_binary_stream(stream) == term);
+  }
+}
+
+void test_snapshot()
+{
+  const std::string filename = "aterm_io_binary_test.snapshot";
+  for (const aterm& term : example_terms())
+  {
+    write_term_to_snapshot(term, filename);
+    BOOST_CHECK(read_term_from_snapshot(filename) == term);
+  }
+  std::remove(filename.c_str());
+}
+
+int test_main(int, char*[])
+{
+  test_binary_stream();
+  test_empty_binary_stream();
+  test_large_binary_stream();
+  test_baf();
+  test_snapshot();
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file generational_collection_test.cpp
+/// \brief Tests the collection of only the young generation of terms.
+
+#include <boost/test/minimal.hpp>
+
+#include "mcrl2/atermpp/aterm_appl.h"
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/atermpp/aterm_list.h"
+
+using namespace atermpp;
+
+void test_young_collection()
+{
+  detail::aterm_pool& pool = detail::g_term_pool();
+  pool.collect();
+
+  function_symbol f("f", 2);
+  function_symbol g("g", 1);
+
+  // Create an old term that is not referenced, but kept until the next full collection.
+  {
+    aterm_appl old_term(g, aterm_int(123456));
+  }
+  aterm_appl old_reachable(g, aterm_int(654321));
+
+  pool.enable_generational_collection(true, 100);
+  std::size_t old_size = pool.size();
+
+  // Create young terms of which only the last one, and the terms it refers to, remain reachable.
+  aterm_appl reachable(g, old_reachable);
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    aterm_appl unreachable(f, aterm_int(1000000 + i), old_reachable);
+    reachable = aterm_appl(f, aterm_int(i), reachable);
+  }
+
+  // Trigger a collection of only the young generation.
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    aterm_int garbage(2000000 + i);
+  }
+
+  BOOST_CHECK(pool.size() < old_size + 200);
+  BOOST_CHECK(pool.size() > old_size);
+
+  // The reachable young terms and old terms are unchanged.
+  aterm_appl expected(g, aterm_appl(g, aterm_int(654321)));
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    expected = aterm_appl(f, aterm_int(i), expected);
+  }
+  BOOST_CHECK(reachable == expected);
+  BOOST_CHECK(old_reachable == aterm_appl(g, aterm_int(654321)));
+
+  // A full collection removes the unreferenced old term as well.
+  pool.collect();
+  std::size_t size = pool.size();
+  {
+    aterm_appl old_term(g, aterm_int(123456));
+  }
+  BOOST_CHECK(pool.size() == size + 2);
+
+  pool.enable_generational_collection(false);
+}
+
+int test_main(int, char*[])
+{
+  test_young_collection();
+
+  return 0;
+}
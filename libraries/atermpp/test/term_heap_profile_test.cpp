@@ -0,0 +1,89 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file term_heap_profile_test.cpp
+/// \brief Tests the histograms of the live terms in the term pool.
+
+#include <boost/test/minimal.hpp>
+
+#include "mcrl2/atermpp/aterm_appl.h"
+#include "mcrl2/atermpp/aterm_int.h"
+
+#include <sstream>
+
+using namespace atermpp;
+
+static const term_heap_profile::entry* find_entry(const term_heap_profile& profile, const std::string& name)
+{
+  for (const term_heap_profile::entry& entry : profile.entries())
+  {
+    if (entry.name == name)
+    {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void test_heap_profile()
+{
+  detail::aterm_pool& pool = detail::g_term_pool();
+  pool.enable_heap_profiling(true);
+
+  function_symbol f("profile_f", 2);
+  function_symbol g("profile_g", 9);
+  aterm_appl c(function_symbol("profile_c", 0));
+
+  std::vector<aterm_appl> terms;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    terms.emplace_back(f, c, aterm_int(i));
+  }
+  std::vector<aterm> arguments(8, c);
+  arguments.push_back(terms[0]);
+  aterm_appl large(g, arguments.begin(), arguments.end());
+
+  pool.collect();
+
+  term_heap_profile profile = pool.heap_profile();
+  BOOST_CHECK(profile.terms() == pool.size());
+
+  const term_heap_profile::entry* f_entry = find_entry(profile, "profile_f/2");
+  BOOST_CHECK(f_entry != nullptr && f_entry->terms == 100);
+
+  // Terms with more arguments occupy more memory.
+  const term_heap_profile::entry* g_entry = find_entry(profile, "profile_g/9");
+  BOOST_CHECK(g_entry != nullptr && g_entry->terms == 1 && g_entry->bytes > f_entry->bytes / 100);
+
+  // The profile is sorted by the number of bytes.
+  for (std::size_t i = 1; i < profile.entries().size(); ++i)
+  {
+    BOOST_CHECK(profile.entries()[i - 1].bytes >= profile.entries()[i].bytes);
+  }
+
+  BOOST_CHECK(pool.peak_heap_profile().terms() >= profile.terms());
+
+  // Classify the terms by their first argument.
+  term_heap_profile by_argument = pool.heap_profile(
+    [](const aterm& term) { return term.type_is_appl() && down_cast<aterm_appl>(term).size() > 0 ? down_cast<aterm_appl>(term)[0] : aterm(); },
+    [](const aterm& key) { return pp(key); });
+  const term_heap_profile::entry* c_entry = find_entry(by_argument, "profile_c");
+  BOOST_CHECK(c_entry != nullptr && c_entry->terms == 101);
+  BOOST_CHECK(find_entry(by_argument, "other") != nullptr);
+
+  std::stringstream stream;
+  profile.write(stream);
+  BOOST_CHECK(stream.str().find("profile_f/2") != std::string::npos);
+}
+
+int test_main(int, char*[])
+{
+  test_heap_profile();
+
+  return 0;
+}
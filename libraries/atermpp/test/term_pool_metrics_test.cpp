@@ -0,0 +1,62 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file term_pool_metrics_test.cpp
+/// \brief Tests the metrics of the term pool that can be enabled at run time.
+
+#include <boost/test/minimal.hpp>
+
+#include "mcrl2/atermpp/aterm_appl.h"
+#include "mcrl2/atermpp/aterm_int.h"
+
+#include <sstream>
+
+using namespace atermpp;
+
+void test_metrics()
+{
+  detail::aterm_pool& pool = detail::g_term_pool();
+  pool.enable_metrics(true);
+  BOOST_CHECK(pool.metrics_enabled());
+
+  function_symbol f("metrics_f", 2);
+  aterm_appl c(function_symbol("metrics_c", 0));
+
+  // Create ten new terms f(c, i) and find each of them once more.
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    aterm_appl created(f, c, aterm_int(i));
+    aterm_appl found(f, c, aterm_int(i));
+    BOOST_CHECK(created == found);
+  }
+
+  std::stringstream stream;
+  pool.write_metrics(stream);
+  std::string metrics = stream.str();
+
+  BOOST_CHECK(metrics.find("\"storages\": [") != std::string::npos);
+  BOOST_CHECK(metrics.find("{\"name\": \"function_application_storage_2\", \"arity\": 2,") != std::string::npos);
+  BOOST_CHECK(metrics.find("\"arity\": \"dynamic\"") != std::string::npos);
+  BOOST_CHECK(metrics.find("\"pages\": {\"backing\": ") != std::string::npos);
+
+  std::size_t storage = metrics.find("function_application_storage_2");
+  std::size_t found = metrics.find("\"found\": ", storage);
+  std::size_t created = metrics.find("\"created\": ", storage);
+  BOOST_CHECK(std::stoul(metrics.substr(found + 9)) >= 10);
+  BOOST_CHECK(std::stoul(metrics.substr(created + 11)) >= 10);
+
+  pool.enable_metrics(false);
+  BOOST_CHECK(!pool.metrics_enabled());
+}
+
+int test_main(int, char*[])
+{
+  test_metrics();
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file thread_safety_test.cpp
+/// \brief Creates terms from multiple threads whenever the term library is thread-safe.
+
+#include <boost/test/minimal.hpp>
+
+#include "mcrl2/atermpp/aterm_appl.h"
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/atermpp/aterm_list.h"
+#include "mcrl2/atermpp/term_pool_thread.h"
+
+#include <thread>
+#include <vector>
+
+using namespace atermpp;
+
+/// \brief Creates a list of nested terms f(i, f(i - 1, ...)) and collects garbage in between.
+static aterm_list create_terms(std::size_t length)
+{
+  function_symbol f("f", 2);
+
+  aterm_list result;
+  aterm_appl nested(function_symbol("c", 0));
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    nested = aterm_appl(f, aterm_int(i), nested);
+    result.push_front(nested);
+
+    if (i % 1000 == 0)
+    {
+      detail::g_term_pool().collect();
+    }
+  }
+
+  return result;
+}
+
+void test_concurrent_creation()
+{
+  const std::size_t number_of_threads = detail::GlobalThreadSafe ? 4 : 1;
+  const std::size_t length = 10000;
+
+  // Each thread creates the same terms, which must result in the same maximally shared term.
+  std::vector<aterm_list> results(number_of_threads);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    threads.emplace_back([&results, i, length]()
+      {
+        term_pool_thread_guard guard;
+        results[i] = create_terms(length);
+      });
+  }
+
+  results[0] = create_terms(length);
+
+  {
+    // Wait for the other threads, which might collect garbage in the mean time.
+    term_pool_safe_region region;
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  for (const aterm_list& result : results)
+  {
+    BOOST_CHECK(result.size() == length);
+    BOOST_CHECK(result == results[0]);
+  }
+}
+
+int test_main(int, char*[])
+{
+  test_concurrent_creation();
+
+  // Also mark and sweep using multiple threads.
+  detail::g_term_pool().set_garbage_collection_threads(4);
+  test_concurrent_creation();
+
+  return 0;
+}
@@ -490,6 +490,7 @@ class BDD_Prover: protected rewriter
       switch (a_rewrite_strategy)
       {
         case(jitty):
+        case(jitty_bytecode):
 #ifdef MCRL2_JITTYC_AVAILABLE
         case(jitty_compiling):
 #endif
@@ -17,6 +17,8 @@
 #include "mcrl2/data/selection.h"
 #include "mcrl2/data/substitutions/mutable_indexed_substitution.h"
 
+#include <atomic>
+
 namespace mcrl2
 {
 namespace data
@@ -44,6 +46,16 @@ class Rewriter
   protected:
     enumerator_identifier_generator m_generator;  //name for variables.
 
+    /// \brief A number that identifies this rewriter in the normal form tags of terms, see
+    ///        atermpp::detail::_aterm::normal_form_tag(). It is unique for every rewriter object.
+    const std::size_t m_normal_form_tag;
+
+    static std::size_t next_normal_form_tag()
+    {
+      static std::atomic<std::size_t> counter(0);
+      return ++counter;
+    }
+
   public:
     typedef mutable_indexed_substitution<> substitution_type;
 
@@ -54,6 +66,7 @@ class Rewriter
      * \sa createRewriter()
      **/
     Rewriter(const data_specification& data_spec, const used_data_equation_selector& eq_selector):
+          m_normal_form_tag(next_normal_form_tag()),
           data_equation_selector(eq_selector),
           m_data_specification_for_enumeration(data_spec)
     {
@@ -68,6 +81,12 @@ class Rewriter
     {
     }
 
+    /// \brief The tag with which this rewriter marks the closed terms that it has rewritten to normal form.
+    std::size_t normal_form_tag() const
+    {
+      return m_normal_form_tag;
+    }
+
     /** \brief The fresh name generator of the rewriter */
     data::enumerator_identifier_generator& identifier_generator()
     {
@@ -13,6 +13,7 @@
 #include "mcrl2/data/detail/rewrite.h"
 #include "mcrl2/data/data_specification.h"
 #include "mcrl2/data/detail/rewrite/strategy_rule.h"
+#include "mcrl2/data/detail/rewrite/machine_word_arithmetic.h"
 
 namespace mcrl2
 {
@@ -39,8 +40,15 @@ class RewriterJitty: public Rewriter
     std::map< function_symbol, data_equation_list > jitty_eqns;
     std::vector<strategy> jitty_strat;
 
+    /// \brief The built-in arithmetic of the function symbols, indexed like jitty_strat.
+    std::vector<machine_word_function> m_machine_word_functions;
+
+    /// \brief Rewrites term, and tags the result when it is a closed normal form.
     data_expression rewrite_aux(const data_expression& term, substitution_type& sigma);
 
+    /// \brief Rewrites term, which is not a variable, without consulting or setting normal form tags.
+    data_expression rewrite_aux_untagged(const data_expression& term, substitution_type& sigma);
+
     data_expression rewrite_aux_function_symbol(
                       const function_symbol& op,
                       const data_expression& term,
@@ -56,6 +64,10 @@ class RewriterJitty: public Rewriter
     void rebuild_strategy();
 };
 
+/// \brief The auxiliary function symbol that is put around a term to indicate that it is in normal form.
+/// \details It is used by the jitty rewriters, which return such a term without rewriting it again.
+const function_symbol& this_term_is_in_normal_form();
+
 /// \brief removes auxiliary expressions this_term_is_in_normal_form from data_expressions that are being rewritten.
 /// \details The function below is intended to remove the auxiliary function this_term_is_in_normal_form from a term
 ///          such that it can for instance be pretty printed. This auxiliary function is used internally in terms
@@ -192,6 +192,48 @@ inline const data_expression replace_nested_head(const data_expression& t, const
   return head;
 }
 
+// The rewriters mark the closed normal forms that they compute with their normal form tag in the
+// term itself. A closed term does not depend on the substitution, so whenever a tagged term is
+// encountered again it does not have to be traversed. Terms with variables, binders or where
+// clauses are never tagged.
+
+// Returns true iff t is known to be a closed normal form of the rewriter with the given tag.
+inline bool is_tagged_normal_form(const data_expression& t, const std::size_t tag)
+{
+  return atermpp::detail::address(t)->normal_form_tag()==tag;
+}
+
+// Returns true iff the arguments of t, including those of nested applications, are tagged
+// and the nested head is a function symbol.
+inline bool arguments_are_tagged_normal_forms(const application& t, const std::size_t tag)
+{
+  for (const data_expression& arg: t)
+  {
+    if (!is_tagged_normal_form(arg, tag))
+    {
+      return false;
+    }
+  }
+
+  const data_expression& head=t.head();
+  if (is_function_symbol(head))
+  {
+    return true;
+  }
+  return is_application(head) && arguments_are_tagged_normal_forms(atermpp::down_cast<application>(head), tag);
+}
+
+// Tags t, which must be a normal form of the rewriter with the given tag, when it is closed.
+// Closedness is derived from the tags of the arguments, which avoids traversing the term.
+inline void tag_normal_form(const data_expression& t, const std::size_t tag)
+{
+  if (is_function_symbol(t) ||
+      (is_application(t) && arguments_are_tagged_normal_forms(atermpp::down_cast<application>(t), tag)))
+  {
+    atermpp::detail::address(t)->set_normal_form_tag(tag);
+  }
+}
+
 template <class ARGUMENT_REWRITER>
 inline const data_expression rewrite_all_arguments(const application& t, const ARGUMENT_REWRITER rewriter)
 {
@@ -0,0 +1,139 @@
+// Author(s): Muck van Weerdenburg, Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/jittyb.h
+/// \brief A jitty rewriter that interprets a bytecode translation of the rewrite strategies.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_JITTYB_H
+#define MCRL2_DATA_DETAIL_REWRITE_JITTYB_H
+
+#include "mcrl2/data/detail/rewrite.h"
+#include "mcrl2/data/data_specification.h"
+#include "mcrl2/data/detail/rewrite/strategy_rule.h"
+
+#include <cstdint>
+
+namespace mcrl2
+{
+namespace data
+{
+namespace detail
+{
+
+namespace jittyb
+{
+
+/// \brief The operations of the bytecode. The matching instructions jump to the failure target of the
+///        current rule when they fail, the construction instructions operate on a stack of terms.
+enum class opcode : std::uint8_t
+{
+  rewrite_argument,        ///< Rewrite argument a to normal form. Stop when there is no argument a.
+  begin_rule,              ///< Start matching the rule with arity a. Stop when there are less arguments.
+                           ///< The failure target of the rule is b.
+  load_argument,           ///< Register a becomes argument b.
+  match_function_symbol,   ///< Fail unless register a is the function symbol term.
+  match_application,       ///< Fail unless register a is an application with b arguments. Its head is
+                           ///< put in register c and its arguments in the subsequent registers.
+  bind_variable,           ///< Bind variable slot b to register a.
+  match_variable,          ///< Fail unless register a is equal to the term bound to variable slot b.
+  push_term,               ///< Push term, which does not contain variables of the rule.
+  push_variable,           ///< Push the term bound to variable slot a.
+  push_substituted,        ///< Push term after substituting the variables of the rule, capture avoiding.
+                           ///< The variables of the rule are given by program::variables[a].
+  build_application,       ///< Replace the top a+1 terms of the stack by the application of the deepest to the others.
+  rewrite_application,     ///< Replace the top a terms of the stack by the normal form of the application of the
+                           ///< function symbol term to them, without constructing that application.
+  check_condition,         ///< Pop a term and fail unless its normal form is true.
+  apply_rule               ///< Pop the right hand side of a rule of arity a, apply it to the remaining arguments and
+                           ///< return its normal form.
+};
+
+struct instruction
+{
+  opcode code;
+  std::uint32_t a;
+  std::uint32_t b;
+  std::uint32_t c;
+  const atermpp::detail::_aterm* term;
+
+  instruction(opcode code_, std::uint32_t a_ = 0, std::uint32_t b_ = 0, std::uint32_t c_ = 0, const atermpp::detail::_aterm* term_ = nullptr)
+    : code(code_), a(a_), b(b_), c(c_), term(term_)
+  {}
+};
+
+/// \brief The bytecode for all rewrite rules of a single function symbol.
+/// \details The terms that instructions refer to are kept alive by the equations of the strategy.
+struct program
+{
+  strategy source;
+  std::vector<instruction> code;
+  std::size_t number_of_registers = 0;
+  std::size_t number_of_variables = 0;
+  std::vector<variable_list> variables;
+};
+
+/// \brief A term on the construction stack, together with whether it is known to be a normal form.
+struct stack_entry
+{
+  data_expression term;
+  bool is_normal_form;
+
+  stack_entry(const data_expression& term_, bool is_normal_form_)
+    : term(term_), is_normal_form(is_normal_form_)
+  {}
+};
+
+} // namespace jittyb
+
+class RewriterJittyBytecode: public Rewriter
+{
+  public:
+    typedef Rewriter::substitution_type substitution_type;
+
+    RewriterJittyBytecode(const data_specification& data_spec, const used_data_equation_selector&);
+    virtual ~RewriterJittyBytecode();
+
+    rewrite_strategy getStrategy();
+
+    data_expression rewrite(const data_expression &term, substitution_type &sigma);
+
+    RewriterJittyBytecode& operator=(const RewriterJittyBytecode& other)=delete;
+
+  private:
+    /// \brief The programs, indexed by the index of the head symbol of the rules.
+    std::vector<jittyb::program> m_programs;
+
+    /// \brief The stack on which the right hand sides and conditions are constructed.
+    std::vector<jittyb::stack_entry> m_stack;
+
+    data_expression rewrite_aux(const data_expression& term, substitution_type& sigma);
+
+    data_expression rewrite_aux_untagged(const data_expression& term, substitution_type& sigma);
+
+    data_expression rewrite_aux_function_symbol(
+                      const function_symbol& op,
+                      const data_expression& term,
+                      substitution_type& sigma);
+
+    /// \brief Rewrites the application of op to the given arguments by executing the program of op.
+    /// \param normal_forms Indicates which arguments are known to be normal forms, or nullptr if none are.
+    data_expression rewrite_arguments(
+                      const function_symbol& op,
+                      const data_expression** arguments,
+                      const bool* normal_forms,
+                      const std::size_t arity,
+                      substitution_type& sigma);
+
+    const jittyb::program* find_program(const function_symbol& op) const;
+};
+
+} // namespace detail
+} // namespace data
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_JITTYB_H
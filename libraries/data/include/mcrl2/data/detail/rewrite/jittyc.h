@@ -35,15 +35,17 @@ typedef std::vector < sort_expression_list> sort_list_vector;
 
 ///
 /// \brief The normal_form_cache class stores normal forms of data_expressions that
-///        are inserted in it. By keeping the cache on the stack, the normal forms
-///        in it will not be freed by the ATerm library, and can therefore be used
-///        in the generated jittyc code.
+///        are inserted in it. The generated jittyc code refers to the stored terms by
+///        their position in the cache, and the addresses of the terms are only looked up
+///        when the rewriter is loaded. Therefore the generated code does not depend on
+///        the addresses of terms, and can be reused by later runs.
 ///
 class normal_form_cache
 {
   private:
     RewriterJitty& m_rewriter;
-    std::set<data_expression> m_lookup;
+    std::vector<data_expression> m_terms;
+    std::map<data_expression, std::size_t> m_indices;
   public:
     normal_form_cache(RewriterJitty& rewriter)
       : m_rewriter(rewriter)
@@ -60,20 +62,42 @@ class normal_form_cache
   ///
   std::string insert(const data_expression& t)
   {
-    std::stringstream ss;
     RewriterJitty::substitution_type sigma;
-    auto pair = m_lookup.insert(m_rewriter(t, sigma));
-    ss << "*reinterpret_cast<const data_expression*>(" << (void*)&(*pair.first) << ")";
+    return insert_term(m_rewriter(t, sigma));
+  }
+
+  ///
+  /// \brief insert_term stores t itself in the cache, and returns a C++ representation
+  ///        of t, similar to insert().
+  ///
+  std::string insert_term(const data_expression& t)
+  {
+    std::stringstream ss;
+    auto pair = m_indices.insert(std::make_pair(t, m_terms.size()));
+    if (pair.second)
+    {
+      m_terms.push_back(t);
+    }
+    ss << "constant(" << pair.first->second << ")";
     return ss.str();
   }
 
+  ///
+  /// \brief terms returns the stored terms, in the order in which the generated code refers to them.
+  ///
+  const std::vector<data_expression>& terms() const
+  {
+    return m_terms;
+  }
+
   ///
   /// \brief clear clears the cache. This operation invalidates all the C++ strings
   ///        obtained via the insert() method.
   ///
   void clear()
   {
-    m_lookup.clear();
+    m_terms.clear();
+    m_indices.clear();
   }
 };
 
@@ -129,6 +153,12 @@ class RewriterCompilingJitty: public Rewriter
     std::vector<rewriter_function> functions_when_arguments_are_not_in_normal_form;
     std::vector<rewriter_function> functions_when_arguments_are_in_normal_form;
 
+    // The terms that the compiled code refers to, which are resolved when the compiled code is loaded.
+    const std::vector<data_expression>& constants() const
+    {
+      return m_nf_cache.terms();
+    }
+
     // Standard assignment operator.
     RewriterCompilingJitty& operator=(const RewriterCompilingJitty& other)=delete;
 
@@ -142,7 +172,7 @@ class RewriterCompilingJitty: public Rewriter
     std::map<function_symbol, data_equation_list> jittyc_eqns;
     std::set<function_symbol> m_extra_symbols;
 
-    std::shared_ptr<uncompiled_library> rewriter_so;
+    std::shared_ptr<dynamic_library> rewriter_so;
     normal_form_cache m_nf_cache;
 
     void (*so_rewr_cleanup)();
@@ -155,7 +185,7 @@ class RewriterCompilingJitty: public Rewriter
     bool calc_nfs(const data_expression& t, variable_or_number_list nnfvars);
     void CleanupRewriteSystem();
     void BuildRewriteSystem();
-    void generate_code(const std::string& filename);
+    std::vector<std::string> generate_code();
     void generate_rewr_functions(std::ostream& s, const data::function_symbol& func, const data_equation_list& eqs);
     bool lift_rewrite_rule_to_right_arity(data_equation& e, const std::size_t requested_arity);
     sort_list_vector get_residual_sorts(const sort_expression& s, const std::size_t actual_arity, const std::size_t requested_arity);
@@ -15,6 +15,7 @@
 #include "mcrl2/utilities/toolset_version_const.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
+#include "mcrl2/data/detail/rewrite/machine_word_arithmetic.h"
 
 using namespace mcrl2::data::detail;
 using namespace mcrl2::data;
@@ -29,9 +30,13 @@ using atermpp::down_cast;
 #define DLLEXPORT
 #endif // _MSC_VER
 
+// The generated code can be split into several units that are compiled separately. Only the
+// first unit defines the interface of the library, the others define MCRL2_JITTYC_ADDITIONAL_UNIT.
+#ifndef MCRL2_JITTYC_ADDITIONAL_UNIT
 extern "C" {
   DLLEXPORT bool init(rewriter_interface* i, RewriterCompilingJitty* this_rewriter);
 }
+#endif
 
 // A rewrite_term is a term that may or may not be in normal form. If the method"
 // normal_form is invoked, it will calculate a normal form for itself as efficiently as possible."
@@ -49,7 +54,9 @@ static const data_expression& local_rewrite(const data_expression& t)
 //
 // Forward declarations
 //
+#ifndef MCRL2_JITTYC_ADDITIONAL_UNIT
 static void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter);
+#endif
 static data_expression rewrite_aux(const data_expression& t, const bool arguments_in_normal_form, RewriterCompilingJitty* this_rewriter);
 static inline data_expression rewrite_abstraction_aux(const abstraction& a, const data_expression& t, RewriterCompilingJitty* this_rewriter);
 static data_expression rewrite_with_arguments_in_normal_form(const data_expression& t, RewriterCompilingJitty* this_rewriter)
@@ -86,6 +93,34 @@ class term_not_in_normal_form
     }
 };
 
+// A term that may or may not be in normal form, of which the type is not known. It is used to pass
+// such terms to rewrite functions that are compiled in another unit, as the types of the terms cannot
+// be passed as template arguments between units. By invoking normal_form the normal form of
+// the term is calculated.
+class indirect_term
+{
+  protected:
+    const void* m_term;
+    data_expression (*m_normal_form)(const void*);
+
+    template <class REWRITE_TERM>
+    static data_expression normal_form_of(const void* t)
+    {
+      return local_rewrite(*static_cast<const REWRITE_TERM*>(t));
+    }
+
+  public:
+    template <class REWRITE_TERM>
+    explicit indirect_term(const REWRITE_TERM& t)
+      : m_term(&t), m_normal_form(&normal_form_of<REWRITE_TERM>)
+    {}
+
+    data_expression normal_form() const
+    {
+      return m_normal_form(m_term);
+    }
+};
+
 // This is an abstraction, of which the arguments are not yet
 // in normal form. This is done when the method "normal_form" is invoked.
 template <class TERM_TO_BE_REWRITTEN>
@@ -263,7 +298,7 @@ data_expression rewrite_appl_aux(const application& t, RewriterCompilingJitty* t
 }
 
 static inline
-data_expression rewrite_aux(const data_expression& t, const bool arguments_in_normal_form, RewriterCompilingJitty* this_rewriter)
+data_expression rewrite_aux_untagged(const data_expression& t, const bool arguments_in_normal_form, RewriterCompilingJitty* this_rewriter)
 {
   if (is_function_symbol(t))
   {
@@ -302,11 +337,6 @@ data_expression rewrite_aux(const data_expression& t, const bool arguments_in_no
     }
   }
   else
-  if (is_variable(t))
-  {
-    return sigma(this_rewriter)(down_cast<variable>(t));
-  }
-  else
   if (is_abstraction(t))
   {
     const abstraction& abstr(t);
@@ -333,6 +363,27 @@ data_expression rewrite_aux(const data_expression& t, const bool arguments_in_no
   }
 }
 
+// Rewrites t, and tags the result when it is a closed normal form such that it is not traversed again.
+static inline
+data_expression rewrite_aux(const data_expression& t, const bool arguments_in_normal_form, RewriterCompilingJitty* this_rewriter)
+{
+  const std::size_t tag=this_rewriter->normal_form_tag();
+  if (is_tagged_normal_form(t, tag))
+  {
+    return t;
+  }
+  if (is_variable(t))
+  {
+    // The value of a variable is not rewritten, so it is not tagged either.
+    return sigma(this_rewriter)(down_cast<variable>(t));
+  }
+
+  const data_expression result=rewrite_aux_untagged(t, arguments_in_normal_form, this_rewriter);
+  tag_normal_form(result, tag);
+  return result;
+}
+
+#ifndef MCRL2_JITTYC_ADDITIONAL_UNIT
 static
 void rewrite_cleanup()
 {
@@ -354,5 +405,6 @@ bool init(rewriter_interface* i, RewriterCompilingJitty* this_rewriter)
   i->status = "rewriter loaded successfully.";
   return true;
 }
+#endif // MCRL2_JITTYC_ADDITIONAL_UNIT
 
 #endif // __REWR_JITTYC_PREAMBLE_H
@@ -0,0 +1,484 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/machine_word_arithmetic.h
+/// \brief Built-in evaluation of arithmetic on numerals of sort Pos, Nat and Int that fit in a machine word.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_MACHINE_WORD_ARITHMETIC_H
+#define MCRL2_DATA_DETAIL_REWRITE_MACHINE_WORD_ARITHMETIC_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include "mcrl2/data/bool.h"
+#include "mcrl2/data/pos.h"
+#include "mcrl2/data/nat.h"
+#include "mcrl2/data/int.h"
+#include "mcrl2/data/standard.h"
+
+namespace mcrl2
+{
+namespace data
+{
+namespace detail
+{
+
+/// \brief The operations on Pos, Nat and Int that the rewriters can evaluate on machine words.
+enum class machine_word_operation : unsigned char
+{
+  none,
+  plus,
+  minus,
+  times,
+  div,
+  mod,
+  exp,
+  maximum,
+  minimum,
+  equal_to,
+  not_equal_to,
+  less,
+  less_equal,
+  greater,
+  greater_equal,
+  negate,
+  abs,
+  succ,
+  pred,
+  conversion
+};
+
+/// \brief The sorts of the arguments and results of a machine_word_operation.
+enum class machine_word_sort : unsigned char
+{
+  other,
+  bool_,
+  pos,
+  nat,
+  int_
+};
+
+inline std::string pp(const machine_word_operation op)
+{
+  switch (op)
+  {
+    case machine_word_operation::plus: return "plus";
+    case machine_word_operation::minus: return "minus";
+    case machine_word_operation::times: return "times";
+    case machine_word_operation::div: return "div";
+    case machine_word_operation::mod: return "mod";
+    case machine_word_operation::exp: return "exp";
+    case machine_word_operation::maximum: return "maximum";
+    case machine_word_operation::minimum: return "minimum";
+    case machine_word_operation::equal_to: return "equal_to";
+    case machine_word_operation::not_equal_to: return "not_equal_to";
+    case machine_word_operation::less: return "less";
+    case machine_word_operation::less_equal: return "less_equal";
+    case machine_word_operation::greater: return "greater";
+    case machine_word_operation::greater_equal: return "greater_equal";
+    case machine_word_operation::negate: return "negate";
+    case machine_word_operation::abs: return "abs";
+    case machine_word_operation::succ: return "succ";
+    case machine_word_operation::pred: return "pred";
+    case machine_word_operation::conversion: return "conversion";
+    default: return "none";
+  }
+}
+
+inline std::string pp(const machine_word_sort s)
+{
+  switch (s)
+  {
+    case machine_word_sort::bool_: return "bool_";
+    case machine_word_sort::pos: return "pos";
+    case machine_word_sort::nat: return "nat";
+    case machine_word_sort::int_: return "int_";
+    default: return "other";
+  }
+}
+
+inline machine_word_sort get_machine_word_sort(const sort_expression& s)
+{
+  if (s == sort_pos::pos())
+  {
+    return machine_word_sort::pos;
+  }
+  if (s == sort_nat::nat())
+  {
+    return machine_word_sort::nat;
+  }
+  if (s == sort_int::int_())
+  {
+    return machine_word_sort::int_;
+  }
+  if (s == sort_bool::bool_())
+  {
+    return machine_word_sort::bool_;
+  }
+  return machine_word_sort::other;
+}
+
+/// \brief The largest absolute value of a number that is evaluated on machine words.
+/// \details The range is symmetric, such that negation never overflows.
+static const std::int64_t machine_word_maximum = std::numeric_limits<std::int64_t>::max();
+
+/// \brief Obtains the value of a numeral of sort Pos, Nat or Int.
+/// \return False if t is not a numeral, or if its absolute value exceeds machine_word_maximum.
+inline bool get_machine_word_value(const data_expression& t, std::int64_t& value)
+{
+  const data_expression* n = &t;
+  bool negative = false;
+  if (is_application(*n))
+  {
+    const application& a = atermpp::down_cast<application>(*n);
+    if (a.head() == sort_int::cint())
+    {
+      n = &a[0];
+    }
+    else if (a.head() == sort_int::cneg())
+    {
+      n = &a[0];
+      negative = true;
+    }
+  }
+  if (*n == sort_nat::c0())
+  {
+    value = 0;
+    return !negative;
+  }
+  if (!negative && is_application(*n) && atermpp::down_cast<application>(*n).head() == sort_nat::cnat())
+  {
+    n = &atermpp::down_cast<application>(*n)[0];
+  }
+
+  // n is a positive number, in which @cDub(b,p) stands for 2p+b. The outermost @cDub is the least significant bit.
+  std::uint64_t bits = 0;
+  std::size_t depth = 0;
+  while (is_application(*n))
+  {
+    const application& a = atermpp::down_cast<application>(*n);
+    if (a.head() != sort_pos::cdub() || depth == 62)
+    {
+      return false;
+    }
+    if (a[0] == sort_bool::true_())
+    {
+      bits |= std::uint64_t(1) << depth;
+    }
+    else if (a[0] != sort_bool::false_())
+    {
+      return false;
+    }
+    ++depth;
+    n = &a[1];
+  }
+  if (*n != sort_pos::c1())
+  {
+    return false;
+  }
+  const std::int64_t magnitude = static_cast<std::int64_t>(bits | (std::uint64_t(1) << depth));
+  value = negative ? -magnitude : magnitude;
+  return true;
+}
+
+/// \brief Constructs the numeral of sort Pos for value, which must be positive.
+inline data_expression machine_word_pos(const std::uint64_t value)
+{
+  assert(value > 0);
+  std::size_t depth = 0;
+  while ((value >> depth) > 1)
+  {
+    ++depth;
+  }
+  data_expression result = sort_pos::c1();
+  while (depth > 0)
+  {
+    --depth;
+    result = sort_pos::cdub((((value >> depth) & 1) != 0 ? sort_bool::true_() : sort_bool::false_()), result);
+  }
+  return result;
+}
+
+/// \brief Constructs the numeral of sort s for value.
+/// \return False if value does not belong to the sort s.
+inline bool make_machine_word_numeral(const machine_word_sort s, const std::int64_t value, data_expression& result)
+{
+  switch (s)
+  {
+    case machine_word_sort::pos:
+      if (value <= 0)
+      {
+        return false;
+      }
+      result = machine_word_pos(static_cast<std::uint64_t>(value));
+      return true;
+    case machine_word_sort::nat:
+      if (value < 0)
+      {
+        return false;
+      }
+      result = (value == 0 ? data_expression(sort_nat::c0()) : data_expression(sort_nat::cnat(machine_word_pos(static_cast<std::uint64_t>(value)))));
+      return true;
+    case machine_word_sort::int_:
+      if (value < 0)
+      {
+        result = sort_int::cneg(machine_word_pos(static_cast<std::uint64_t>(-value)));
+      }
+      else
+      {
+        result = sort_int::cint(value == 0 ? data_expression(sort_nat::c0()) : data_expression(sort_nat::cnat(machine_word_pos(static_cast<std::uint64_t>(value)))));
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Adds x and y, and returns false on overflow.
+inline bool machine_word_plus(const std::int64_t x, const std::int64_t y, std::int64_t& result)
+{
+  if ((y > 0 && x > machine_word_maximum - y) || (y < 0 && x < -machine_word_maximum - y))
+  {
+    return false;
+  }
+  result = x + y;
+  return true;
+}
+
+/// \brief Multiplies x and y, and returns false on overflow.
+inline bool machine_word_times(const std::int64_t x, const std::int64_t y, std::int64_t& result)
+{
+  if (x == 0 || y == 0)
+  {
+    result = 0;
+    return true;
+  }
+  const std::int64_t abs_x = (x < 0 ? -x : x);
+  const std::int64_t abs_y = (y < 0 ? -y : y);
+  if (abs_x > machine_word_maximum / abs_y)
+  {
+    return false;
+  }
+  result = x * y;
+  return true;
+}
+
+/// \brief A function symbol of which applications to numerals can be evaluated on machine words.
+/// \details Applications are only evaluated when all arguments are numerals whose absolute values
+///          fit in a machine word, and when the result fits as well. In all other cases the rewriter must
+///          use the rewrite rules, which gives the same result, as the numerals are unique normal forms.
+class machine_word_function
+{
+  protected:
+    machine_word_operation m_operation;
+    machine_word_sort m_result_sort;
+
+    bool evaluate(const std::int64_t x, std::int64_t& result) const
+    {
+      switch (m_operation)
+      {
+        case machine_word_operation::negate: result = -x; return true;
+        case machine_word_operation::abs: result = (x < 0 ? -x : x); return true;
+        case machine_word_operation::succ: return machine_word_plus(x, 1, result);
+        case machine_word_operation::pred: return machine_word_plus(x, -1, result);
+        case machine_word_operation::conversion: result = x; return true;
+        default: return false;
+      }
+    }
+
+    bool evaluate(const std::int64_t x, const std::int64_t y, std::int64_t& result) const
+    {
+      switch (m_operation)
+      {
+        case machine_word_operation::plus: return machine_word_plus(x, y, result);
+        case machine_word_operation::minus: return machine_word_plus(x, -y, result);
+        case machine_word_operation::times: return machine_word_times(x, y, result);
+        case machine_word_operation::div:
+        case machine_word_operation::mod:
+        {
+          // The divisor is of sort Pos, and the quotient is rounded towards minus infinity.
+          if (y <= 0)
+          {
+            return false;
+          }
+          std::int64_t quotient = x / y;
+          if (x % y < 0)
+          {
+            --quotient;
+          }
+          result = (m_operation == machine_word_operation::div ? quotient : x - quotient * y);
+          return true;
+        }
+        case machine_word_operation::exp:
+        {
+          if (y < 0)
+          {
+            return false;
+          }
+          std::int64_t base = x;
+          std::int64_t exponent = y;
+          result = 1;
+          while (exponent > 0)
+          {
+            if ((exponent & 1) != 0 && !machine_word_times(result, base, result))
+            {
+              return false;
+            }
+            exponent >>= 1;
+            if (exponent > 0 && !machine_word_times(base, base, base))
+            {
+              return false;
+            }
+          }
+          return true;
+        }
+        case machine_word_operation::maximum: result = (x < y ? y : x); return true;
+        case machine_word_operation::minimum: result = (x < y ? x : y); return true;
+        case machine_word_operation::equal_to: result = (x == y); return true;
+        case machine_word_operation::not_equal_to: result = (x != y); return true;
+        case machine_word_operation::less: result = (x < y); return true;
+        case machine_word_operation::less_equal: result = (x <= y); return true;
+        case machine_word_operation::greater: result = (x > y); return true;
+        case machine_word_operation::greater_equal: result = (x >= y); return true;
+        default: return false;
+      }
+    }
+
+    bool make_result(const std::int64_t value, data_expression& result) const
+    {
+      if (m_result_sort == machine_word_sort::bool_)
+      {
+        result = (value != 0 ? sort_bool::true_() : sort_bool::false_());
+        return true;
+      }
+      return make_machine_word_numeral(m_result_sort, value, result);
+    }
+
+    static machine_word_operation get_operation(const function_symbol& f, const std::size_t arity)
+    {
+      const core::identifier_string& name = f.name();
+      if (arity == 2)
+      {
+        if (name == sort_nat::plus_name()) { return machine_word_operation::plus; }
+        if (name == sort_int::minus_name()) { return machine_word_operation::minus; }
+        if (name == sort_nat::times_name()) { return machine_word_operation::times; }
+        if (name == sort_nat::div_name()) { return machine_word_operation::div; }
+        if (name == sort_nat::mod_name()) { return machine_word_operation::mod; }
+        if (name == sort_nat::exp_name()) { return machine_word_operation::exp; }
+        if (name == sort_nat::maximum_name()) { return machine_word_operation::maximum; }
+        if (name == sort_nat::minimum_name()) { return machine_word_operation::minimum; }
+        if (is_equal_to_function_symbol(f)) { return machine_word_operation::equal_to; }
+        if (is_not_equal_to_function_symbol(f)) { return machine_word_operation::not_equal_to; }
+        if (is_less_function_symbol(f)) { return machine_word_operation::less; }
+        if (is_less_equal_function_symbol(f)) { return machine_word_operation::less_equal; }
+        if (is_greater_function_symbol(f)) { return machine_word_operation::greater; }
+        if (is_greater_equal_function_symbol(f)) { return machine_word_operation::greater_equal; }
+      }
+      else if (arity == 1)
+      {
+        if (name == sort_int::negate_name()) { return machine_word_operation::negate; }
+        if (name == sort_int::abs_name()) { return machine_word_operation::abs; }
+        if (name == sort_nat::succ_name()) { return machine_word_operation::succ; }
+        if (name == sort_nat::pred_name()) { return machine_word_operation::pred; }
+        if (name == sort_nat::pos2nat_name() || name == sort_nat::nat2pos_name() ||
+            name == sort_int::pos2int_name() || name == sort_int::int2pos_name() ||
+            name == sort_int::nat2int_name() || name == sort_int::int2nat_name())
+        {
+          return machine_word_operation::conversion;
+        }
+      }
+      return machine_word_operation::none;
+    }
+
+  public:
+    machine_word_function(const machine_word_operation operation = machine_word_operation::none,
+                          const machine_word_sort result_sort = machine_word_sort::other)
+      : m_operation(operation), m_result_sort(result_sort)
+    {}
+
+    /// \brief The machine word function for f, which is undefined if applications of f cannot be evaluated.
+    explicit machine_word_function(const function_symbol& f)
+      : m_operation(machine_word_operation::none), m_result_sort(machine_word_sort::other)
+    {
+      if (!is_function_sort(f.sort()))
+      {
+        return;
+      }
+      const function_sort& s = atermpp::down_cast<function_sort>(f.sort());
+      for (const sort_expression& argument_sort: s.domain())
+      {
+        const machine_word_sort argument = get_machine_word_sort(argument_sort);
+        if (argument == machine_word_sort::other || argument == machine_word_sort::bool_)
+        {
+          return;
+        }
+      }
+      const machine_word_operation operation = get_operation(f, s.domain().size());
+      const machine_word_sort result_sort = get_machine_word_sort(s.codomain());
+      const bool is_comparison = (machine_word_operation::equal_to <= operation && operation <= machine_word_operation::greater_equal);
+      if (operation == machine_word_operation::none ||
+          result_sort == machine_word_sort::other ||
+          (result_sort == machine_word_sort::bool_) != is_comparison)
+      {
+        return;
+      }
+      m_operation = operation;
+      m_result_sort = result_sort;
+    }
+
+    bool is_defined() const
+    {
+      return m_operation != machine_word_operation::none;
+    }
+
+    machine_word_operation operation() const
+    {
+      return m_operation;
+    }
+
+    machine_word_sort result_sort() const
+    {
+      return m_result_sort;
+    }
+
+    /// \brief The number of arguments of the function.
+    std::size_t arity() const
+    {
+      return machine_word_operation::negate <= m_operation ? 1 : 2;
+    }
+
+    /// \brief Evaluates the function applied to x.
+    /// \return False if the application cannot be evaluated on machine words, in which case result is unchanged.
+    bool apply(const data_expression& x, data_expression& result) const
+    {
+      std::int64_t x_value;
+      std::int64_t value;
+      return get_machine_word_value(x, x_value) &&
+             evaluate(x_value, value) &&
+             make_result(value, result);
+    }
+
+    /// \brief Evaluates the function applied to x and y.
+    /// \return False if the application cannot be evaluated on machine words, in which case result is unchanged.
+    bool apply(const data_expression& x, const data_expression& y, data_expression& result) const
+    {
+      std::int64_t x_value;
+      std::int64_t y_value;
+      std::int64_t value;
+      return get_machine_word_value(x, x_value) &&
+             get_machine_word_value(y, y_value) &&
+             evaluate(x_value, y_value, value) &&
+             make_result(value, result);
+    }
+};
+
+} // namespace detail
+} // namespace data
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_MACHINE_WORD_ARITHMETIC_H
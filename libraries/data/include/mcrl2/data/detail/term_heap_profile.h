@@ -0,0 +1,84 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/term_heap_profile.h
+/// \brief Profiles the terms in the term pool by the sort of data expressions.
+
+#ifndef MCRL2_DATA_DETAIL_TERM_HEAP_PROFILE_H
+#define MCRL2_DATA_DETAIL_TERM_HEAP_PROFILE_H
+
+#include "mcrl2/atermpp/detail/global_aterm_pool.h"
+#include "mcrl2/data/data_expression.h"
+#include "mcrl2/data/function_sort.h"
+
+namespace mcrl2
+{
+
+namespace data
+{
+
+namespace detail
+{
+
+/// \returns The sort of the given term when it is a variable, function symbol or application of these,
+///          and the undefined term otherwise.
+/// \details Unlike data_expression::sort() this never creates terms, which is required during heap profiling,
+///          and it also accepts terms that are not well-typed data expressions.
+inline atermpp::aterm data_expression_sort_key(const atermpp::aterm& term)
+{
+  if (!term.type_is_appl())
+  {
+    return atermpp::aterm();
+  }
+
+  // Find the head of nested applications h(...)(...).
+  atermpp::aterm_appl head = atermpp::down_cast<atermpp::aterm_appl>(term);
+  std::size_t number_of_applications = 0;
+  while (is_application(head))
+  {
+    if (!head[0].type_is_appl())
+    {
+      return atermpp::aterm();
+    }
+    head = atermpp::down_cast<atermpp::aterm_appl>(head[0]);
+    ++number_of_applications;
+  }
+
+  if (!is_variable(head) && !is_function_symbol(head))
+  {
+    return atermpp::aterm();
+  }
+
+  atermpp::aterm sort = head[1];
+  for (std::size_t i = 0; i < number_of_applications; ++i)
+  {
+    if (!sort.type_is_appl() || !is_function_sort(atermpp::down_cast<atermpp::aterm_appl>(sort)))
+    {
+      return atermpp::aterm();
+    }
+    sort = atermpp::down_cast<function_sort>(sort).codomain();
+  }
+
+  return sort;
+}
+
+/// \returns A histogram of the terms in the term pool by the sort of the data expressions that they represent.
+/// \details Terms that are not variables, function symbols or applications are grouped as "other".
+inline atermpp::term_heap_profile data_sort_heap_profile()
+{
+  return atermpp::detail::g_term_pool().heap_profile(data_expression_sort_key,
+    [](const atermpp::aterm& sort) { return data::pp(atermpp::down_cast<sort_expression>(sort)); });
+}
+
+} // namespace detail
+
+} // namespace data
+
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_TERM_HEAP_PROFILE_H
@@ -15,15 +15,19 @@
 #include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/data/detail/enumerator_identifier_generator.h"
 #include "mcrl2/data/detail/enumerator_variable_limit.h"
+#include "mcrl2/data/find.h"
 #include "mcrl2/data/identifier_generator.h"
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/data/substitutions/enumerator_substitution.h"
 #include "mcrl2/data/substitutions/mutable_indexed_substitution.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
 #include "mcrl2/utilities/math.h"
+#include "mcrl2/utilities/trace.h"
 #include <boost/iterator/iterator_facade.hpp>
 #include <deque>
 #include <limits>
 #include <map>
+#include <set>
 #include <sstream>
 #include <utility>
 
@@ -469,6 +473,206 @@ class enumerator_queue
     }
 };
 
+namespace detail {
+
+/// \brief Computes the free variables of a data expression, for the enumerator solution cache.
+struct find_free_data_variables
+{
+  std::set<data::variable> operator()(const data::data_expression& x) const
+  {
+    return data::find_free_variables(x);
+  }
+};
+
+} // namespace detail
+
+/// \brief The outcome of an enumeration as stored in an enumerator_solution_cache.
+template <typename EnumeratorListElement>
+struct enumerator_cache_entry
+{
+  /// \brief The reported solutions, in the order in which they were reported.
+  std::vector<EnumeratorListElement> solutions;
+
+  /// \brief The free variables of the enumerated expression that are not enumerated.
+  data::variable_list context_variables;
+
+  /// \brief The values that the substitution assigned to the context variables.
+  data::data_expression_list context_values;
+
+  /// \brief True if the last reported solution interrupted the enumeration.
+  bool interrupted = false;
+
+  /// \brief The number of elements that have been processed by the enumeration.
+  std::size_t count = 0;
+};
+
+// Estimates the number of bytes occupied by a cached enumeration. The terms are shared with other terms,
+// so only the vector of solutions and the list cells of the context are taken into account.
+template <typename EnumeratorListElement>
+struct enumerator_cache_entry_size
+{
+  std::size_t operator()(const atermpp::aterm_appl&, const enumerator_cache_entry<EnumeratorListElement>& entry) const
+  {
+    // A list cell consists of a header, a head and a tail.
+    constexpr std::size_t list_cell_size = 3 * sizeof(atermpp::aterm);
+    return sizeof(atermpp::aterm_appl) + sizeof(entry)
+           + entry.solutions.size() * sizeof(EnumeratorListElement)
+           + 2 * entry.context_variables.size() * list_cell_size;
+  }
+};
+
+/// \brief A bounded cache of complete solution lists of the enumerator, keyed on the variables and the expression
+/// of the enumerated element. It evicts the least recently used entries.
+/// \details An entry is only reused if the substitution assigns the same values to the free variables of the
+/// expression that are not enumerated. If these values differ from the ones of the first entry of an element,
+/// the values are added to the key. Enumerations that report solutions with unbound variables, or that are
+/// aborted because the maximum number of iterations is reached, are not cached.
+/// Since reject and accept influence the solutions, a cache should only be used with a single pair of them.
+/// \param FindFreeVariables A function object that computes the free variables of an expression.
+template <typename EnumeratorListElement, typename FindFreeVariables = detail::find_free_data_variables>
+class enumerator_solution_cache
+{
+  public:
+    typedef enumerator_cache_entry<EnumeratorListElement> entry_type;
+
+  protected:
+    typedef utilities::lru_cache<atermpp::aterm_appl, entry_type, enumerator_cache_entry_size<EnumeratorListElement>> cache_type;
+
+    bool m_enabled;
+    cache_type m_cache;
+    atermpp::function_symbol m_key_symbol;
+    atermpp::function_symbol m_context_key_symbol;
+    FindFreeVariables m_find_free_variables;
+    utilities::cache_metric m_metrics;
+
+    template <typename Expression>
+    bool is_closed(const enumerator_list_element<Expression>& q) const
+    {
+      if (q.variables().empty())
+      {
+        return true;
+      }
+      std::set<data::variable> free_variables = m_find_free_variables(q.expression());
+      return std::none_of(q.variables().begin(), q.variables().end(), [&](const data::variable& v) { return free_variables.count(v) > 0; });
+    }
+
+    // The assignments of an element with unbound variables refer to fresh variables.
+    template <typename Expression>
+    bool is_closed(const enumerator_list_element_with_substitution<Expression>& q) const
+    {
+      return q.variables().empty();
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param max_size The maximum number of cached enumerations, where zero disables the cache.
+    /// \param memory_budget The maximum number of bytes occupied by the cached enumerations, where zero means unbounded.
+    explicit enumerator_solution_cache(std::size_t max_size = 0, std::size_t memory_budget = 0)
+      : m_enabled(max_size > 0),
+        m_cache(max_size, memory_budget),
+        m_key_symbol("@enumerator_cache_key", 2),
+        m_context_key_symbol("@enumerator_cache_key", 3)
+    {}
+
+    /// \brief Returns true if enumerations are cached.
+    bool enabled() const
+    {
+      return m_enabled;
+    }
+
+    /// \brief Searches the enumeration of the element p under the substitution sigma.
+    /// \param key Is set to the key under which the enumeration should be inserted if it is not present.
+    /// \return A pointer to the entry, or nullptr if it is not present.
+    template <typename MutableSubstitution>
+    const entry_type* find(const EnumeratorListElement& p, MutableSubstitution& sigma, atermpp::aterm_appl& key)
+    {
+      key = atermpp::aterm_appl(m_key_symbol, p.variables(), p.expression());
+      auto i = m_cache.find(key);
+      if (i != m_cache.end())
+      {
+        const entry_type* entry = &i->second;
+        auto value = entry->context_values.begin();
+        bool same_context = std::all_of(entry->context_variables.begin(), entry->context_variables.end(),
+                                        [&](const data::variable& x) { return sigma(x) == *value++; });
+        if (!same_context)
+        {
+          // The context variables only depend on p, so they can be taken from the entry.
+          data::data_expression_list values(entry->context_variables.begin(), entry->context_variables.end(), [&](const data::variable& x) { return sigma(x); });
+          key = atermpp::aterm_appl(m_context_key_symbol, p.variables(), p.expression(), values);
+          i = m_cache.find(key);
+          entry = i == m_cache.end() ? nullptr : &i->second;
+        }
+        if (entry != nullptr)
+        {
+          m_metrics.hit();
+          return entry;
+        }
+      }
+      m_metrics.miss();
+      return nullptr;
+    }
+
+    /// \brief Creates an entry for the element p, and records the values of its context in sigma.
+    template <typename MutableSubstitution>
+    entry_type make_entry(const EnumeratorListElement& p, MutableSubstitution& sigma) const
+    {
+      entry_type result;
+      std::vector<data::variable> context;
+      for (const data::variable& x: m_find_free_variables(p.expression()))
+      {
+        if (std::find(p.variables().begin(), p.variables().end(), x) == p.variables().end())
+        {
+          context.push_back(x);
+        }
+      }
+      result.context_variables = data::variable_list(context.begin(), context.end());
+      result.context_values = data::data_expression_list(context.begin(), context.end(), [&](const data::variable& x) { return sigma(x); });
+      return result;
+    }
+
+    /// \brief Adds the solution q to the entry. Returns false if q cannot be cached.
+    bool add_solution(entry_type& entry, const EnumeratorListElement& q) const
+    {
+      if (!is_closed(q))
+      {
+        return false;
+      }
+      entry.solutions.push_back(q);
+      return true;
+    }
+
+    /// \brief Stores the entry under the given key.
+    void insert(const atermpp::aterm_appl& key, const entry_type& entry)
+    {
+      std::size_t size = m_cache.size();
+      if (m_cache.emplace(key, entry).second)
+      {
+        for (std::size_t i = m_cache.size(); i <= size; i++)
+        {
+          m_metrics.evict();
+        }
+      }
+    }
+
+    /// \brief Removes all cached enumerations. The counters are kept.
+    void clear()
+    {
+      m_cache.clear();
+    }
+
+    /// \brief Returns the number of cached enumerations.
+    std::size_t size() const
+    {
+      return m_cache.size();
+    }
+
+    /// \returns The number of hits, misses and evictions of this cache.
+    const utilities::cache_metric& metrics() const
+    {
+      return m_metrics;
+    }
+};
+
 /// \brief An enumerator algorithm that generates solutions of a condition.
 template <typename Rewriter = data::rewriter, typename DataRewriter = data::rewriter>
 class enumerator_algorithm
@@ -792,6 +996,7 @@ class enumerator_algorithm
                               Accept accept = Accept()
     ) const
     {
+      utilities::trace_span span("enumerate", "enumerator");
       std::size_t count = 0;
       while (!P.empty())
       {
@@ -837,6 +1042,95 @@ class enumerator_algorithm
       return enumerate_all(P, sigma, report_solution, reject, accept);
     }
 
+    /// \brief Enumerates the element p like enumerate, but reuses the solutions that are stored in a cache.
+    /// \param cache A cache of enumerations. It should only be used with the same reject and accept functions.
+    /// \param p An enumerator element, i.e. an expression with a list of variables. The element should not
+    /// contain any assignments, since only its variables and expression are used as a key.
+    /// \param sigma A substitution.
+    /// \param reject Elements p for which reject(p) is true are discarded.
+    /// \param accept Elements p for which accept(p) is true are reported as a solution, even if the list of variables of the enumerator element is non-empty.
+    /// \param report_solution A callback function that is called whenever a solution is found.
+    /// If report_solution returns true, the enumeration is interrupted.
+    /// \return The number of elements that have been processed
+    template <typename EnumeratorListElement,
+              typename FindFreeVariables,
+              typename MutableSubstitution,
+              typename ReportSolution,
+              typename Reject = always_false<typename EnumeratorListElement::expression_type>,
+              typename Accept = always_false<typename EnumeratorListElement::expression_type>
+    >
+    std::size_t enumerate(enumerator_solution_cache<EnumeratorListElement, FindFreeVariables>& cache,
+                          const EnumeratorListElement& p,
+                          MutableSubstitution& sigma,
+                          ReportSolution report_solution,
+                          Reject reject = Reject(),
+                          Accept accept = Accept()
+    ) const
+    {
+      typedef typename enumerator_solution_cache<EnumeratorListElement, FindFreeVariables>::entry_type entry_type;
+
+      if (!cache.enabled())
+      {
+        return enumerate(p, sigma, report_solution, reject, accept);
+      }
+
+      atermpp::aterm_appl key;
+      const entry_type* cached_entry = cache.find(p, sigma, key);
+      if (cached_entry != nullptr)
+      {
+        // The solutions are copied, as the entry can be evicted by enumerations in report_solution.
+        const std::vector<EnumeratorListElement> solutions = cached_entry->solutions;
+        const bool interrupted = cached_entry->interrupted;
+        const std::size_t count = cached_entry->count;
+        for (const EnumeratorListElement& q: solutions)
+        {
+          if (report_solution(q))
+          {
+            return count;
+          }
+        }
+        if (!interrupted)
+        {
+          return count;
+        }
+
+        // The enumeration was interrupted before, but not this time. It is repeated, and the solutions that
+        // have already been reported are skipped. This relies on the enumeration order being deterministic.
+        std::size_t skip = solutions.size();
+        return enumerate(p, sigma,
+                         [&](const EnumeratorListElement& q)
+                         {
+                           if (skip > 0)
+                           {
+                             skip--;
+                             return false;
+                           }
+                           return report_solution(q);
+                         },
+                         reject,
+                         accept
+                        );
+      }
+
+      entry_type entry = cache.make_entry(p, sigma);
+      bool cacheable = true;
+      entry.count = enumerate(p, sigma,
+                              [&](const EnumeratorListElement& q)
+                              {
+                                cacheable = cacheable && cache.add_solution(entry, q);
+                                entry.interrupted = report_solution(q);
+                                return entry.interrupted;
+                              },
+                              reject,
+                              accept
+                             );
+      if (cacheable && entry.count <= m_max_count)
+      {
+        cache.insert(key, entry);
+      }
+      return entry.count;
+    }
+
     std::size_t max_count() const
     {
       return m_max_count;
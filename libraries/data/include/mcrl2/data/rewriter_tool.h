@@ -44,6 +44,7 @@ class rewriter_tool: public Tool
       desc.add_option(
         "rewriter", utilities::make_enum_argument<data::rewrite_strategy>("NAME")
             .add_value(data::jitty, true)
+            .add_value(data::jitty_bytecode)
 #ifdef MCRL2_JITTYC_AVAILABLE
             .add_value(data::jitty_compiling)
 #endif
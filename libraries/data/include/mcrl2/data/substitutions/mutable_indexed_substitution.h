@@ -7,16 +7,7 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 //
 /// \file mcrl2/data/substitutions/mutable_indexed_substitution.h
-/// \brief add your file description here.
-
-// The code below contains an experiment to replace the classical mutable_indexed_substitution
-// by a std::unordered_map from variables to expressions. This is up to 1.5 times 
-// slower in most state space generations when there are not too many variables, which is
-// typical for state space generation without complex sum operations or quantifiers.
-// When a large number of variables exist, generally generated as fresh variables,
-// std::unordered_map can perform much better, leading to the time to generate a 
-// state space with a factor 2. 
-
+/// \brief A substitution that stores its assignments in a vector or a hash table, depending on the variables.
 
 #ifndef MCRL2_DATA_SUBSTITUTIONS_MUTABLE_INDEXED_SUBSTITUTION_H
 #define MCRL2_DATA_SUBSTITUTIONS_MUTABLE_INDEXED_SUBSTITUTION_H
@@ -26,8 +17,11 @@
 #include "mcrl2/utilities/exception.h"
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 namespace mcrl2 {
 
@@ -35,31 +29,142 @@ namespace data {
 
 /// \brief Generic substitution function.
 /// \details This substitution assumes a function variable -> std::size_t, that, for
-///          each variable gives a unique index. The substitutions are stored
-///          internally as a vector, mapping std::size_t to expression.
-///          Provided that, given a variable, its index can be computed in O(1)
-///          time, insertion is O(1) amortized, and lookup is O(1).
-///          Memory required is O(n) where n is the largest index used.
+///          each variable gives a unique index. The assignments are stored in a
+///          vector, and the position of the assignment of a variable is looked up
+///          through its index.
+///            As long as the indices of the assigned variables are small, or not much
+///          larger than the number of assignments, the positions are kept in a
+///          vector indexed by the variable index. Lookup and insertion are then O(1),
+///          and memory is O(n) where n is the largest index used. When variables
+///          with widely spread indices are assigned, typically fresh variables that
+///          are introduced for sums and quantifiers, the positions are kept in a hash
+///          table instead. Its size is proportional to the number of assignments. The
+///          substitution returns to the vector when it is cleared.
 ///            This substitution can maintain the variables occurring in the rhs of
-///          expressions. If it is requested that whether a variable occurs in a rhs, 
-///          the substitution automatically maintains these variables. This requires
-///          time O(n log n) per rhs, where n is the size of the rhs. 
+///          expressions. If it is requested that whether a variable occurs in a rhs,
+///          the substitution automatically maintains the number of occurrences of
+///          these variables. This requires time O(n) per rhs, where n is the size
+///          of the rhs, and no time for closed normal forms.
 template <typename VariableType = data::variable, typename ExpressionType = data_expression >
 class mutable_indexed_substitution : public std::unary_function<VariableType, ExpressionType>
 {
 protected:
   typedef std::pair <VariableType, ExpressionType> substitution_type;
+
+  /// \brief The index table can always grow up to this size.
+  static const std::size_t dense_index_table_size = 1024;
+
+  /// \brief Beyond dense_index_table_size the index table is only grown when it has at most
+  ///        this many entries per assigned variable. Otherwise a hash table is used.
+  static const std::size_t dense_index_table_spread = 16;
+
   /// \brief Internal storage for substitutions.
   /// Required to be a container with random access through [] operator.
   /// It is essential to store the variable also in the container, as it might be that
   /// this variable is not used anywhere although it has a valid assignment. This happens
   /// for instance when the assignment is already parsed, while the expression to which it
-  /// needs to be applied must still be parsed. 
+  /// needs to be applied must still be parsed.
   std::vector < substitution_type > m_container;
   std::vector <std::size_t> m_index_table;
+  std::unordered_map <std::size_t, std::size_t> m_sparse_index_table;
+  bool m_index_table_is_sparse;
   std::stack<std::size_t> m_free_positions;
   bool m_variables_in_rhs_set_is_defined;
-  std::multiset<variable> m_variables_in_rhs;
+  /// \brief The number of occurrences of variables, by index, in the right hand sides.
+  std::unordered_map<std::size_t, std::size_t> m_variables_in_rhs;
+  std::vector<VariableType> m_scratch_variables;
+
+  static std::size_t index(const VariableType& v)
+  {
+    return core::index_traits<data::variable, data::variable_key_type, 2>::index(v);
+  }
+
+  /// \brief The position of the assignment of the variable with index i in m_container,
+  ///        or std::size_t(-1) if the variable is not assigned.
+  std::size_t position(const std::size_t i) const
+  {
+    if (m_index_table_is_sparse)
+    {
+      const std::unordered_map<std::size_t, std::size_t>::const_iterator j = m_sparse_index_table.find(i);
+      return j == m_sparse_index_table.end() ? std::size_t(-1) : j->second;
+    }
+    return i < m_index_table.size() ? m_index_table[i] : std::size_t(-1);
+  }
+
+  void set_position(const std::size_t i, const std::size_t j)
+  {
+    if (!m_index_table_is_sparse && i >= m_index_table.size())
+    {
+      if (i < dense_index_table_size || i < dense_index_table_spread * (size() + 1))
+      {
+        m_index_table.resize(i + 1, std::size_t(-1));
+      }
+      else
+      {
+        // Move the positions of the assigned variables to the hash table. The index table
+        // is left empty, such that it can be used again after clear().
+        for (std::size_t k = 0; k < m_container.size(); ++k)
+        {
+          const std::size_t l = index(m_container[k].first);
+          if (l < m_index_table.size() && m_index_table[l] == k)
+          {
+            m_sparse_index_table[l] = k;
+            m_index_table[l] = std::size_t(-1);
+          }
+        }
+        m_index_table_is_sparse = true;
+      }
+    }
+
+    if (m_index_table_is_sparse)
+    {
+      m_sparse_index_table[i] = j;
+    }
+    else
+    {
+      m_index_table[i] = j;
+    }
+  }
+
+  void erase_position(const std::size_t i)
+  {
+    if (m_index_table_is_sparse)
+    {
+      m_sparse_index_table.erase(i);
+    }
+    else
+    {
+      m_index_table[i] = std::size_t(-1);
+    }
+  }
+
+  /// \brief Adds the free variables of e to, or removes them from, the variables in the right hand sides.
+  void update_variables_in_rhs(const ExpressionType& e, const bool add)
+  {
+    // Closed normal forms are tagged by the rewriters, and have no free variables.
+    if (atermpp::detail::address(e)->normal_form_tag() != 0)
+    {
+      return;
+    }
+    m_scratch_variables.clear();
+    find_free_variables(e, std::back_inserter(m_scratch_variables));
+    for (const VariableType& v: m_scratch_variables)
+    {
+      if (add)
+      {
+        m_variables_in_rhs[index(v)]++;
+      }
+      else
+      {
+        const std::unordered_map<std::size_t, std::size_t>::iterator i = m_variables_in_rhs.find(index(v));
+        assert(i != m_variables_in_rhs.end() && i->second > 0);
+        if (--i->second == 0)
+        {
+          m_variables_in_rhs.erase(i);
+        }
+      }
+    }
+  }
 
 public:
 
@@ -71,7 +176,8 @@ public:
 
   /// \brief Default constructor
   mutable_indexed_substitution()
-    : m_variables_in_rhs_set_is_defined(false)
+    : m_index_table_is_sparse(false),
+      m_variables_in_rhs_set_is_defined(false)
   {
   }
 
@@ -84,7 +190,7 @@ public:
     /// \brief Constructor.
     /// \param[in] v a variable.
     /// \param[in] super A reference to the surrounding indexed substitution.
-    assignment(const variable_type& v, 
+    assignment(const variable_type& v,
                mutable_indexed_substitution < VariableType, ExpressionType >& super)
      : m_variable(v),
        m_super(super)
@@ -95,37 +201,30 @@ public:
     {
       assert(e.defined());
 
-      std::size_t i = core::index_traits<data::variable, data::variable_key_type, 2>::index(m_variable);
+      const std::size_t i = m_super.index(m_variable);
+      std::size_t j = m_super.position(i);
+      assert(j==std::size_t(-1) || j<m_super.m_container.size());
 
       if (e != m_variable)
       {
         // Set a new variable;
         if (m_super.m_variables_in_rhs_set_is_defined)
         {
-          std::set<variable_type> s=find_free_variables(e);
-          m_super.m_variables_in_rhs.insert(s.begin(),s.end());
-        }
-
-        // Resize container if needed
-        if (i >= m_super.m_index_table.size())
-        {
-          m_super.m_index_table.resize(i+1, std::size_t(-1));
+          m_super.update_variables_in_rhs(e, true);
         }
 
-        std::size_t j=m_super.m_index_table[i];
-        assert(j==std::size_t(-1) || j<m_super.m_container.size());
         if (j==std::size_t(-1))
         {
           // The variable was not assigned.
           if (m_super.m_free_positions.empty())
           {
-            m_super.m_index_table[i]=m_super.m_container.size();
+            m_super.set_position(i, m_super.m_container.size());
             m_super.m_container.push_back(substitution_type(m_variable,e));
           }
           else
           {
             j=m_super.m_free_positions.top();
-            m_super.m_index_table[i]=j;
+            m_super.set_position(i, j);
             m_super.m_container[j]=substitution_type(m_variable,e);
             m_super.m_free_positions.pop();
           }
@@ -133,53 +232,33 @@ public:
         else
         {
           // The variable was already assigned. Replace the assignment.
-          // Clear the variables of the removed variable. 
+          // Clear the variables of the removed variable.
           if (m_super.m_variables_in_rhs_set_is_defined)
           {
-            std::set<variable_type> s=find_free_variables(m_super.m_container[j].second);
-            for(const variable& v:s) 
-            { 
-              // Remove one occurrence of v. 
-              const std::multiset<variable>::const_iterator i=m_super.m_variables_in_rhs.find(v);
-              m_super.m_variables_in_rhs.erase(i);
-            }
+            m_super.update_variables_in_rhs(m_super.m_container[j].second, false);
           }
 
           m_super.m_container[j]=substitution_type(m_variable,e);
         }
       }
-      else
+      else if (j!=std::size_t(-1))
       {
         // Indicate that the current variable is free; postpone deleting the
-        // actual value assigned to the variable, except if m_variables_in_rhs_set_is_defined is set.
-        // Note that we do not remove variables in variables_in_rhs;
-        if (i<m_super.m_index_table.size())
+        // actual value assigned to the variable.
+        m_super.m_free_positions.push(j);
+        m_super.erase_position(i);
+
+        if (m_super.m_variables_in_rhs_set_is_defined)
         {
-          std::size_t j=m_super.m_index_table[i];
-          if (j!=std::size_t(-1))
+          // remove the variables from the rhs.
+          m_super.update_variables_in_rhs(m_super.m_container[j].second, false);
+          if (m_super.empty())
           {
-            m_super.m_free_positions.push(j);
-            m_super.m_index_table[i]=std::size_t(-1);
-
-            if (m_super.m_variables_in_rhs_set_is_defined)
-            {
-              // remove the variables from the rhs. 
-              std::set<variable_type> s=find_free_variables(m_super.m_container[j].second);
-              for(const variable& v:s) 
-              { 
-                // Remove one occurrence of v. 
-                const std::multiset<variable>::const_iterator i=m_super.m_variables_in_rhs.find(v);
-                m_super.m_variables_in_rhs.erase(i);
-              }
-              if (m_super.m_free_positions.size()==m_super.m_container.size())
-              {
-                // The substitution is empty; no variables are assigned. 
-                // Check that the administration of variables in the rhs is proper. 
-                // Postpone maintaining variables in the rhs until needed again. 
-                assert(m_super.m_variables_in_rhs.empty());
-                m_super.m_variables_in_rhs_set_is_defined=false;
-              }
-            }
+            // The substitution is empty; no variables are assigned.
+            // Check that the administration of variables in the rhs is proper.
+            // Postpone maintaining variables in the rhs until needed again.
+            assert(m_super.m_variables_in_rhs.empty());
+            m_super.m_variables_in_rhs_set_is_defined=false;
           }
         }
       }
@@ -188,21 +267,16 @@ public:
 
   /// \brief Application operator; applies substitution to v.
   /// \details This must deliver an expression, and not a reference
-  ///          to an expression, as the expressions are stored in 
-  ///          a vector that can be resized and moved. 
- 
+  ///          to an expression, as the expressions are stored in
+  ///          a vector that can be resized and moved.
   const expression_type operator()(const variable_type& v) const
   {
-    const std::size_t i = core::index_traits<data::variable, data::variable_key_type, 2>::index(v);
-    if (i < m_index_table.size())
+    const std::size_t j = position(index(v));
+    if (j!=std::size_t(-1))
     {
-      const std::size_t j = m_index_table[i];
-      if (j!=std::size_t(-1))
-      {
-        // the variable has an assigned value.
-        assert(j<m_container.size());
-        return m_container[j].second;
-      }
+      // the variable has an assigned value.
+      assert(j<m_container.size());
+      return m_container[j].second;
     }
     // no value assigned to v;
     return v;
@@ -215,9 +289,22 @@ public:
   }
 
   /// \brief Clear substitutions.
+  /// \details This takes time proportional to the number of assignments, not to the largest variable index.
   void clear()
   {
-    m_index_table.clear();
+    if (!m_index_table_is_sparse)
+    {
+      for (const substitution_type& p: m_container)
+      {
+        const std::size_t i = index(p.first);
+        if (i < m_index_table.size())
+        {
+          m_index_table[i] = std::size_t(-1);
+        }
+      }
+    }
+    m_sparse_index_table.clear();
+    m_index_table_is_sparse = false;
     m_container.clear();
     m_free_positions=std::stack<std::size_t>();
     m_variables_in_rhs_set_is_defined=false;
@@ -231,34 +318,32 @@ public:
     return false;
   }
 
-  /// \brief Provides a set of variables that occur in the right hand sides of the assignments.
-//   const std::multiset<variable>& variables_in_rhs()
+  /// \brief Indicates whether v occurs in the right hand side of an assignment.
   bool variable_occurs_in_a_rhs(const variable& v)
   {
     if (!m_variables_in_rhs_set_is_defined)
     {
-      for(const std::size_t i: m_index_table)
+      for (std::size_t j = 0; j < m_container.size(); ++j)
       {
-        if (i != std::size_t(-1))
+        if (position(index(m_container[j].first)) == j)
         {
-          std::set<variable_type> s=find_free_variables(m_container[i].second);
-          m_variables_in_rhs.insert(s.begin(),s.end());
+          update_variables_in_rhs(m_container[j].second, true);
         }
       }
       m_variables_in_rhs_set_is_defined=true;
     }
-    return m_variables_in_rhs.find(v)!=m_variables_in_rhs.end();
+    return m_variables_in_rhs.count(index(v)) > 0;
   }
 
   /// \brief Returns the number of assigned variables in the substitution.
-  bool size()
+  std::size_t size() const
   {
     assert(m_container.size()>=m_free_positions.size());
     return m_container.size()-m_free_positions.size();
   }
 
   /// \brief Returns true if the substitution is empty.
-  bool empty()
+  bool empty() const
   {
     assert(m_container.size()>=m_free_positions.size());
     return m_container.size()==m_free_positions.size();
@@ -268,25 +353,32 @@ public:
   /// \brief string representation of the substitution. N.B. This is an expensive operation!
   std::string to_string() const
   {
+    // The assignments are printed in the order of the indices of their variables.
+    std::map<std::size_t, std::size_t> positions;
+    for (std::size_t j = 0; j < m_container.size(); ++j)
+    {
+      const std::size_t i = index(m_container[j].first);
+      if (position(i) == j)
+      {
+        positions[i] = j;
+      }
+    }
+
     std::stringstream result;
     bool first = true;
     result << "[";
-    for (std::size_t i = 0; i < m_index_table.size(); ++i)
+    for (const std::pair<const std::size_t, std::size_t>& p: positions)
     {
-      const std::size_t j=m_index_table[i];
-      if (j != std::size_t(-1))
+      if (first)
       {
-        if (first)
-        {
-          first = false;
-        }
-        else
-        {
-          result << "; ";
-        }
-        
-        result << m_container.at(j).first << " := " << m_container.at(j).second;
+        first = false;
       }
+      else
+      {
+        result << "; ";
+      }
+
+      result << m_container.at(p.second).first << " := " << m_container.at(p.second).second;
     }
     result << "]";
     return result.str();
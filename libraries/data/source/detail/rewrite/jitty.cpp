@@ -69,7 +69,7 @@ struct jitty_assignments_for_a_rewrite_rule
 // Terms with this auxiliary function symbol cannot be printed using the pretty printer for data expressions.
 
 
-static const function_symbol& this_term_is_in_normal_form()
+const function_symbol& this_term_is_in_normal_form()
 {
   static const function_symbol this_term_is_in_normal_form(
                          std::string("Rewritten@@term"),
@@ -153,17 +153,22 @@ void RewriterJitty::make_jitty_strat_sufficiently_larger(const std::size_t i)
   if (i>=jitty_strat.size())
   {
     jitty_strat.resize(i+1);
+    m_machine_word_functions.resize(i+1);
   }
 }
 
 void RewriterJitty::rebuild_strategy()
 {
   jitty_strat.clear();
+  m_machine_word_functions.clear();
   for(std::map< function_symbol, data_equation_list >::const_iterator l=jitty_eqns.begin(); l!=jitty_eqns.end(); ++l)
   {
     const std::size_t i=core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(l->first);
     make_jitty_strat_sufficiently_larger(i);
     jitty_strat[i] = create_strategy(reverse(l->second));
+    // Only function symbols with rewrite rules are evaluated on machine words, such that the
+    // result is a normal form that the rules would also have produced.
+    m_machine_word_functions[i] = machine_word_function(l->first);
   }
 }
 
@@ -209,7 +214,8 @@ RewriterJitty::~RewriterJitty()
 static data_expression subst_values(
             const jitty_assignments_for_a_rewrite_rule& assignments,
             const data_expression& t,
-            data::enumerator_identifier_generator& generator) // This generator is used for the generation of fresh variable names.
+            data::enumerator_identifier_generator& generator, // This generator is used for the generation of fresh variable names.
+            const std::size_t normal_form_tag)
 {
   if (is_function_symbol(t))
   {
@@ -221,12 +227,14 @@ static data_expression subst_values(
     {
       if (atermpp::detail::address(t)==assignments.assignment[i].var)
       {
-        if (assignments.assignment[i].variable_is_a_normal_form)
+        const data_expression term=atermpp::down_cast<data_expression>(atermpp::aterm(assignments.assignment[i].term));
+        if (assignments.assignment[i].variable_is_a_normal_form && !is_tagged_normal_form(term, normal_form_tag))
         {
-          // Variables that are in normal form get a tag that they are in normal form.
-          return application(this_term_is_in_normal_form(),atermpp::down_cast<data_expression>(atermpp::aterm(assignments.assignment[i].term)));  
+          // Variables that are in normal form get a tag that they are in normal form, unless the term itself
+          // already carries the normal form tag of this rewriter.
+          return application(this_term_is_in_normal_form(),term);
         }
-        return atermpp::down_cast<data_expression>(atermpp::aterm(assignments.assignment[i].term));
+        return term;
       }
     }
     return t;
@@ -267,7 +275,8 @@ static data_expression subst_values(
                        variable_list(new_variables.begin(),new_variables.end()),
                        subst_values(assignments,
                                     (sigma_trivial?t1.body():replace_variables(t1.body(),sigma)),
-                                    generator));
+                                    generator,
+                                    normal_form_tag));
   }
   else if (is_where_clause(t))
   {
@@ -291,19 +300,20 @@ static data_expression subst_values(
     for(const assignment_expression& a: local_assignments)
     {
       const assignment& assignment_expr = atermpp::down_cast<assignment>(a);
-      new_assignments.push_back(assignment(assignment_expr.lhs(), subst_values(assignments,assignment_expr.rhs(),generator)));
+      new_assignments.push_back(assignment(assignment_expr.lhs(), subst_values(assignments,assignment_expr.rhs(),generator,normal_form_tag)));
     }
-    return where_clause(subst_values(assignments,body,generator),assignment_list(new_assignments.begin(),new_assignments.end()));
+    return where_clause(subst_values(assignments,body,generator,normal_form_tag),assignment_list(new_assignments.begin(),new_assignments.end()));
   }
   else
   {
     const application& t1 = atermpp::down_cast<application>(t);
     return application(subst_values(assignments,
                                     t1.head(),
-                                    generator),
+                                    generator,
+                                    normal_form_tag),
                        t1.begin(),
                        t1.end(),
-                       [&](const data_expression& t){ return subst_values(assignments,t,generator);});
+                       [&](const data_expression& t){ return subst_values(assignments,t,generator,normal_form_tag);});
   }
 }
 
@@ -373,6 +383,25 @@ static bool match_jitty(
 data_expression RewriterJitty::rewrite_aux(
                       const data_expression& term,
                       substitution_type& sigma)
+{
+  if (is_tagged_normal_form(term, m_normal_form_tag))
+  {
+    return term;
+  }
+  if (is_variable(term))
+  {
+    // The value of a variable is not rewritten, so it is not tagged either.
+    return sigma(atermpp::down_cast<variable>(term));
+  }
+
+  const data_expression result=rewrite_aux_untagged(term, sigma);
+  tag_normal_form(result, m_normal_form_tag);
+  return result;
+}
+
+data_expression RewriterJitty::rewrite_aux_untagged(
+                      const data_expression& term,
+                      substitution_type& sigma)
 {
   if (is_application(term))
   {
@@ -441,10 +470,7 @@ data_expression RewriterJitty::rewrite_aux(
     assert(term!=this_term_is_in_normal_form());
     return rewrite_aux_const_function_symbol(atermpp::down_cast<const function_symbol>(term),sigma);
   }
-  if (is_variable(term))
-  {
-    return sigma(atermpp::down_cast<variable>(term));
-  }
+  assert(!is_variable(term));
   if (is_where_clause(term))
   {
     const where_clause& w = atermpp::down_cast<where_clause>(term);
@@ -491,6 +517,8 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
   if (!strat.rules().empty())
   {
     jitty_assignments_for_a_rewrite_rule assignments(MCRL2_SPECIFIC_STACK_ALLOCATOR(jitty_variable_assignment_for_a_rewrite_rule, strat.number_of_variables()));
+    const machine_word_function& machine_word=m_machine_word_functions[op_value];
+    std::size_t number_of_rewritten_arguments=0;
 
     for (const strategy_rule& rule : strat.rules())
     {
@@ -504,6 +532,21 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
           {
             new (&rewritten[i]) data_expression(rewrite_aux(detail::get_argument_of_higher_order_term(atermpp::down_cast<application>(term),i),sigma));
             rewritten_defined[i]=true;
+            ++number_of_rewritten_arguments;
+
+            // When all arguments are normal forms, arithmetic on numerals is evaluated on machine words.
+            if (number_of_rewritten_arguments==arity && machine_word.is_defined() && machine_word.arity()==arity)
+            {
+              data_expression result;
+              if (arity==1?machine_word.apply(rewritten[0],result):machine_word.apply(rewritten[0],rewritten[1],result))
+              {
+                for (std::size_t j=0; j<arity; j++)
+                {
+                  rewritten[j].~data_expression();
+                }
+                return result;
+              }
+            }
           }
           assert(rewritten[i].defined());
         }
@@ -540,13 +583,13 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
         if (matches)
         {
           if (rule1.condition()==sort_bool::true_() || rewrite_aux(
-                   subst_values(assignments,rule1.condition(),m_generator),sigma)==sort_bool::true_())
+                   subst_values(assignments,rule1.condition(),m_generator,m_normal_form_tag),sigma)==sort_bool::true_())
           {
             const data_expression& rhs=rule1.rhs();
 
             if (arity == rule_arity)
             {
-              const data_expression& result=rewrite_aux(subst_values(assignments,rhs,m_generator),sigma);
+              const data_expression& result=rewrite_aux(subst_values(assignments,rhs,m_generator,m_normal_form_tag),sigma);
               for (std::size_t i=0; i<arity; i++)
               {
                 if (rewritten_defined[i])
@@ -563,7 +606,7 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
               // There are more arguments than those that have been rewritten.
               // Get those, put them in rewritten.
 
-              data_expression result=subst_values(assignments,rhs,m_generator);
+              data_expression result=subst_values(assignments,rhs,m_generator,m_normal_form_tag);
 
               for(std::size_t i=rule_arity; i<arity; ++i)
               {
@@ -0,0 +1,745 @@
+// Author(s): Muck van Weerdenburg, Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file jittyb.cpp
+/// \brief The jitty rewriter in which the strategy, the matching of left hand sides and the
+///        construction of right hand sides of every function symbol are translated to a bytecode
+///        that is executed by a single dispatch loop. Unlike the compiling rewriter it does not
+///        need a C++ compiler, and the translation takes time linear in the size of the equations.
+
+#include "mcrl2/data/detail/rewrite/jittyb.h"
+#include "mcrl2/data/detail/rewrite/jitty.h"
+#include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+
+#include <cassert>
+#include <limits>
+#include <map>
+
+#include "mcrl2/utilities/detail/memory_utility.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/data/find.h"
+#include "mcrl2/data/replace.h"
+#include "mcrl2/data/substitutions/mutable_map_substitution.h"
+
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+#include "mcrl2/data/detail/rewrite_statistics.h"
+#endif
+
+using namespace mcrl2::log;
+
+namespace mcrl2
+{
+namespace data
+{
+namespace detail
+{
+
+namespace jittyb
+{
+
+// Collect the arguments of a possibly higher order application f(t1,...,tn)(u1,...,um)... in order.
+static void collect_arguments(const data_expression& t, std::vector<data_expression>& arguments)
+{
+  if (is_application(t))
+  {
+    const application& ta=atermpp::down_cast<application>(t);
+    collect_arguments(ta.head(), arguments);
+    arguments.insert(arguments.end(), ta.begin(), ta.end());
+  }
+}
+
+/// \brief Translates the strategy of a single function symbol to a program.
+class compiler
+{
+  public:
+    compiler(program& p, std::size_t arity, const std::vector<program>& programs)
+      : m_program(p),
+        m_arity(arity),
+        m_programs(programs)
+    {}
+
+    void compile()
+    {
+      for (const strategy_rule& rule: m_program.source.rules())
+      {
+        if (rule.is_rewrite_index())
+        {
+          emit(instruction(opcode::rewrite_argument, narrow(rule.rewrite_index())));
+        }
+        else
+        {
+          compile_rule(rule.equation());
+        }
+      }
+    }
+
+  private:
+    program& m_program;
+    const std::size_t m_arity; // The number of arguments of the function symbol when it is fully applied.
+    const std::vector<program>& m_programs; // The programs of all function symbols, of which only the strategies are used.
+    std::map<variable, std::uint32_t> m_slots;
+    std::size_t m_next_register = 0;
+
+    static std::uint32_t narrow(std::size_t n)
+    {
+      if (n > std::numeric_limits<std::uint32_t>::max())
+      {
+        throw mcrl2::runtime_error("The rewrite rules are too large for the bytecode rewriter.");
+      }
+      return static_cast<std::uint32_t>(n);
+    }
+
+    void emit(const instruction& i)
+    {
+      m_program.code.push_back(i);
+    }
+
+    std::uint32_t allocate_registers(std::size_t n)
+    {
+      const std::size_t first=m_next_register;
+      m_next_register+=n;
+      m_program.number_of_registers=std::max(m_program.number_of_registers, m_next_register);
+      return narrow(first);
+    }
+
+    void compile_rule(const data_equation& equation)
+    {
+      m_slots.clear();
+      m_next_register=0;
+
+      std::vector<data_expression> patterns;
+      collect_arguments(equation.lhs(), patterns);
+
+      const std::size_t begin=m_program.code.size();
+      emit(instruction(opcode::begin_rule, narrow(patterns.size())));
+      const std::uint32_t first=allocate_registers(patterns.size());
+      for (std::size_t i=0; i<patterns.size(); ++i)
+      {
+        emit(instruction(opcode::load_argument, narrow(first+i), narrow(i)));
+        compile_pattern(patterns[i], narrow(first+i));
+      }
+      m_program.number_of_variables=std::max(m_program.number_of_variables, m_slots.size());
+
+      if (equation.condition()!=sort_bool::true_())
+      {
+        compile_normal_form(equation.condition());
+        emit(instruction(opcode::check_condition));
+      }
+      if (patterns.size()==m_arity)
+      {
+        compile_normal_form(equation.rhs());
+      }
+      else
+      {
+        // The right hand side is applied to more arguments before it is rewritten.
+        compile_term(equation.rhs());
+      }
+      emit(instruction(opcode::apply_rule, narrow(patterns.size())));
+
+      // The rule fails to the first instruction after it.
+      m_program.code[begin].b=narrow(m_program.code.size());
+    }
+
+    // Matching follows match_jitty: first the head and then the arguments from left to right.
+    void compile_pattern(const data_expression& pattern, std::uint32_t reg)
+    {
+      if (is_function_symbol(pattern))
+      {
+        emit(instruction(opcode::match_function_symbol, reg, 0, 0, atermpp::detail::address(pattern)));
+      }
+      else if (is_variable(pattern))
+      {
+        const variable& v=atermpp::down_cast<variable>(pattern);
+        std::map<variable, std::uint32_t>::const_iterator i=m_slots.find(v);
+        if (i==m_slots.end())
+        {
+          const std::uint32_t slot=narrow(m_slots.size());
+          m_slots[v]=slot;
+          emit(instruction(opcode::bind_variable, reg, slot));
+        }
+        else
+        {
+          emit(instruction(opcode::match_variable, reg, i->second));
+        }
+      }
+      else
+      {
+        const application& pa=atermpp::down_cast<application>(pattern);
+        const std::uint32_t first=allocate_registers(pa.size()+1);
+        emit(instruction(opcode::match_application, reg, narrow(pa.size()), first));
+        compile_pattern(pa.head(), first);
+        std::uint32_t arg=first;
+        for (const data_expression& t: pa)
+        {
+          compile_pattern(t, ++arg);
+        }
+      }
+    }
+
+    bool contains_bound_variable(const data_expression& t) const
+    {
+      for (const variable& v: find_free_variables(t))
+      {
+        if (m_slots.count(v)>0)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Determines which of the first n arguments of f are rewritten whenever f is applied to n arguments.
+    // These are the arguments that the strategy of f rewrites before it tries the first rule, or all
+    // arguments if f has no rules.
+    std::vector<bool> needed_arguments(const function_symbol& f, const std::size_t n) const
+    {
+      const std::size_t index=core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(f);
+      if (index>=m_programs.size() || m_programs[index].source.rules().empty())
+      {
+        return std::vector<bool>(n, true);
+      }
+
+      std::vector<bool> result(n, false);
+      for (const strategy_rule& rule: m_programs[index].source.rules())
+      {
+        if (!rule.is_rewrite_index() || rule.rewrite_index()>=n)
+        {
+          break;
+        }
+        result[rule.rewrite_index()]=true;
+      }
+      return result;
+    }
+
+    // Pushes either the normal form of t, or t itself when the normal form cannot be computed without
+    // constructing t. The arguments that are needed anyhow are rewritten directly, the others are
+    // constructed and only rewritten when the strategy of the head symbol requires so.
+    void compile_normal_form(const data_expression& t)
+    {
+      if (is_application(t) &&
+          is_function_symbol(atermpp::down_cast<application>(t).head()) &&
+          contains_bound_variable(t))
+      {
+        const application& ta=atermpp::down_cast<application>(t);
+        const function_symbol& f=atermpp::down_cast<function_symbol>(ta.head());
+        const std::vector<bool> needed=needed_arguments(f, ta.size());
+        std::size_t k=0;
+        for (const data_expression& arg: ta)
+        {
+          if (needed[k++])
+          {
+            compile_normal_form(arg);
+          }
+          else
+          {
+            compile_term(arg);
+          }
+        }
+        emit(instruction(opcode::rewrite_application, narrow(ta.size()), 0, 0, atermpp::detail::address(f)));
+      }
+      else
+      {
+        compile_term(t);
+      }
+    }
+
+    void compile_term(const data_expression& t)
+    {
+      if (!contains_bound_variable(t))
+      {
+        emit(instruction(opcode::push_term, 0, 0, 0, atermpp::detail::address(t)));
+      }
+      else if (is_variable(t))
+      {
+        emit(instruction(opcode::push_variable, m_slots.at(atermpp::down_cast<variable>(t))));
+      }
+      else if (is_application(t))
+      {
+        const application& ta=atermpp::down_cast<application>(t);
+        compile_term(ta.head());
+        for (const data_expression& arg: ta)
+        {
+          compile_term(arg);
+        }
+        emit(instruction(opcode::build_application, narrow(ta.size())));
+      }
+      else
+      {
+        // Binders and where clauses are rare in right hand sides, and are instantiated by a capture
+        // avoiding substitution.
+        std::vector<variable> variables(m_slots.size());
+        for (const std::pair<const variable, std::uint32_t>& p: m_slots)
+        {
+          variables[p.second]=p.first;
+        }
+        emit(instruction(opcode::push_substituted, narrow(m_program.variables.size()), 0, 0, atermpp::detail::address(t)));
+        m_program.variables.push_back(variable_list(variables.begin(), variables.end()));
+      }
+    }
+};
+
+} // namespace jittyb
+
+using namespace jittyb;
+
+RewriterJittyBytecode::RewriterJittyBytecode(
+           const data_specification& data_spec,
+           const mcrl2::data::used_data_equation_selector& equation_selector):
+        Rewriter(data_spec,equation_selector)
+{
+  std::map<function_symbol, data_equation_list> equations;
+  for (const data_equation& eq: data_spec.equations())
+  {
+    if (equation_selector(eq))
+    {
+      try
+      {
+        CheckRewriteRule(eq);
+      }
+      catch (std::runtime_error& e)
+      {
+        mCRL2log(warning) << e.what() << std::endl;
+        continue;
+      }
+
+      equations[atermpp::down_cast<function_symbol>(get_nested_head(eq.lhs()))].push_front(eq);
+    }
+  }
+
+  // First determine all strategies, as the translation of a right hand side depends on the strategies
+  // of the function symbols that occur in it.
+  for (const std::pair<const function_symbol, data_equation_list>& p: equations)
+  {
+    const std::size_t i=core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(p.first);
+    if (i>=m_programs.size())
+    {
+      m_programs.resize(i+1);
+    }
+    m_programs[i].source=create_strategy(reverse(p.second));
+  }
+
+  for (const std::pair<const function_symbol, data_equation_list>& p: equations)
+  {
+    const std::size_t i=core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(p.first);
+    compiler(m_programs[i], getArity(p.first), m_programs).compile();
+  }
+}
+
+RewriterJittyBytecode::~RewriterJittyBytecode()
+{
+}
+
+const jittyb::program* RewriterJittyBytecode::find_program(const function_symbol& op) const
+{
+  const std::size_t i=core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(op);
+  if (i<m_programs.size() && !m_programs[i].code.empty())
+  {
+    return &m_programs[i];
+  }
+  return nullptr;
+}
+
+data_expression RewriterJittyBytecode::rewrite_aux(
+                      const data_expression& term,
+                      substitution_type& sigma)
+{
+  if (is_tagged_normal_form(term, m_normal_form_tag))
+  {
+    return term;
+  }
+  if (is_variable(term))
+  {
+    // The value of a variable is not rewritten, so it is not tagged either.
+    return sigma(atermpp::down_cast<variable>(term));
+  }
+
+  const data_expression result=rewrite_aux_untagged(term, sigma);
+  tag_normal_form(result, m_normal_form_tag);
+  return result;
+}
+
+data_expression RewriterJittyBytecode::rewrite_aux_untagged(
+                      const data_expression& term,
+                      substitution_type& sigma)
+{
+  if (is_function_symbol(term))
+  {
+    return rewrite_aux_function_symbol(atermpp::down_cast<function_symbol>(term),term,sigma);
+  }
+
+  if (is_application(term))
+  {
+    const application& tapp=atermpp::down_cast<application>(term);
+    if (tapp.head()==this_term_is_in_normal_form())
+    {
+      assert(tapp.size()==1);
+      return tapp[0];
+    }
+
+    const data_expression& head=get_nested_head(term);
+    if (is_function_symbol(head) && head!=this_term_is_in_normal_form())
+    {
+      return rewrite_aux_function_symbol(atermpp::down_cast<function_symbol>(head),term,sigma);
+    }
+
+    const data_expression t=rewrite_aux(tapp.head(),sigma);
+    const data_expression& head1=get_nested_head(t);
+    if (is_function_symbol(head1))
+    {
+      return rewrite_aux_function_symbol(atermpp::down_cast<function_symbol>(head1),application(t,tapp.begin(),tapp.end()),sigma);
+    }
+    else if (is_variable(head1))
+    {
+      return application(t,tapp.begin(),tapp.end(),[&](const data_expression& arg){ return rewrite_aux(arg,sigma); });
+    }
+    assert(is_abstraction(t));
+    const binder_type& binder=atermpp::down_cast<abstraction>(t).binding_operator();
+    if (is_lambda_binder(binder))
+    {
+      return rewrite_lambda_application(t,tapp,sigma);
+    }
+    if (is_exists_binder(binder))
+    {
+      return existential_quantifier_enumeration(t,sigma);
+    }
+    assert(is_forall_binder(binder));
+    return universal_quantifier_enumeration(head1,sigma);
+  }
+
+  assert(!is_variable(term));
+  if (is_where_clause(term))
+  {
+    return rewrite_where(atermpp::down_cast<where_clause>(term),sigma);
+  }
+
+  const abstraction& ta=atermpp::down_cast<abstraction>(term);
+  if (is_exists(ta))
+  {
+    return existential_quantifier_enumeration(ta,sigma);
+  }
+  if (is_forall(ta))
+  {
+    return universal_quantifier_enumeration(ta,sigma);
+  }
+  assert(is_lambda(ta));
+  return rewrite_single_lambda(ta.variables(),ta.body(),false,sigma);
+}
+
+// Applies t to the arguments from index first onwards, grouped according to the sort of op.
+static data_expression apply_to_arguments(
+                      data_expression t,
+                      const function_symbol& op,
+                      const std::size_t first,
+                      const data_expression** arguments,
+                      const std::size_t arity)
+{
+  std::size_t i=first;
+  sort_expression sort=residual_sort(op.sort(),first);
+  while (is_function_sort(sort) && i<arity)
+  {
+    const function_sort& fsort=atermpp::down_cast<function_sort>(sort);
+    const std::size_t end=i+fsort.domain().size();
+    assert(end-1<arity);
+    t=application(t,arguments+i,arguments+end,[](const data_expression* arg) -> const data_expression& { return *arg; });
+    i=end;
+    sort=fsort.codomain();
+  }
+  return t;
+}
+
+// Stores pointers to the arguments of the possibly higher order application t in order.
+static void collect_argument_pointers(const data_expression& t, const data_expression** arguments, std::size_t& n)
+{
+  if (is_function_symbol(t) || is_variable(t) || is_where_clause(t) || is_abstraction(t))
+  {
+    return;
+  }
+  const application& ta=atermpp::down_cast<application>(t);
+  collect_argument_pointers(ta.head(), arguments, n);
+  for (const data_expression& arg: ta)
+  {
+    arguments[n++]=&arg;
+  }
+}
+
+data_expression RewriterJittyBytecode::rewrite_aux_function_symbol(
+                      const function_symbol& op,
+                      const data_expression& term,
+                      substitution_type& sigma)
+{
+  const std::size_t arity=(is_function_symbol(term)?0:recursive_number_of_args(term));
+  const data_expression** arguments=MCRL2_SPECIFIC_STACK_ALLOCATOR(const data_expression*, arity);
+  std::size_t n=0;
+  collect_argument_pointers(term, arguments, n);
+  assert(n==arity);
+  return rewrite_arguments(op, arguments, nullptr, arity, sigma);
+}
+
+data_expression RewriterJittyBytecode::rewrite_arguments(
+                      const function_symbol& op,
+                      const data_expression** arguments,
+                      const bool* normal_forms,
+                      const std::size_t arity,
+                      substitution_type& sigma)
+{
+  // An argument that is rewritten is stored in rewritten, and arguments then points to it.
+  data_expression* rewritten=MCRL2_SPECIFIC_STACK_ALLOCATOR(data_expression, arity);
+  bool* is_rewritten=MCRL2_SPECIFIC_STACK_ALLOCATOR(bool, arity);
+  bool* is_constructed=MCRL2_SPECIFIC_STACK_ALLOCATOR(bool, arity);
+  for (std::size_t i=0; i<arity; ++i)
+  {
+    is_rewritten[i]=(normal_forms!=nullptr && normal_forms[i]);
+    is_constructed[i]=false;
+  }
+
+  struct cleanup
+  {
+    data_expression* rewritten;
+    const bool* is_constructed;
+    std::size_t arity;
+    ~cleanup()
+    {
+      for (std::size_t i=0; i<arity; ++i)
+      {
+        if (is_constructed[i])
+        {
+          rewritten[i].~data_expression();
+        }
+      }
+    }
+  } cleanup_rewritten{rewritten, is_constructed, arity};
+
+  const auto rewrite_argument=[&](std::size_t i)
+  {
+    new (&rewritten[i]) data_expression(rewrite_aux(*arguments[i],sigma));
+    is_constructed[i]=true;
+    is_rewritten[i]=true;
+    arguments[i]=&rewritten[i];
+  };
+
+  const program* prog=find_program(op);
+  if (prog!=nullptr)
+  {
+    const data_expression** registers=MCRL2_SPECIFIC_STACK_ALLOCATOR(const data_expression*, prog->number_of_registers);
+    bool* register_is_normal_form=MCRL2_SPECIFIC_STACK_ALLOCATOR(bool, prog->number_of_registers);
+    const data_expression** bindings=MCRL2_SPECIFIC_STACK_ALLOCATOR(const data_expression*, prog->number_of_variables);
+    bool* binding_is_normal_form=MCRL2_SPECIFIC_STACK_ALLOCATOR(bool, prog->number_of_variables);
+
+    const instruction* const code=prog->code.data();
+    const std::size_t end=prog->code.size();
+    std::size_t failure=end;
+    std::size_t pc=0;
+    while (pc<end)
+    {
+      const instruction& i=code[pc++];
+      switch (i.code)
+      {
+        case opcode::rewrite_argument:
+        {
+          if (i.a>=arity)
+          {
+            pc=end;
+          }
+          else if (!is_rewritten[i.a])
+          {
+            rewrite_argument(i.a);
+          }
+          break;
+        }
+        case opcode::begin_rule:
+        {
+          if (i.a>arity)
+          {
+            pc=end;
+          }
+          failure=i.b;
+          break;
+        }
+        case opcode::load_argument:
+        {
+          registers[i.a]=arguments[i.b];
+          register_is_normal_form[i.a]=is_rewritten[i.b];
+          break;
+        }
+        case opcode::match_function_symbol:
+        {
+          if (atermpp::detail::address(*registers[i.a])!=i.term)
+          {
+            pc=failure;
+          }
+          break;
+        }
+        case opcode::match_application:
+        {
+          const data_expression& t=*registers[i.a];
+          if (is_function_symbol(t) || is_variable(t) || is_abstraction(t) || is_where_clause(t) ||
+              atermpp::down_cast<application>(t).size()!=i.b)
+          {
+            pc=failure;
+            break;
+          }
+          // Only normal forms are matched against applications, so the subterms are normal forms.
+          assert(register_is_normal_form[i.a]);
+          const application& ta=atermpp::down_cast<application>(t);
+          registers[i.c]=&ta.head();
+          register_is_normal_form[i.c]=true;
+          std::size_t r=i.c;
+          for (const data_expression& arg: ta)
+          {
+            registers[++r]=&arg;
+            register_is_normal_form[r]=true;
+          }
+          break;
+        }
+        case opcode::bind_variable:
+        {
+          bindings[i.b]=registers[i.a];
+          binding_is_normal_form[i.b]=register_is_normal_form[i.a];
+          break;
+        }
+        case opcode::match_variable:
+        {
+          if (*registers[i.a]!=*bindings[i.b])
+          {
+            pc=failure;
+          }
+          break;
+        }
+        case opcode::push_term:
+        {
+          m_stack.emplace_back(atermpp::down_cast<data_expression>(atermpp::aterm(const_cast<atermpp::detail::_aterm*>(i.term))), false);
+          break;
+        }
+        case opcode::push_variable:
+        {
+          m_stack.emplace_back(*bindings[i.a], binding_is_normal_form[i.a]);
+          break;
+        }
+        case opcode::push_substituted:
+        {
+          mutable_map_substitution<> substitution;
+          std::set<variable> substitution_variables;
+          std::size_t slot=0;
+          for (const variable& v: prog->variables[i.a])
+          {
+            substitution[v]=*bindings[slot++];
+            const std::set<variable> free_variables=find_free_variables(substitution(v));
+            substitution_variables.insert(free_variables.begin(), free_variables.end());
+          }
+          const data_expression t=atermpp::down_cast<data_expression>(atermpp::aterm(const_cast<atermpp::detail::_aterm*>(i.term)));
+          m_stack.emplace_back(replace_variables_capture_avoiding(t, substitution, substitution_variables), false);
+          break;
+        }
+        case opcode::build_application:
+        {
+          // Arguments that are normal forms get a tag that they are in normal form, such that they
+          // are not rewritten again.
+          const std::size_t size=m_stack.size();
+          assert(size>i.a);
+          const std::size_t first=size-i.a;
+          const application t(m_stack[first-1].term, m_stack.begin()+first, m_stack.end(),
+                              [this](const stack_entry& e) -> data_expression
+                              {
+                                if (e.is_normal_form && !is_tagged_normal_form(e.term, m_normal_form_tag))
+                                {
+                                  return data_expression(application(this_term_is_in_normal_form(), e.term));
+                                }
+                                return e.term;
+                              });
+          m_stack.erase(m_stack.begin()+first, m_stack.end());
+          m_stack.back().term=t;
+          m_stack.back().is_normal_form=false;
+          break;
+        }
+        case opcode::rewrite_application:
+        {
+          // The arguments are moved from the stack, which can grow while they are rewritten.
+          const std::size_t first=m_stack.size()-i.a;
+          data_expression* values=MCRL2_SPECIFIC_STACK_ALLOCATOR(data_expression, i.a);
+          const data_expression** value_pointers=MCRL2_SPECIFIC_STACK_ALLOCATOR(const data_expression*, i.a);
+          bool* value_is_normal_form=MCRL2_SPECIFIC_STACK_ALLOCATOR(bool, i.a);
+          for (std::size_t k=0; k<i.a; ++k)
+          {
+            new (&values[k]) data_expression(std::move(m_stack[first+k].term));
+            value_pointers[k]=&values[k];
+            value_is_normal_form[k]=m_stack[first+k].is_normal_form;
+          }
+          m_stack.erase(m_stack.begin()+first, m_stack.end());
+
+          struct cleanup
+          {
+            data_expression* values;
+            std::size_t size;
+            ~cleanup()
+            {
+              for (std::size_t k=0; k<size; ++k)
+              {
+                values[k].~data_expression();
+              }
+            }
+          } cleanup_values{values, i.a};
+
+          const function_symbol f=atermpp::down_cast<function_symbol>(atermpp::aterm(const_cast<atermpp::detail::_aterm*>(i.term)));
+          m_stack.emplace_back(rewrite_arguments(f, value_pointers, value_is_normal_form, i.a, sigma), true);
+          break;
+        }
+        case opcode::check_condition:
+        {
+          const stack_entry condition=m_stack.back();
+          m_stack.pop_back();
+          if ((condition.is_normal_form?condition.term:rewrite_aux(condition.term,sigma))!=sort_bool::true_())
+          {
+            pc=failure;
+          }
+          break;
+        }
+        case opcode::apply_rule:
+        {
+          const stack_entry rhs=m_stack.back();
+          m_stack.pop_back();
+          if (i.a==arity)
+          {
+            return rhs.is_normal_form?rhs.term:rewrite_aux(rhs.term,sigma);
+          }
+          return rewrite_aux(apply_to_arguments(rhs.term,op,i.a,arguments,arity),sigma);
+        }
+      }
+    }
+  }
+
+  // No rewrite rule is applicable. Rewrite the arguments that have not been rewritten yet.
+  for (std::size_t i=0; i<arity; ++i)
+  {
+    if (!is_rewritten[i])
+    {
+      rewrite_argument(i);
+    }
+  }
+  return apply_to_arguments(op,op,0,arguments,arity);
+}
+
+data_expression RewriterJittyBytecode::rewrite(
+     const data_expression& term,
+     substitution_type& sigma)
+{
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+  data::detail::increment_rewrite_count();
+#endif
+  const data_expression& t=rewrite_aux(term, sigma);
+  assert(remove_normal_form_function(t)==t);
+  return t;
+}
+
+rewrite_strategy RewriterJittyBytecode::getStrategy()
+{
+  return jitty_bytecode;
+}
+
+} // namespace detail
+} // namespace data
+} // namespace mcrl2
@@ -24,10 +24,14 @@
 #include <cerrno>
 #include <cstring>
 #include <cassert>
+#include <cstdint>
 #include <sstream>
 #include <fstream>
+#include <iomanip>
 #include <sys/stat.h>
+#include <thread>
 #include "mcrl2/utilities/detail/memory_utility.h"
+#include "mcrl2/utilities/trace.h"
 #include "mcrl2/utilities/basename.h"
 #include "mcrl2/utilities/logger.h"
 #include "mcrl2/utilities/stopwatch.h"
@@ -36,6 +40,7 @@
 #include "mcrl2/core/detail/function_symbols.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+#include "mcrl2/data/detail/rewrite/machine_word_arithmetic.h"
 #include "mcrl2/data/replace.h"
 #include "mcrl2/data/traverser.h"
 #include "mcrl2/data/substitutions/mutable_map_substitution.h"
@@ -968,6 +973,16 @@ class rewr_function_spec
     }
 };
 
+///
+/// \brief The generated code of a rewrite function, or of a class that delays such a function.
+///
+struct rewr_function_code
+{
+  rewr_function_spec spec;
+  std::string code;
+  std::set<rewr_function_spec> referenced; // The functions and classes that are used by the code.
+};
+
 class RewriterCompilingJitty::ImplementTree
 {
   private:
@@ -997,6 +1012,8 @@ class RewriterCompilingJitty::ImplementTree
   std::stack<rewr_function_spec> m_rewr_functions;
   std::set<rewr_function_spec> m_rewr_functions_implemented;
   std::set<std::size_t>m_delayed_application_functions; // Recalls the arities of the required functions 'delayed_application';
+  std::size_t auxiliary_method_name_index; // The number of generated auxiliary functions to reduce bracket nesting.
+  std::set<rewr_function_spec>* m_referenced_functions; // Records the functions used by the code being generated, if not null.
   std::vector<bool> m_used;
   std::vector<int> m_stack;
   padding m_padding;
@@ -1124,6 +1141,10 @@ class RewriterCompilingJitty::ImplementTree
     {
       m_rewr_functions.push(spec);
     }
+    if (m_referenced_functions != nullptr)
+    {
+      m_referenced_functions->insert(spec);
+    }
     return spec.name();
   }
 
@@ -1135,6 +1156,10 @@ class RewriterCompilingJitty::ImplementTree
     {
       m_rewr_functions.push(spec);
     }
+    if (m_referenced_functions != nullptr)
+    {
+      m_referenced_functions->insert(spec);
+    }
     rewr_function_name(f,arity); // Also declare the non delayed function.
     return spec.name();
   }
@@ -1593,8 +1618,6 @@ class RewriterCompilingJitty::ImplementTree
     */
     if (brackets.bracket_nesting_level>brackets.MCRL2_BRACKET_NESTING_LEVEL)
     {
-      static std::size_t auxiliary_method_name_index=0;
-
       m_stream << m_padding 
                << "const data_expression& result" << auxiliary_method_name_index << "= auxiliary_function_to_reduce_bracket_nesting" << auxiliary_method_name_index << "("
                << brackets.current_data_arguments.top() << ",this_rewriter);\n";
@@ -1779,7 +1802,7 @@ class RewriterCompilingJitty::ImplementTree
              std::stack<std::string>& auxiliary_code_fragments)
   {
     bool reset_current_data_parameters=false;
-    const void* func = (void*)(atermpp::detail::address(tree.function()));
+    const std::string func = "uint_address(" + m_rewriter.m_nf_cache.insert_term(tree.function()) + ")";
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -1984,7 +2007,7 @@ class RewriterCompilingJitty::ImplementTree
 
 public:
   ImplementTree(RewriterCompilingJitty& rewr, function_symbol_vector& function_symbols)
-    : m_rewriter(rewr), m_padding(2)
+    : m_rewriter(rewr), auxiliary_method_name_index(0), m_referenced_functions(nullptr), m_padding(2)
   {
     for (function_symbol_vector::const_iterator it = function_symbols.begin(); it != function_symbols.end(); ++it)
     {
@@ -2000,11 +2023,6 @@ public:
     }
   }
 
-  const std::set<rewr_function_spec>& implemented_rewrs()
-  {
-    return m_rewr_functions_implemented;
-  }
-
   ///
   /// \brief implement_tree
   /// \param tree
@@ -2050,6 +2068,26 @@ public:
     }
   }
 
+  /// \brief Generates code that evaluates an application of opid to numerals on machine words, when
+  ///        the rewrite rules of opid allow it. All arguments must be in normal form.
+  void implement_machine_word_function(std::ostream& m_stream, std::size_t arity, const function_symbol& opid)
+  {
+    const machine_word_function f(opid);
+    if (!f.is_defined() || f.arity() != arity)
+    {
+      return;
+    }
+    m_stream << m_padding << "{\n"
+             << m_padding << "  data_expression result;\n"
+             << m_padding << "  if (machine_word_function(machine_word_operation::" << pp(f.operation())
+                          << ", machine_word_sort::" << pp(f.result_sort()) << ").apply(arg0, "
+                          << (arity == 1 ? "" : "arg1, ") << "result))\n"
+             << m_padding << "  {\n"
+             << m_padding << "    return result; // Built-in arithmetic on machine words.\n"
+             << m_padding << "  }\n"
+             << m_padding << "}\n";
+  }
+
   void implement_strategy(
              std::ostream& m_stream, 
              match_tree_list strat, 
@@ -2080,6 +2118,10 @@ public:
           brackets.current_data_parameters.top()=parameters + (parameters.empty()?"":", ") + "const data_expression& arg" + to_string(arg);
           const std::string arguments = brackets.current_data_arguments.top();
           brackets.current_data_arguments.top()=arguments + (arguments.empty()?"":", ") + "arg" + to_string(arg);
+          if (std::find(m_used.begin(), m_used.end(), false) == m_used.end())
+          {
+            implement_machine_word_function(m_stream, arity, opid);
+          }
         }
         m_stream << m_padding << "// Considering argument " << arg << "\n";
       }
@@ -2246,7 +2288,7 @@ public:
     else
     {
       stringstream ss;
-      ss << "atermpp::down_cast<data_expression>(atermpp::aterm(reinterpret_cast<atermpp::detail::_aterm*>(" << (void*)atermpp::detail::address(opid) << ")))";
+      ss << m_rewriter.m_nf_cache.insert_term(opid);
       std::size_t used_arguments = 0;
       m_stream << rewr_function_finish_term(arity, ss.str(), down_cast<function_sort>(opid.sort()), used_arguments) << ";\n";
       assert(used_arguments == arity);
@@ -2397,22 +2439,123 @@ public:
     m_stream << m_padding << "\n";
   }
 
-  void generate_rewr_functions(std::ostream& m_stream)
+  ///
+  /// \brief generate_rewr_functions generates the code of all required rewrite functions. The code of
+  ///        every function is kept separately, such that the functions can be divided over several units.
+  /// \param functions The generated functions, in the order in which they were generated.
+  ///
+  void generate_rewr_functions(std::vector<rewr_function_code>& functions)
   {
     while (!m_rewr_functions.empty())
     {
       rewr_function_spec spec = m_rewr_functions.top();
       m_rewr_functions.pop();
+      std::stringstream code;
+      std::set<rewr_function_spec> referenced;
+      m_referenced_functions = &referenced;
       if (spec.delayed())
       {
-        generate_delayed_normal_form_generating_function(m_stream, spec.fs(), spec.arity());
+        generate_delayed_normal_form_generating_function(code, spec.fs(), spec.arity());
+        // The class calls the function that it delays.
+        referenced.insert(rewr_function_spec(spec.fs(), spec.arity(), false));
       }
       else
       {
         const match_tree_list strategy = m_rewriter.create_strategy(m_rewriter.jittyc_eqns[spec.fs()], spec.arity());
-        rewr_function_implementation(m_stream, spec.fs(), spec.arity(), strategy);
+        rewr_function_implementation(code, spec.fs(), spec.arity(), strategy);
       }
+      m_referenced_functions = nullptr;
+      functions.push_back(rewr_function_code{spec, code.str(), referenced});
+    }
+  }
+
+  ///
+  /// \brief generate_entry_declarations declares the functions via which other units call the rewrite
+  ///        function of spec. They are defined by generate_entries.
+  ///
+  void generate_entry_declarations(std::ostream& m_stream, const rewr_function_spec& spec)
+  {
+    if (spec.arity() == 0)
+    {
+      m_stream << "const data_expression& jittyc_" << spec.name() << "(RewriterCompilingJitty* this_rewriter);\n";
+      return;
+    }
+    for (const bool indirect: { false, true })
+    {
+      const char* argument_type = indirect ? "indirect_term" : "data_expression";
+      m_stream << "data_expression jittyc_" << spec.name() << (indirect ? "_indirect(" : "(");
+      for (std::size_t i = 0; i < spec.arity(); ++i)
+      {
+        m_stream << "const " << argument_type << "& arg" << i << ", ";
+      }
+      m_stream << "RewriterCompilingJitty* this_rewriter);\n";
+    }
+  }
+
+  ///
+  /// \brief generate_entries defines the functions via which other units call the rewrite function of
+  ///        spec. The first takes arguments in normal form, the second arguments that are not.
+  ///
+  void generate_entries(std::ostream& m_stream, const rewr_function_spec& spec)
+  {
+    if (spec.arity() == 0)
+    {
+      m_stream << "const data_expression& jittyc_" << spec.name() << "(RewriterCompilingJitty* this_rewriter)\n"
+                  "{\n"
+                  "  return rewr_functions::" << spec.name() << "(this_rewriter);\n"
+                  "}\n\n";
+      return;
+    }
+    for (const bool indirect: { false, true })
+    {
+      const char* argument_type = indirect ? "indirect_term" : "data_expression";
+      std::stringstream parameters;
+      std::stringstream arguments;
+      for (std::size_t i = 0; i < spec.arity(); ++i)
+      {
+        parameters << "const " << argument_type << "& arg" << i << ", ";
+        arguments << "arg" << i << ", ";
+      }
+      m_stream << "data_expression jittyc_" << spec.name() << (indirect ? "_indirect(" : "(")
+               << parameters.str() << "RewriterCompilingJitty* this_rewriter)\n"
+                  "{\n"
+                  "  return rewr_functions::" << spec.name() << "(" << arguments.str() << "this_rewriter);\n"
+                  "}\n\n";
+    }
+  }
+
+  ///
+  /// \brief generate_external_rewr_function generates a rewrite function for spec that calls the
+  ///        implementation in another unit. Terms that are not known to be in normal form are passed
+  ///        as indirect_term, such that they are only rewritten when that is required.
+  ///
+  void generate_external_rewr_function(std::ostream& m_stream, const rewr_function_spec& spec)
+  {
+    if (spec.arity() == 0)
+    {
+      m_stream << "  static inline const data_expression& " << spec.name() << "(RewriterCompilingJitty* this_rewriter) "
+                  "{ return jittyc_" << spec.name() << "(this_rewriter); }\n\n";
+      return;
     }
+
+    std::stringstream template_parameters;
+    std::stringstream parameters;
+    std::stringstream normal_form_parameters;
+    std::stringstream arguments;
+    std::stringstream indirect_arguments;
+    for (std::size_t i = 0; i < spec.arity(); ++i)
+    {
+      template_parameters << (i == 0 ? "" : ", ") << "class DATA_EXPR" << i;
+      parameters << "const DATA_EXPR" << i << "& arg" << i << ", ";
+      normal_form_parameters << "const data_expression& arg" << i << ", ";
+      arguments << "arg" << i << ", ";
+      indirect_arguments << "indirect_term(arg" << i << "), ";
+    }
+    m_stream << "  template < " << template_parameters.str() << ">\n"
+                "  static inline data_expression " << spec.name() << "(" << parameters.str() << "RewriterCompilingJitty* this_rewriter) "
+                "{ return jittyc_" << spec.name() << "_indirect(" << indirect_arguments.str() << "this_rewriter); }\n\n"
+                "  static inline data_expression " << spec.name() << "(" << normal_form_parameters.str() << "RewriterCompilingJitty* this_rewriter) "
+                "{ return jittyc_" << spec.name() << "(" << arguments.str() << "this_rewriter); }\n\n";
   }
 };
 
@@ -2430,9 +2573,10 @@ void RewriterCompilingJitty::CleanupRewriteSystem()
 ///        name clashes when more than one instance of the compiling rewriter run at the same
 ///        time.
 /// \param unique A number that will be incorporated into the filename.
+/// \param unit The number of the unit of the generated code that is stored in the file.
 /// \return A filename that should be used to store the generated C++ code in.
 ///
-static std::string generate_cpp_filename(std::size_t unique)
+static std::string generate_cpp_filename(std::size_t unique, std::size_t unit)
 {
   const char* env_dir = std::getenv("MCRL2_COMPILEDIR");
   std::ostringstream filename;
@@ -2449,10 +2593,111 @@ static std::string generate_cpp_filename(std::size_t unique)
   {
     filedir = "./";
   }
-  filename << filedir << "jittyc_" << getpid() << "_" << unique << ".cpp";
+  filename << filedir << "jittyc_" << getpid() << "_" << unique;
+  if (unit > 0)
+  {
+    filename << "_" << unit;
+  }
+  filename << ".cpp";
   return filename.str();
 }
 
+///
+/// \brief jittyc_cache_filename determines the file in which the compiled rewriter is kept
+///        for later runs, if the environment variable MCRL2_JITTYC_CACHEDIR is set. The name
+///        is derived from a hash of everything that determines the compiled rewriter, being
+///        the generated code, the terms it refers to, the compile script and the toolset version.
+/// \param units The generated C++ code.
+/// \param constants The terms that the generated code refers to.
+/// \param compile_script The script that is used to compile the generated code.
+/// \return The name of the file, or the empty string if compiled rewriters are not cached.
+///
+static std::string jittyc_cache_filename(const std::vector<std::string>& units,
+                                         const std::vector<data_expression>& constants,
+                                         const std::string& compile_script)
+{
+  const char* env_dir = std::getenv("MCRL2_JITTYC_CACHEDIR");
+  if (env_dir == nullptr || *env_dir == '\0')
+  {
+    return std::string();
+  }
+  std::string filedir = env_dir;
+  if (*filedir.rbegin() != '/')
+  {
+    filedir.append("/");
+  }
+
+  // The hash must be the same in every run, so instead of std::hash the FNV-1a hash is used.
+  std::uint64_t key = 14695981039346656037ULL;
+  auto add = [&key](const std::string& s)
+  {
+    for (const unsigned char c: s)
+    {
+      key = (key ^ c) * 1099511628211ULL;
+    }
+    key = (key ^ 0xff) * 1099511628211ULL; // Separates consecutive strings.
+  };
+
+  add(mcrl2::utilities::get_toolset_version());
+  add(compile_script);
+  std::ifstream script(compile_script);
+  if (script)
+  {
+    // The compiler flags are part of the compile script.
+    std::stringstream script_contents;
+    script_contents << script.rdbuf();
+    add(script_contents.str());
+  }
+  const char* env_compiler = std::getenv("CXX"); // The compile script uses $CXX if it is set.
+  add(env_compiler == nullptr ? "" : env_compiler);
+  for (const std::string& code: units)
+  {
+    add(code);
+  }
+  for (const data_expression& t: constants)
+  {
+    add(atermpp::pp(t));
+  }
+
+  std::ostringstream filename;
+  filename << filedir << "jittyc_" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+  return filename.str();
+}
+
+///
+/// \brief store_in_cache copies the compiled rewriter library to cache_file. As caching is an
+///        optimisation, failures are only reported as warnings.
+/// \param library The compiled rewriter.
+/// \param cache_file The file in which the compiled rewriter is kept, see jittyc_cache_filename.
+///
+static void store_in_cache(const std::string& library, const std::string& cache_file)
+{
+  std::ostringstream temporary_file;
+  temporary_file << cache_file << "." << getpid() << ".tmp";
+  {
+    std::ifstream in(library, std::ios::binary);
+    std::ofstream out(temporary_file.str(), std::ios::binary);
+    if (in && out)
+    {
+      out << in.rdbuf();
+      out.close();
+    }
+    if (!in || !out)
+    {
+      mCRL2log(warning) << "Could not store the compiled rewriter in " << cache_file << "." << std::endl;
+      std::remove(temporary_file.str().c_str());
+      return;
+    }
+  }
+
+  // Renaming makes the complete library appear at once, such that runs in parallel never load a partial library.
+  if (std::rename(temporary_file.str().c_str(), cache_file.c_str()) != 0)
+  {
+    mCRL2log(warning) << "Could not store the compiled rewriter in " << cache_file << ": " << std::strerror(errno) << "." << std::endl;
+    std::remove(temporary_file.str().c_str());
+  }
+}
+
 ///
 /// \brief filter_function_symbols selects the function symbols from source for which filter
 ///        returns true, and copies them to dest.
@@ -2504,10 +2749,33 @@ static void generate_make_appl_functions(std::ostream& s, std::size_t max_arity)
   }
 }
 
-void RewriterCompilingJitty::generate_code(const std::string& filename)
+///
+/// \brief jittyc_number_of_units determines over how many units the generated rewrite functions
+///        are divided. The units are compiled in parallel. The environment variable MCRL2_JITTYC_UNITS
+///        can be used to set the number of units.
+/// \param code_size The size of the code of the rewrite functions.
+/// \param number_of_functions The number of rewrite functions.
+///
+static std::size_t jittyc_number_of_units(const std::size_t code_size, const std::size_t number_of_functions)
+{
+  std::size_t result;
+  const char* env_units = std::getenv("MCRL2_JITTYC_UNITS");
+  if (env_units != nullptr)
+  {
+    result = std::strtoul(env_units, nullptr, 10);
+  }
+  else
+  {
+    // Every unit also compiles the preamble, which takes about as long as compiling this much generated
+    // code. Smaller units would spend most of their time on the preamble.
+    const std::size_t minimal_unit_size = 512 * 1024;
+    result = std::min<std::size_t>(std::thread::hardware_concurrency(), code_size / minimal_unit_size);
+  }
+  return std::max<std::size_t>(1, std::min(result, number_of_functions));
+}
+
+std::vector<std::string> RewriterCompilingJitty::generate_code()
 {
-  std::ofstream cpp_file(filename);
-  std::stringstream rewr_code;
   // arity_bound is one larger than the maximal arity. 
   arity_bound = 1+std::max(calc_max_arity(m_data_specification_for_enumeration.constructors()),
                            calc_max_arity(m_data_specification_for_enumeration.mappings()));
@@ -2529,66 +2797,198 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   functions_when_arguments_are_not_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
   functions_when_arguments_are_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
 
-  cpp_file << "#define INDEX_BOUND__ " << index_bound << "// These values are not used anymore.\n"
-              "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
-  cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
-
-  cpp_file << "namespace {\n"
-               "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
-               "// rewrite code.\n"
-               "\n"
-               "struct rewr_functions\n"
-               "{\n"
-
-               "  // A rewrite_term is a term that may or may not be in normal form. If the method\n"
-               "  // normal_form is invoked, it will calculate a normal form for itself as efficiently as possible.\n"
-               "  template <class REWRITE_TERM>\n"
-               "  static data_expression local_rewrite(const REWRITE_TERM& t, RewriterCompilingJitty* this_rewriter)\n"
-               "  {\n"
-               "    return t.normal_form();\n"
-               "  }\n"
-               "\n"
-               "  static const data_expression& local_rewrite(const data_expression& t, RewriterCompilingJitty* )\n"
-               "  {\n"
-               "    return t;\n"
-               "  }\n"
-               "\n";
-
-  rewr_code << "  // We're declaring static members in a struct rather than simple functions in\n"
-               "  // the global scope, so that we don't have to worry about forward declarations.\n";
-  code_generator.generate_rewr_functions(rewr_code);
-  rewr_code << "};\n"
-               "} // namespace\n";
-
-  generate_make_appl_functions(cpp_file, arity_bound);
-  code_generator.generate_delayed_application_functions(cpp_file);
-
-  cpp_file << rewr_code.str();
-
-  cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
-              "{\n";
-
-  // Fill tables with the rewrite functions
-  for (std::set<rewr_function_spec>::const_iterator
-            it = code_generator.implemented_rewrs().begin();
-            it != code_generator.implemented_rewrs().end(); ++it)
-  {
-    if (!it->delayed())
-    {
-      cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
-               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(it->fs())
-               << " + " << it->arity() << "] = rewr_functions::"
-               << it->name() << "_term;\n";
-      cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
-               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(it->fs())
-               << " + " << it->arity() << "] = rewr_functions::"
-               << it->name() << "_term_arg_in_normal_form;\n";
-    }
-  }
-
-
-  cpp_file << "}\n";
-  cpp_file.close();
+  std::vector<rewr_function_code> functions;
+  code_generator.generate_rewr_functions(functions);
+
+  std::stringstream common_code;
+  generate_make_appl_functions(common_code, arity_bound);
+  code_generator.generate_delayed_application_functions(common_code);
+  std::size_t code_size = 0;
+  std::size_t number_of_functions = 0;
+  for (const rewr_function_code& f: functions)
+  {
+    if (!f.spec.delayed())
+    {
+      code_size += f.code.size();
+      ++number_of_functions;
+    }
+  }
+
+  // The rewrite functions are divided in the order in which they are generated, as functions that call
+  // each other are often generated shortly after each other. A unit also contains the classes for delayed
+  // rewriting that its functions use, and for the functions of other units that they call, a function
+  // with the same name that calls the other unit.
+  const std::size_t number_of_units = jittyc_number_of_units(code_size, number_of_functions);
+  std::map<rewr_function_spec, std::size_t> unit_of;
+  std::size_t generated_size = 0;
+  for (const rewr_function_code& f: functions)
+  {
+    if (!f.spec.delayed())
+    {
+      unit_of.insert(std::make_pair(f.spec, (generated_size * number_of_units) / code_size));
+      generated_size += f.code.size();
+    }
+  }
+
+  std::vector<std::set<rewr_function_spec> > referenced_by_unit(number_of_units);
+  for (const rewr_function_code& f: functions)
+  {
+    if (!f.spec.delayed())
+    {
+      referenced_by_unit[unit_of[f.spec]].insert(f.referenced.begin(), f.referenced.end());
+    }
+  }
+  std::set<rewr_function_spec> called_by_other_units;
+  for (std::size_t unit = 0; unit < number_of_units; ++unit)
+  {
+    for (const rewr_function_code& f: functions)
+    {
+      if (f.spec.delayed() && referenced_by_unit[unit].count(f.spec) > 0)
+      {
+        referenced_by_unit[unit].insert(f.referenced.begin(), f.referenced.end());
+      }
+    }
+    for (const rewr_function_spec& spec: referenced_by_unit[unit])
+    {
+      if (!spec.delayed() && unit_of[spec] != unit)
+      {
+        called_by_other_units.insert(spec);
+      }
+    }
+  }
+
+  std::vector<std::string> units;
+  for (std::size_t unit = 0; unit < number_of_units; ++unit)
+  {
+    const std::set<rewr_function_spec>& referenced = referenced_by_unit[unit];
+    std::stringstream cpp_file;
+    if (unit > 0)
+    {
+      cpp_file << "#define MCRL2_JITTYC_ADDITIONAL_UNIT\n";
+    }
+    cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
+
+    if (number_of_units > 1)
+    {
+      cpp_file << "\n"
+                  "// The functions via which the rewrite functions of other units are called.\n";
+      for (const rewr_function_code& f: functions)
+      {
+        if (!f.spec.delayed() && unit_of[f.spec] != unit && referenced.count(f.spec) > 0)
+        {
+          code_generator.generate_entry_declarations(cpp_file, f.spec);
+        }
+      }
+      if (unit == 0)
+      {
+        for (std::size_t other_unit = 1; other_unit < number_of_units; ++other_unit)
+        {
+          cpp_file << "void set_the_precompiled_rewrite_functions_of_unit_" << other_unit << "(RewriterCompilingJitty* this_rewriter);\n";
+        }
+      }
+      cpp_file << "\n";
+    }
+
+    cpp_file << "namespace {\n"
+                 "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
+                 "// rewrite code.\n"
+                 "\n"
+                 "struct rewr_functions\n"
+                 "{\n"
+                 "  // The terms that the generated code refers to. Their addresses are filled in when the\n"
+                 "  // rewriter is loaded, such that the generated code does not depend on them.\n"
+                 "  static atermpp::detail::_aterm* constants[];\n"
+                 "\n"
+                 "  static const data_expression& constant(const std::size_t i)\n"
+                 "  {\n"
+                 "    return reinterpret_cast<const data_expression&>(constants[i]);\n"
+                 "  }\n"
+                 "\n"
+
+                 "  // A rewrite_term is a term that may or may not be in normal form. If the method\n"
+                 "  // normal_form is invoked, it will calculate a normal form for itself as efficiently as possible.\n"
+                 "  template <class REWRITE_TERM>\n"
+                 "  static data_expression local_rewrite(const REWRITE_TERM& t, RewriterCompilingJitty* this_rewriter)\n"
+                 "  {\n"
+                 "    return t.normal_form();\n"
+                 "  }\n"
+                 "\n"
+                 "  static const data_expression& local_rewrite(const data_expression& t, RewriterCompilingJitty* )\n"
+                 "  {\n"
+                 "    return t;\n"
+                 "  }\n"
+                 "\n";
+
+    cpp_file << common_code.str();
+
+    cpp_file << "  // We're declaring static members in a struct rather than simple functions in\n"
+                "  // the global scope, so that we don't have to worry about forward declarations.\n";
+    for (const rewr_function_code& f: functions)
+    {
+      if (f.spec.delayed() ? referenced.count(f.spec) > 0 : unit_of[f.spec] == unit)
+      {
+        cpp_file << f.code;
+      }
+      else if (!f.spec.delayed() && referenced.count(f.spec) > 0)
+      {
+        code_generator.generate_external_rewr_function(cpp_file, f.spec);
+      }
+    }
+    cpp_file << "};\n"
+                "\n"
+                "atermpp::detail::_aterm* rewr_functions::constants[" << std::max<std::size_t>(constants().size(), 1) << "];\n"
+                "} // namespace\n"
+                "\n";
+
+    for (const rewr_function_code& f: functions)
+    {
+      if (!f.spec.delayed() && unit_of[f.spec] == unit && called_by_other_units.count(f.spec) > 0)
+      {
+        code_generator.generate_entries(cpp_file, f.spec);
+      }
+    }
+
+    if (unit == 0)
+    {
+      cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n";
+    }
+    else
+    {
+      cpp_file << "void set_the_precompiled_rewrite_functions_of_unit_" << unit << "(RewriterCompilingJitty* this_rewriter)\n";
+    }
+    cpp_file << "{\n"
+                "  assert(this_rewriter->constants().size() == " << constants().size() << ");\n"
+                "  for (std::size_t i = 0; i < this_rewriter->constants().size(); ++i)\n"
+                "  {\n"
+                "    rewr_functions::constants[i] = atermpp::detail::address(this_rewriter->constants()[i]);\n"
+                "  }\n";
+
+    // Fill tables with the rewrite functions
+    for (const rewr_function_code& f: functions)
+    {
+      if (!f.spec.delayed() && unit_of[f.spec] == unit)
+      {
+        cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
+                 << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(f.spec.fs())
+                 << " + " << f.spec.arity() << "] = rewr_functions::"
+                 << f.spec.name() << "_term;\n";
+        cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
+                 << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(f.spec.fs())
+                 << " + " << f.spec.arity() << "] = rewr_functions::"
+                 << f.spec.name() << "_term_arg_in_normal_form;\n";
+      }
+    }
+    if (unit == 0)
+    {
+      for (std::size_t other_unit = 1; other_unit < number_of_units; ++other_unit)
+      {
+        cpp_file << "  set_the_precompiled_rewrite_functions_of_unit_" << other_unit << "(this_rewriter);\n";
+      }
+    }
+    cpp_file << "}\n";
+    units.push_back(cpp_file.str());
+  }
+  return units;
 }
 
 void RewriterCompilingJitty::BuildRewriteSystem()
@@ -2619,8 +3019,6 @@ void RewriterCompilingJitty::BuildRewriteSystem()
     compile_script = "mcrl2compilerewriter";
   }
 
-   rewriter_so = std::shared_ptr<uncompiled_library>(new uncompiled_library(compile_script));
-
   mCRL2log(verbose) << "using '" << compile_script << "' to compile rewriter." << std::endl;
   stopwatch time;
 
@@ -2630,23 +3028,54 @@ void RewriterCompilingJitty::BuildRewriteSystem()
     jittyc_eqns[down_cast<function_symbol>(get_nested_head(it->lhs()))].push_front(*it);
   }
 
-  std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
-  generate_code(cpp_file);
-
-  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
-  time.reset();
-
-  try
+  std::vector<std::string> units;
   {
-    rewriter_so->compile(cpp_file);
+    mcrl2::utilities::trace_span span("generate rewriter", "rewriter");
+    units = generate_code();
   }
-  catch(std::runtime_error& e)
+
+  // The compiled rewriter is only available when it is not taken from the cache.
+  std::shared_ptr<uncompiled_library> compiled_so;
+  const std::string cache_file = jittyc_cache_filename(units, constants(), compile_script);
+  if (!cache_file.empty() && mcrl2::utilities::file_exists(cache_file))
   {
-    rewriter_so->leave_files();
-    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    mCRL2log(verbose) << "generated rewriter in " << time.time() << "ms, loading the compiled rewriter " << cache_file << "..." << std::endl;
+    rewriter_so = std::shared_ptr<dynamic_library>(new dynamic_library(cache_file));
   }
+  else
+  {
+    std::vector<std::string> cpp_files;
+    for (std::size_t unit = 0; unit < units.size(); ++unit)
+    {
+      cpp_files.push_back(generate_cpp_filename(reinterpret_cast<std::size_t>(this), unit));
+      std::ofstream out(cpp_files.back());
+      out << units[unit];
+    }
 
-  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+    mCRL2log(verbose) << "generated " << cpp_files.front()
+                      << (cpp_files.size() > 1 ? " and " + std::to_string(cpp_files.size() - 1) + " more units" : std::string())
+                      << " in " << time.time() << "ms, compiling..." << std::endl;
+    time.reset();
+
+    compiled_so = std::shared_ptr<uncompiled_library>(new uncompiled_library(compile_script));
+    try
+    {
+      mcrl2::utilities::trace_span span("compile rewriter", "rewriter");
+      compiled_so->compile(cpp_files);
+    }
+    catch(std::runtime_error& e)
+    {
+      compiled_so->leave_files();
+      throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    }
+
+    mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+    if (!cache_file.empty())
+    {
+      store_in_cache(compiled_so->filename(), cache_file);
+    }
+    rewriter_so = compiled_so;
+  }
 
   bool (*init)(rewriter_interface*, RewriterCompilingJitty* this_rewriter);
   rewriter_interface interface = { mcrl2::utilities::get_toolset_version(), "Unknown error when loading rewriter.", this, NULL, NULL };
@@ -2657,20 +3086,26 @@ void RewriterCompilingJitty::BuildRewriteSystem()
   }
   catch(std::runtime_error& e)
   {
-    rewriter_so->leave_files();
+    if (compiled_so)
+    {
+      compiled_so->leave_files();
+    }
 #ifndef MCRL2_DISABLE_JITTYC_VERSION_CHECK
     throw mcrl2::runtime_error(std::string("Could not load rewriter: ") + e.what());
 #endif
   }
 
 #ifdef NDEBUG // In non debug mode clear compiled files directly after loading.
-  try
+  if (compiled_so)
   {
-    rewriter_so->cleanup();
-  }
-  catch (std::runtime_error& error)
-  {
-    mCRL2log(mcrl2::log::error) << "Could not cleanup temporary files: " << error.what() << std::endl;
+    try
+    {
+      compiled_so->cleanup();
+    }
+    catch (std::runtime_error& error)
+    {
+      mCRL2log(mcrl2::log::error) << "Could not cleanup temporary files: " << error.what() << std::endl;
+    }
   }
 #endif
 
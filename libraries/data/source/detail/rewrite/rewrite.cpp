@@ -20,6 +20,7 @@
 #include "mcrl2/data/data_specification.h"
 #include "mcrl2/data/detail/rewrite.h"
 #include "mcrl2/data/detail/rewrite/jitty.h"
+#include "mcrl2/data/detail/rewrite/jittyb.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 #ifdef MCRL2_JITTYC_AVAILABLE
 #include "mcrl2/data/detail/rewrite/jittyc.h"
@@ -473,6 +474,8 @@ std::shared_ptr<Rewriter> createRewriter(
   {
     case jitty:
       return std::shared_ptr<Rewriter>(new RewriterJitty(data_spec,equations_selector));
+    case jitty_bytecode:
+      return std::shared_ptr<Rewriter>(new RewriterJittyBytecode(data_spec,equations_selector));
 #ifdef MCRL2_JITTYC_AVAILABLE
     case jitty_compiling:
       return std::shared_ptr<Rewriter>(new RewriterCompilingJitty(data_spec,equations_selector));
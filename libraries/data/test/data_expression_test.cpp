@@ -19,6 +19,7 @@
 #include "mcrl2/data/bag.h"
 #include "mcrl2/data/basic_sort.h"
 #include "mcrl2/data/data_expression.h"
+#include "mcrl2/data/detail/term_heap_profile.h"
 #include "mcrl2/data/exists.h"
 #include "mcrl2/data/forall.h"
 #include "mcrl2/data/function_sort.h"
@@ -285,6 +286,32 @@ void system_defined_check()
   BOOST_CHECK(sort_list::empty(sort_pos::pos()) != sort_list::empty(sort_nat::nat()));
 }
 
+void heap_profile_test()
+{
+  basic_sort s("HeapProfileSort");
+  basic_sort t("HeapProfileTarget");
+  function_symbol f("heap_profile_f", make_function_sort(s, t));
+  variable x("heap_profile_x", s);
+  application fx(f, x);
+
+  BOOST_CHECK(detail::data_expression_sort_key(x) == s);
+  BOOST_CHECK(detail::data_expression_sort_key(f) == make_function_sort(s, t));
+  BOOST_CHECK(detail::data_expression_sort_key(fx) == t);
+  BOOST_CHECK(!detail::data_expression_sort_key(s).defined());
+
+  atermpp::term_heap_profile profile = detail::data_sort_heap_profile();
+  bool found = false;
+  for (const atermpp::term_heap_profile::entry& entry : profile.entries())
+  {
+    if (entry.name == "HeapProfileTarget")
+    {
+      BOOST_CHECK(entry.terms >= 1);
+      found = true;
+    }
+  }
+  BOOST_CHECK(found);
+}
+
 int test_main(int argc, char** argv)
 {
   variable_test();
@@ -309,6 +336,8 @@ int test_main(int argc, char** argv)
 
   assignment_test();
 
+  heap_profile_test();
+
   return EXIT_SUCCESS;
 }
 
@@ -478,6 +478,73 @@ BOOST_AUTO_TEST_CASE(enumerate_callback)
   BOOST_CHECK_EQUAL(enumerate(parse_data_expression("exists n: Nat. n < 2")), true_());
 }
 
+BOOST_AUTO_TEST_CASE(enumerate_with_solution_cache)
+{
+  typedef data::enumerator_list_element_with_substitution<data_expression> enumerator_element;
+  const std::string dataspec_text =
+          "sort D = struct d1(E) | d2(E);\n"
+          "     E = struct e1 | e2;      \n"
+          ;
+  data_specification dataspec = parse_data_specification(dataspec_text);
+  variable_list v = parse_variable_list("d: D;", dataspec);
+  variable x = parse_variable("x: D", dataspec);
+  data_expression phi = parse_data_expression("d != x", variable_list{ v.front(), x }, dataspec);
+  rewriter r(dataspec);
+  enumerator_identifier_generator id_generator;
+  data::enumerator_algorithm<rewriter> E(r, dataspec, r, id_generator, false);
+  data::enumerator_solution_cache<enumerator_element> cache(100);
+  data::mutable_indexed_substitution<> sigma;
+
+  // Returns the first max_solutions solutions of phi, with or without the cache.
+  auto enumerate = [&](bool use_cache, std::size_t max_solutions)
+  {
+    std::vector<std::string> result;
+    auto report_solution = [&](const enumerator_element& p)
+                           {
+                             result.push_back(data::pp(p.assign_expressions(v, r)));
+                             return result.size() == max_solutions;
+                           };
+    id_generator.clear();
+    if (use_cache)
+    {
+      E.enumerate(cache, enumerator_element(v, r(phi)), sigma, report_solution, is_false);
+    }
+    else
+    {
+      E.enumerate(enumerator_element(v, r(phi)), sigma, report_solution, is_false);
+    }
+    return core::detail::print_list(result);
+  };
+
+  sigma[x] = parse_data_expression("d1(e1)", dataspec);
+  std::string expected_result = enumerate(false, 0);
+  BOOST_CHECK_EQUAL(expected_result, "[ d1(e2), d2(e1), d2(e2) ]");
+  BOOST_CHECK_EQUAL(enumerate(true, 0), expected_result);
+  BOOST_CHECK_EQUAL(enumerate(true, 0), expected_result);
+  BOOST_CHECK_EQUAL(cache.metrics().hit_count(), 1u);
+  BOOST_CHECK_EQUAL(cache.metrics().miss_count(), 1u);
+
+  // The entry must not be reused for a different value of the free variable x.
+  sigma[x] = parse_data_expression("d2(e2)", dataspec);
+  BOOST_CHECK_EQUAL(enumerate(true, 0), enumerate(false, 0));
+  BOOST_CHECK_EQUAL(cache.metrics().miss_count(), 2u);
+
+  // An interrupted enumeration is resumed without reporting the cached solutions twice.
+  sigma[x] = parse_data_expression("d1(e2)", dataspec);
+  BOOST_CHECK_EQUAL(enumerate(true, 1), enumerate(false, 1));
+  BOOST_CHECK_EQUAL(enumerate(true, 2), enumerate(false, 2));
+  BOOST_CHECK_EQUAL(enumerate(true, 0), enumerate(false, 0));
+  BOOST_CHECK_EQUAL(cache.metrics().hit_count(), 3u);
+
+  // With a tiny memory budget only the most recent enumeration is kept.
+  data::enumerator_solution_cache<enumerator_element> small_cache(100, 1);
+  sigma[x] = parse_data_expression("d1(e1)", dataspec);
+  E.enumerate(small_cache, enumerator_element(v, r(phi)), sigma, [](const enumerator_element&) { return false; }, is_false);
+  E.enumerate(small_cache, enumerator_element(v, r(parse_data_expression("d == x", variable_list{ v.front(), x }, dataspec))), sigma, [](const enumerator_element&) { return false; }, is_false);
+  BOOST_CHECK_EQUAL(small_cache.size(), 1u);
+  BOOST_CHECK_EQUAL(small_cache.metrics().eviction_count(), 1u);
+}
+
 BOOST_AUTO_TEST_CASE(enumerate_expressions_test)
 {
   const std::string dataspec_text =
@@ -12,6 +12,7 @@
 #include "mcrl2/data/detail/data_functional.h"
 #include "mcrl2/data/detail/one_point_rule_preprocessor.h"
 #include "mcrl2/data/detail/parse_substitution.h"
+#include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/data/detail/test_rewriters.h"
 #include "mcrl2/data/find.h"
 #include "mcrl2/data/function_sort.h"
@@ -251,6 +252,35 @@ void test_enumeration_of_functions()
   test_expressions(R, expr1, expr2, "", data_spec, sigma);
 }
 
+// Closed normal forms are tagged in the term pool, terms with free variables are not, because their
+// normal form depends on the substitution.
+void test_normal_form_tags()
+{
+  data_specification data_spec;
+  data_spec.add_context_sort(sort_nat::nat());
+  data::variable_list variables = parse_variables("m, n: Pos;");
+  const variable m = atermpp::down_cast<variable>(parse_data_expression("m", variables));
+
+  for (const rewrite_strategy strategy: data::detail::get_test_rewrite_strategies(false))
+  {
+    rewriter r(data_spec, strategy);
+    const data_expression closed = r(parse_data_expression("2*3+7", variables, data_spec));
+    BOOST_CHECK(closed == r(parse_data_expression("13", variables, data_spec)));
+    BOOST_CHECK(atermpp::detail::address(closed)->normal_form_tag() != 0);
+    BOOST_CHECK(r(closed) == closed);
+
+    const data_expression open = parse_data_expression("m+n", variables, data_spec);
+    const data_expression open_result = r(open);
+    BOOST_CHECK(atermpp::detail::address(open_result)->normal_form_tag() == 0);
+
+    data::rewriter::substitution_type sigma;
+    sigma[m] = r(parse_data_expression("3", variables, data_spec));
+    BOOST_CHECK(r(open_result, sigma) == r(parse_data_expression("3+n", variables, data_spec)));
+    sigma[m] = r(parse_data_expression("5", variables, data_spec));
+    BOOST_CHECK(r(open_result, sigma) == r(parse_data_expression("5+n", variables, data_spec)));
+  }
+}
+
 int test_main(int argc, char** argv)
 {
   test1();
@@ -262,6 +292,7 @@ int test_main(int argc, char** argv)
   test_lambda_expression();
   test_equality_on_functions();
   test_enumeration_of_functions();
+  test_normal_form_tags();
 
   return 0;
 }
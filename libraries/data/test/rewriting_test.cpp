@@ -12,6 +12,7 @@
 #include "mcrl2/data/bag.h"
 #include "mcrl2/data/data_specification.h"
 #include "mcrl2/data/detail/data_functional.h"
+#include "mcrl2/data/detail/rewrite/machine_word_arithmetic.h"
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/data/find.h"
 #include "mcrl2/data/function_sort.h"
@@ -1512,9 +1513,74 @@ BOOST_AUTO_TEST_CASE(Check_normal_forms_in_function_update)   // In the jitty re
 }
 
 
+// The rewriters evaluate arithmetic on numerals that fit in a machine word directly. The results must be
+// the same as those of the rewrite rules, which the bytecode rewriter uses, also around overflow.
+BOOST_AUTO_TEST_CASE(machine_word_arithmetic_test)
+{
+  data_specification specification;
+  specification.add_context_sort(sort_int::int_());
+
+  const std::vector<std::string> values = { "-18446744073709551621", "-9223372036854775808", "-9223372036854775807",
+                                            "-4294967296", "-7", "-1", "0", "1", "2", "3", "12", "4294967295",
+                                            "4611686018427387904", "9223372036854775807", "9223372036854775808",
+                                            "18446744073709551621" };
+  std::map<sort_expression, data_expression_vector> numerals;
+  for (const std::string& v: values)
+  {
+    numerals[sort_int::int_()].push_back(sort_int::int_(v));
+    if (v[0] != '-')
+    {
+      numerals[sort_nat::nat()].push_back(sort_nat::nat(v));
+      if (v != "0")
+      {
+        numerals[sort_pos::pos()].push_back(sort_pos::pos(v));
+      }
+    }
+  }
 
+  BOOST_CHECK(machine_word_function(sort_nat::plus(sort_nat::nat(), sort_nat::nat())).is_defined());
+  BOOST_CHECK(machine_word_function(less(sort_int::int_())).is_defined());
+  BOOST_CHECK(!machine_word_function(sort_nat::swap_zero()).is_defined());
+  BOOST_CHECK(!machine_word_function(equal_to(sort_bool::bool_())).is_defined());
 
+  data::rewriter oracle(specification, jitty_bytecode);
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+  {
+    std::cerr << "  Strategy32: " << *strat << std::endl;
+    data::rewriter R(specification, *strat);
 
+    for (const function_symbol& f: specification.mappings())
+    {
+      if (!machine_word_function(f).is_defined())
+      {
+        continue;
+      }
+      const sort_expression_list& domain = atermpp::down_cast<function_sort>(f.sort()).domain();
+      const data_expression_vector& xs = numerals[domain.front()];
+      if (domain.size() == 1)
+      {
+        for (const data_expression& x: xs)
+        {
+          data_rewrite_test(R, application(f, x), oracle(application(f, x)));
+        }
+        continue;
+      }
+      for (const data_expression& x: xs)
+      {
+        for (const data_expression& y: numerals[domain.tail().front()])
+        {
+          // Exponents are kept small, as the rewrite rules compute the powers of large numbers.
+          if (f.name() == sort_nat::exp_name() && oracle(less(y, sort_nat::nat(65))) != sort_bool::true_())
+          {
+            continue;
+          }
+          data_rewrite_test(R, application(f, x, y), oracle(application(f, x, y)));
+        }
+      }
+    }
+  }
+}
 
 boost::unit_test::test_suite* init_unit_test_suite(int argc, char* argv[])
 {
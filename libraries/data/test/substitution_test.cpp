@@ -399,6 +399,53 @@ void test_mutable_indexed_substitution()
   BOOST_CHECK(s == "[b := true]");
 }
 
+// Assigns many variables with widely spread indices, such that the substitution
+// switches from a vector to a hash table, and back after clearing it.
+void test_mutable_indexed_substitution_with_many_variables()
+{
+  std::cout << "test_mutable_indexed_substitution_with_many_variables" << std::endl;
+  mutable_indexed_substitution<> sigma;
+  variable b = parse_variable("b: Nat");
+  data_expression one = parse_data_expression("1");
+
+  std::vector<variable> variables;
+  for (std::size_t i = 0; i < 5000; ++i)
+  {
+    variables.push_back(variable("x" + std::to_string(i), sort_nat::nat()));
+  }
+
+  for (std::size_t round = 0; round < 2; ++round)
+  {
+    sigma[b] = one;
+    for (std::size_t i = 0; i < variables.size(); i += 1000)
+    {
+      sigma[variables[i]] = sort_nat::plus(b, variables[i + 1]);
+    }
+    BOOST_CHECK(sigma.size() == 6);
+    BOOST_CHECK(sigma(b) == one);
+    BOOST_CHECK(sigma(variables[2000]) == sort_nat::plus(b, variables[2001]));
+    BOOST_CHECK(sigma(variables[2001]) == variables[2001]);
+    BOOST_CHECK(sigma.variable_occurs_in_a_rhs(b));
+    BOOST_CHECK(sigma.variable_occurs_in_a_rhs(variables[4001]));
+    BOOST_CHECK(!sigma.variable_occurs_in_a_rhs(variables[4000]));
+
+    // The occurrences of variables in the right hand sides are maintained incrementally.
+    sigma[variables[4000]] = variables[4000];
+    BOOST_CHECK(!sigma.variable_occurs_in_a_rhs(variables[4001]));
+    BOOST_CHECK(sigma.variable_occurs_in_a_rhs(b));
+    sigma[variables[3000]] = one;
+    BOOST_CHECK(!sigma.variable_occurs_in_a_rhs(variables[3001]));
+    BOOST_CHECK(sigma(variables[3000]) == one);
+    BOOST_CHECK(sigma.size() == 5);
+
+    sigma.clear();
+    BOOST_CHECK(sigma.empty());
+    BOOST_CHECK(sigma(b) == b);
+    BOOST_CHECK(sigma(variables[2000]) == variables[2000]);
+    BOOST_CHECK(!sigma.variable_occurs_in_a_rhs(b));
+  }
+}
+
 int test_main(int /* a */, char**  /* aa */)
 {
   test_my_assignment_sequence_substitution();
@@ -410,6 +457,7 @@ int test_main(int /* a */, char**  /* aa */)
   test_indexed_substitution();
   test_enumerator_substitution();
   test_mutable_indexed_substitution();
+  test_mutable_indexed_substitution_with_many_variables();
 
   return EXIT_SUCCESS;
 }
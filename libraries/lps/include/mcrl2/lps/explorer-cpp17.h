@@ -36,7 +36,10 @@
 #include "mcrl2/process/timed_multi_action.h"
 #include "mcrl2/utilities/detail/container_utility.h"
 #include "mcrl2/utilities/detail/io.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
+#include "mcrl2/utilities/indexed_set.h"
 #include "mcrl2/utilities/skip.h"
+#include "mcrl2/utilities/trace.h"
 #include "mcrl2/utilities/unused.h"
 
 namespace mcrl2::lps {
@@ -56,6 +59,26 @@ std::ostream& operator<<(std::ostream& os, caching c)
   return os;
 }
 
+// Estimates the number of bytes occupied by a cached enumeration result. The terms that are shared with
+// other terms are not counted, so only the list cells of the solutions are taken into account.
+struct summand_cache_entry_size
+{
+  std::size_t operator()(const atermpp::term_appl<data::data_expression>& key, const atermpp::term_list<data::data_expression_list>& solutions) const
+  {
+    // A list cell consists of a header, a head and a tail.
+    constexpr std::size_t list_cell_size = 3 * sizeof(atermpp::aterm);
+    std::size_t result = sizeof(key) + sizeof(solutions) + (key.size() + 1) * sizeof(atermpp::aterm);
+    for (const data::data_expression_list& e: solutions)
+    {
+      result += list_cell_size * (e.size() + 1);
+    }
+    return result;
+  }
+};
+
+// A bounded cache of enumeration results, that evicts the least recently used ones.
+typedef utilities::lru_cache<atermpp::term_appl<data::data_expression>, atermpp::term_list<data::data_expression_list>, summand_cache_entry_size> summand_cache;
+
 inline
 std::vector<data::data_expression> make_data_expression_vector(const data::data_expression_list& v)
 {
@@ -99,18 +122,46 @@ class todo_set
 
 class breadth_first_todo_set : public todo_set
 {
+  protected:
+    // The number of states of the current level that have not been chosen yet, and the
+    // moment at which the current level was started. They are used to trace the levels.
+    std::size_t m_level_remaining;
+    utilities::tracer::clock_type::time_point m_level_start;
+
+    void start_level()
+    {
+      m_level_remaining = todo.size();
+      m_level_start = utilities::tracer::clock_type::now();
+    }
+
   public:
     explicit breadth_first_todo_set(const state& init)
       : todo_set(init)
-    {}
+    {
+      start_level();
+    }
 
     template<typename ForwardIterator>
     breadth_first_todo_set(ForwardIterator first, ForwardIterator last)
       : todo_set(first, last)
-    {}
+    {
+      start_level();
+    }
+
+    ~breadth_first_todo_set() override
+    {
+      utilities::tracer::complete("level", "explorer", m_level_start);
+    }
 
     state choose_element() override
     {
+      if (m_level_remaining == 0)
+      {
+        utilities::tracer::complete("level", "explorer", m_level_start);
+        utilities::tracer::counter("todo", static_cast<std::int64_t>(todo.size()));
+        start_level();
+      }
+      m_level_remaining--;
       auto s = todo.front();
       todo.pop_front();
       return s;
@@ -253,17 +304,18 @@ struct explorer_summand
   caching cache_strategy;
   std::vector<data::variable> gamma;
   atermpp::function_symbol f_gamma;
-  mutable std::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> local_cache;
+  mutable summand_cache local_cache;
 
   template <typename ActionSummand>
-  explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_)
+  explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_, std::size_t cache_memory = 0)
     : variables(summand.summation_variables()),
       condition(summand.condition()),
       multi_action(summand.multi_action().actions(), summand.multi_action().time()),
       distribution(summand_distribution(summand)),
       next_state(make_data_expression_vector(summand.next_state(process_parameters))),
       index(summand_index),
-      cache_strategy(cache_strategy_)
+      cache_strategy(cache_strategy_),
+      local_cache(0, cache_strategy_ == caching::local ? cache_memory : 0)
   {
     gamma = free_variables(summand.condition(), process_parameters);
     if (cache_strategy_ == caching::global)
@@ -373,8 +425,8 @@ class explorer: public abortable
     volatile bool m_must_abort = false;
 
     // N.B. The keys are stored in term_appl instead of data_expression_list for performance reasons.
-    std::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> global_cache;
-    std::unordered_map<state, std::size_t> m_discovered;
+    summand_cache global_cache;
+    utilities::indexed_set<state> m_discovered;
 
     // used by make_timed_state, to avoid needless creation of vectors
     mutable std::vector<data::data_expression> timed_state;
@@ -619,7 +671,7 @@ class explorer: public abortable
         if (q == cache.end())
         {
           data::data_expression condition = m_rewr(summand.condition, m_sigma);
-          std::list<data::data_expression_list> solutions;
+          std::vector<data::data_expression_list> solutions;
           if (!data::is_false(condition))
           {
             m_enumerator.enumerate(enumerator_element(summand.variables, condition),
@@ -632,9 +684,11 @@ class explorer: public abortable
                         data::is_false
             );
           }
-          q = cache.insert({key, solutions}).first;
+          q = cache.emplace(key, atermpp::term_list<data::data_expression_list>(solutions.begin(), solutions.end())).first;
         }
-        for (const data::data_expression_list& e: q->second)
+        // The solutions are copied, as the cache entry can be evicted while the transitions are reported.
+        const atermpp::term_list<data::data_expression_list> solutions = q->second;
+        for (const data::data_expression_list& e: solutions)
         {
           data::add_assignments(m_sigma, summand.variables, e);
           process::timed_multi_action a = rewrite_action(summand.multi_action);
@@ -760,7 +814,8 @@ class explorer: public abortable
         m_rewr(lpsspec.data(),
           data::used_data_equation_selector(lpsspec.data(), add_real_operators(lps::find_function_symbols(lpsspec)), lpsspec.global_variables()),
           m_options.rewrite_strategy),
-        m_enumerator(m_rewr, lpsspec.data(), m_rewr, m_id_generator, false)
+        m_enumerator(m_rewr, lpsspec.data(), m_rewr, m_id_generator, false),
+        global_cache(0, m_options.cached && m_options.global_cache ? m_options.cache_memory * 1024 * 1024 : 0)
     {
       Specification lpsspec_ = preprocess(lpsspec);
       const auto& params = lpsspec_.process().process_parameters();
@@ -771,17 +826,23 @@ class explorer: public abortable
       m_initial_distribution = initial_distribution(lpsspec_);
       core::identifier_string ctau{"ctau"};
       const auto& lpsspec_summands = lpsspec_.process().action_summands();
+      // The local caches share the memory budget equally.
+      std::size_t local_cache_memory = lpsspec_summands.empty() ? 0 : m_options.cache_memory * 1024 * 1024 / lpsspec_summands.size();
+      if (m_options.cache_memory > 0 && local_cache_memory == 0)
+      {
+        local_cache_memory = 1;
+      }
       for (std::size_t i = 0; i < lpsspec_summands.size(); i++)
       {
         const auto& summand = lpsspec_summands[i];
         auto cache_strategy = m_options.cached ? (m_options.global_cache ? lps::caching::global : lps::caching::local) : lps::caching::none;
         if (summand.multi_action().actions().size() == 1 && summand.multi_action().actions().front().label().name() == ctau)
         {
-          m_confluent_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy);
+          m_confluent_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy, local_cache_memory);
         }
         else
         {
-          m_regular_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy);
+          m_regular_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy, local_cache_memory);
         }
       }
     }
@@ -828,7 +889,7 @@ class explorer: public abortable
       const StateType& s0,
       const SummandSequence& regular_summands,
       const SummandSequence& confluent_summands,
-      std::unordered_map<state, std::size_t>& discovered,
+      utilities::indexed_set<state>& discovered,
       DiscoverState discover_state = DiscoverState(),
       ExamineTransition examine_transition = ExamineTransition(),
       StartState start_state = StartState(),
@@ -856,7 +917,7 @@ class explorer: public abortable
           if (j == discovered.end())
           {
             std::size_t s_index = discovered.size();
-            j = discovered.insert(std::make_pair(s, s_index)).first;
+            j = discovered.insert(s).first;
             discover_state(s, s_index);
           }
           s0_index.push_back(j->second);
@@ -867,7 +928,7 @@ class explorer: public abortable
       {
         todo = make_todo_set(s0);
         std::size_t s0_index = 0;
-        discovered.insert(std::make_pair(s0, s0_index));
+        discovered.insert(s0);
         discover_state(s0, s0_index);
       }
 
@@ -904,7 +965,7 @@ class explorer: public abortable
                   {
                     todo->insert(s1_);
                     std::size_t k = discovered.size();
-                    j = discovered.insert(std::make_pair(s1_, k)).first;
+                    j = discovered.insert(s1_).first;
                     discover_state(s1_, k);
                   }
                   s1_index.push_back(j->second);
@@ -922,13 +983,13 @@ class explorer: public abortable
                     const data::data_expression& t = s[m_n];
                     data::data_expression t1 = a.has_time() ? a.time() : t;
                     state s1_at_t1 = make_timed_state(s1, t1);
-                    j = discovered.insert(std::make_pair(s1_at_t1, k)).first;
+                    j = discovered.insert(s1_at_t1).first;
                     discover_state(s1_at_t1, k);
                     todo->insert(s1_at_t1);
                   }
                   else
                   {
-                    j = discovered.insert(std::make_pair(s1, k)).first;
+                    j = discovered.insert(s1).first;
                     discover_state(s1, k);
                     todo->insert(s1);
                   }
@@ -1273,8 +1334,23 @@ class explorer: public abortable
       m_must_abort = true;
     }
 
+    /// \brief Returns the accumulated hits, misses and evictions of the enumeration caches.
+    utilities::cache_metric cache_metrics() const
+    {
+      utilities::cache_metric result = global_cache.metrics();
+      for (const explorer_summand& summand: m_regular_summands)
+      {
+        result += summand.local_cache.metrics();
+      }
+      for (const explorer_summand& summand: m_confluent_summands)
+      {
+        result += summand.local_cache.metrics();
+      }
+      return result;
+    }
+
     /// \brief Returns a mapping containing all discovered states.
-    const std::unordered_map<state, std::size_t>& state_map() const
+    const utilities::indexed_set<state>& state_map() const
     {
       return m_discovered;
     }
@@ -16,6 +16,7 @@
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lps/exploration_strategy.h"
 #include "mcrl2/process/action_parse.h"
+#include "mcrl2/utilities/execution_timer.h"
 
 namespace mcrl2
 {
@@ -68,6 +69,8 @@ class lts_generation_options
     bool use_summand_pruning;
     std::set< mcrl2::core::identifier_string > actions_internal_for_divergencies;
 
+    utilities::execution_timer* timer; // if it is non-zero, the phases of the generation are timed
+
     /// \brief Constructor
     lts_generation_options() :
       usedummies(true),
@@ -90,7 +93,8 @@ class lts_generation_options
       detect_divergence(false),
       detect_action(false),
       use_enumeration_caching(false),
-      use_summand_pruning(false)
+      use_summand_pruning(false),
+      timer(nullptr)
     {}
 
     /// \brief Copy assignment operator.
@@ -52,7 +52,7 @@ struct lts_builder
   virtual void add_transition(std::size_t from, const process::timed_multi_action& a, std::size_t to) = 0;
 
   // Add actions and states to the LTS
-  virtual void finalize(const std::unordered_map<lps::state, std::size_t>& state_map) = 0;
+  virtual void finalize(const utilities::indexed_set<lps::state>& state_map) = 0;
 
   // Save the LTS to a file
   virtual void save(const std::string& filename) = 0;
@@ -66,7 +66,7 @@ class lts_none_builder: public lts_builder
     void add_transition(std::size_t /* from */, const process::timed_multi_action& /* a */, std::size_t /* to */) override
     {}
 
-    void finalize(const std::unordered_map<lps::state, std::size_t>& /* state_map */) override
+    void finalize(const utilities::indexed_set<lps::state>& /* state_map */) override
     {}
 
     void save(const std::string& /* filename */) override
@@ -88,7 +88,7 @@ class lts_aut_builder: public lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const std::unordered_map<lps::state, std::size_t>& state_map) override
+    void finalize(const utilities::indexed_set<lps::state>& state_map) override
     {
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
@@ -131,7 +131,7 @@ class lts_aut_disk_builder: public lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const std::unordered_map<lps::state, std::size_t>& state_map) override
+    void finalize(const utilities::indexed_set<lps::state>& state_map) override
     {
       out.flush();
       out.seekp(0);
@@ -163,7 +163,7 @@ class lts_lts_builder: public lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const std::unordered_map<lps::state, std::size_t>& state_map) override
+    void finalize(const utilities::indexed_set<lps::state>& state_map) override
     {
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
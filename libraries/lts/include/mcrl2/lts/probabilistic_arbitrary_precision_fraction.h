@@ -258,22 +258,7 @@ class probabilistic_arbitrary_precision_fraction
                                                utilities::big_natural_number& buffer_remainder,
                                                utilities::big_natural_number& buffer)
     {
-      if (x.is_zero()) { x=y; return; }
-      if (y.is_zero()) { return; } // The answer is x. 
-      if (x>y)
-      {
-        utilities::swap(x,y);
-      }
-      // utilities::big_natural_number remainder=y % x;
-      y.div_mod(x,buffer_divide,buffer_remainder,buffer);  // buffer_remainder contains remainder.
-      while (!buffer_remainder.is_zero())
-      {
-        y=x;
-        x=buffer_remainder;
-        // remainder=y % x;
-        y.div_mod(x,buffer_divide,buffer_remainder,buffer);
-      }
-      return;  // the value x is now the result.
+      x.greatest_common_divisor(y,buffer_divide,buffer_remainder,buffer);
     }
 
     // \detail An algorithm to calculate the greatest common divisor.
@@ -292,6 +277,20 @@ class probabilistic_arbitrary_precision_fraction
       denominator=denominator/gcd;
       assert(greatest_common_divisor(enumerator,denominator).is_number(1)); */
 
+      if (enumerator.is_single_digit() && denominator.is_single_digit())
+      {
+        // Most probabilities are small fractions, for which machine arithmetic suffices. 
+        const std::size_t e=static_cast<std::size_t>(enumerator);
+        const std::size_t d=static_cast<std::size_t>(denominator);
+        const std::size_t gcd=utilities::detail::greatest_common_divisor_single_number(e,d);
+        if (gcd>1)
+        {
+          enumerator=utilities::big_natural_number(e/gcd);
+          denominator=utilities::big_natural_number(d/gcd);
+        }
+        return;
+      }
+
       static utilities::big_natural_number enumerator_copy, denominator_copy, gcd, buffer1, buffer2,buffer3;
       gcd=enumerator;
       enumerator_copy=enumerator;
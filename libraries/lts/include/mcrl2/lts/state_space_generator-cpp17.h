@@ -704,6 +704,10 @@ struct state_space_generator
         }
       );
       m_progress_monitor.finish_exploration(explorer.state_map().size());
+      if (options.cached)
+      {
+        mCRL2log(log::verbose) << "Enumeration cache: " << explorer.cache_metrics().message() << std::endl;
+      }
       builder.finalize(explorer.state_map());
     }
     catch (const data::enumerator_error& e)
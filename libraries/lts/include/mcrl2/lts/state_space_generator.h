@@ -385,7 +385,7 @@ class divergence_detector
         return false;
       }
 
-      std::unordered_map<lps::state, std::size_t> discovered;
+      utilities::indexed_set<lps::state> discovered;
       const lps::state* source = nullptr;
       lps::state last_discovered;
 
@@ -625,6 +625,10 @@ struct state_space_generator
         }
       );
       m_progress_monitor.finish_exploration(explorer.state_map().size());
+      if (options.cached)
+      {
+        mCRL2log(log::verbose) << "Enumeration cache: " << explorer.cache_metrics().message() << std::endl;
+      }
       builder.finalize(explorer.state_map());
     }
     catch (const data::enumerator_error& e)
@@ -744,6 +748,10 @@ struct stochastic_state_space_generator
         }
       );
       m_progress_monitor.finish_exploration(explorer.state_map().size());
+      if (options.cached)
+      {
+        mCRL2log(log::verbose) << "Enumeration cache: " << explorer.cache_metrics().message() << std::endl;
+      }
       builder.finalize(explorer.state_map());
     }
     catch (const data::enumerator_error& e)
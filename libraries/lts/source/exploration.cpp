@@ -10,6 +10,7 @@
 #include <ctime>
 
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/trace.h"
 #include "mcrl2/lps/resolve_name_clashes.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/lps/probabilistic_data_expression.h"
@@ -303,7 +304,17 @@ void set_seed_random_generator()
 
 bool lps2lts_algorithm::generate_lts(const lts_generation_options& options)
 {
+  // The rewriter is created, and compiled for jittyc, during the initialisation.
+  if (options.timer != nullptr)
+  {
+    options.timer->start("initialise");
+  }
   initialise_lts_generation(options);
+  if (options.timer != nullptr)
+  {
+    options.timer->finish("initialise");
+    options.timer->start("explore");
+  }
   // First generate a vector of initial states from the initial distribution.
   m_initial_states=m_generator->initial_states();
   assert(!m_initial_states.empty());
@@ -406,7 +417,16 @@ bool lps2lts_algorithm::generate_lts(const lts_generation_options& options)
     return false;
   }
 
+  if (options.timer != nullptr)
+  {
+    options.timer->finish("explore");
+    options.timer->start("write");
+  }
   finalise_lts_generation();
+  if (options.timer != nullptr)
+  {
+    options.timer->finish("write");
+  }
   return true;
 }
 
@@ -1123,6 +1143,7 @@ void lps2lts_algorithm::generate_lts_breadth_todo_max_is_npos()
   std::vector<next_state_generator::transition_t> transitions;
   time_t last_log_time = time(nullptr) - 1, new_log_time;
   next_state_generator::enumerator_queue_t enumeration_queue;
+  utilities::tracer::clock_type::time_point level_start = utilities::tracer::clock_type::now();
 
   while (!m_must_abort && (current_state < m_state_numbers.size()) &&
          (current_state < m_options.max_states) && (!m_options.trace || m_traces_saved < m_options.max_traces))
@@ -1139,6 +1160,9 @@ void lps2lts_algorithm::generate_lts_breadth_todo_max_is_npos()
     if (current_state == start_level_seen)
     {
       mCRL2log(debug) << "Number of states at level " << m_level << " is " << m_num_states - start_level_seen << "\n";
+      utilities::tracer::complete("level", "exploration", level_start);
+      utilities::tracer::counter("states", static_cast<std::int64_t>(m_num_states));
+      level_start = utilities::tracer::clock_type::now();
       m_level++;
       start_level_seen = m_num_states;
       start_level_transitions = m_num_transitions;
@@ -1181,6 +1205,7 @@ void lps2lts_algorithm::generate_lts_breadth_todo_max_is_not_npos(const next_sta
   state_queue.swap_queues();
   std::vector<next_state_generator::transition_t> transitions;
   next_state_generator::enumerator_queue_t enumeration_queue;
+  utilities::tracer::clock_type::time_point level_start = utilities::tracer::clock_type::now();
 
   while (!m_must_abort && (state_queue.remaining() > 0) &&
          (current_state < m_options.max_states) && (!m_options.trace || m_traces_saved < m_options.max_traces))
@@ -1201,6 +1226,9 @@ void lps2lts_algorithm::generate_lts_breadth_todo_max_is_not_npos(const next_sta
     if (state_queue.remaining() == 0)
     {
       state_queue.swap_queues();
+      utilities::tracer::complete("level", "exploration", level_start);
+      utilities::tracer::counter("states", static_cast<std::int64_t>(m_num_states));
+      level_start = utilities::tracer::clock_type::now();
 
       if (!m_options.suppress_progress_messages)
       {
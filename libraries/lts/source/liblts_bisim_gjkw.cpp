@@ -27,6 +27,7 @@
 #include "mcrl2/lts/lts_fsm.h"
 #include "mcrl2/lts/transition.h"
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/utilities/trace.h"
 
 #define PARANOID_CHECK
 
@@ -2007,9 +2008,11 @@ void bisim_partitioner_gjkw<LTS_TYPE>::
 
         part_tr.assert_stability(part_st);
     #endif
+    utilities::trace_span refinement_span("refine partition", "bisimulation");
     // 2.4: while C contains a nontrivial constellation SpC do
     while (nullptr != bisim_gjkw::constln_t::get_some_nontrivial())
     {
+        utilities::trace_span round_span("refinement round", "bisimulation");
         // check_complexity::add_work is called below, after SpB has been found
         bisim_gjkw::constln_t* const SpC =
                                   bisim_gjkw::constln_t::get_some_nontrivial();
@@ -13,6 +13,7 @@
 #define MCRL2_PBES_ENUMERATOR_H
 
 #include "mcrl2/data/enumerator.h"
+#include "mcrl2/pbes/find.h"
 #include "mcrl2/pbes/pbes_expression.h"
 
 namespace mcrl2 {
@@ -35,6 +36,18 @@ struct is_not_true
   }
 };
 
+/// \brief Computes the free variables of a PBES expression, for the enumerator solution cache.
+struct find_free_pbes_variables
+{
+  std::set<data::variable> operator()(const pbes_expression& x) const
+  {
+    return pbes_system::find_free_variables(x);
+  }
+};
+
+/// \brief A cache of enumerations of PBES expressions.
+typedef data::enumerator_solution_cache<data::enumerator_list_element<pbes_expression>, find_free_pbes_variables> enumerator_solution_cache;
+
 } // namespace pbes_system
 
 } // namespace mcrl2
@@ -25,6 +25,7 @@
 #include "mcrl2/pbes/rewriters/enumerate_quantifiers_rewriter.h"
 #include "mcrl2/pbes/search_strategy.h"
 #include "mcrl2/pbes/transformation_strategy.h"
+#include "mcrl2/utilities/trace.h"
 #include <cassert>
 #include <ctime>
 #include <deque>
@@ -604,8 +605,10 @@ class pbesinst_alternative_lazy_algorithm
 
       init = atermpp::down_cast<propositional_variable_instantiation>(R(p.initial_state()));
       add_todo(init);
+      utilities::trace_span run_span("instantiate", "pbesinst");
       while (!todo.empty())
       {
+        utilities::trace_span iteration_span("iteration", "pbesinst");
         const propositional_variable_instantiation X_e = next_todo();
         std::size_t index = equation_index[X_e.name()];
         instantiations[index].push_back(X_e);
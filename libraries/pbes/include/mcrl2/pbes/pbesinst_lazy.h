@@ -36,6 +36,7 @@
 #include "mcrl2/pbes/transformations.h"
 #include "mcrl2/utilities/detail/container_utility.h"
 #include "mcrl2/utilities/text_utility.h"
+#include "mcrl2/utilities/trace.h"
 
 #ifndef MCRL2_PBES_PBESINST_LAZY_H
 #define MCRL2_PBES_PBESINST_LAZY_H
@@ -287,7 +288,7 @@ class pbesinst_lazy_algorithm
        datar(p.data(), data::used_data_equation_selector(p.data(), pbes_system::find_function_symbols(p), p.global_variables()), options.rewrite_strategy),
        m_pbes(preprocess(p)),
        m_equation_index(p),
-       R(datar, p.data())
+       R(datar, p.data(), true, options.enumeration_cache_size)
     { }
 
     virtual ~pbesinst_lazy_algorithm() = default;
@@ -355,10 +356,16 @@ class pbesinst_lazy_algorithm
       init = atermpp::down_cast<propositional_variable_instantiation>(R(m_pbes.initial_state(), sigma));
       todo.insert(init);
       discovered.insert(init);
+      utilities::trace_span run_span("instantiate", "pbesinst");
       while (!todo.elements().empty())
       {
+        utilities::trace_span iteration_span("iteration", "pbesinst");
         ++m_iteration_count;
         mCRL2log(log::status) << print_equation_count(m_iteration_count);
+        if (m_iteration_count % 1000 == 0)
+        {
+          utilities::tracer::counter("todo", static_cast<std::int64_t>(todo.size()));
+        }
         detail::check_bes_equation_limit(m_iteration_count);
 
         propositional_variable_instantiation X_e = next_todo();
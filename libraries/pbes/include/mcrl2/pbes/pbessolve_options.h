@@ -36,6 +36,9 @@ struct pbessolve_options
   bool check_strategy = false;
 
   bool prune_todo_alternative = false;
+
+  // the maximum number of cached quantifier enumerations, where zero disables the cache
+  std::size_t enumeration_cache_size = 0;
 };
 
 inline
@@ -49,6 +52,7 @@ std::ostream& operator<<(std::ostream& out, const pbessolve_options& options)
   out << "aggressive = " << std::boolalpha << options.aggressive << std::endl;
   out << "check-strategy = " << std::boolalpha << options.check_strategy << std::endl;
   out << "prune-todo-alternative = " << std::boolalpha << options.prune_todo_alternative << std::endl;
+  out << "enumeration-cache-size = " << options.enumeration_cache_size << std::endl;
   return out;
 }
 
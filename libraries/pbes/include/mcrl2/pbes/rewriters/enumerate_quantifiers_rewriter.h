@@ -20,6 +20,7 @@
 #include "mcrl2/pbes/rewriters/simplify_rewriter.h"
 #include "mcrl2/utilities/detail/join.h"
 #include <deque>
+#include <memory>
 #include <numeric>
 #include <set>
 #include <sstream>
@@ -54,18 +55,27 @@ struct enumerate_quantifiers_builder: public simplify_data_rewriter_builder<Deri
   /// The enumerator
   data::enumerator_algorithm<self> E;
 
+  /// Optional caches of the enumerations of universal and existential quantifiers
+  enumerator_solution_cache* m_forall_cache;
+  enumerator_solution_cache* m_exists_cache;
+
   /// \brief Constructor.
   /// \param r A data rewriter.
   /// \param sigma A mutable substitution.
   /// \param dataspec A data specification.
   /// \param id_generator A generator to generate fresh variable names.
   /// \param enumerate_infinite_sorts If true, quantifier variables of infinite sort are enumerated as well.
+  /// \param forall_cache If not nullptr, the enumerations of universal quantifiers are cached in it.
+  /// \param exists_cache If not nullptr, the enumerations of existential quantifiers are cached in it.
   enumerate_quantifiers_builder(const DataRewriter& r,
                                 MutableSubstitution& sigma,
                                 const data::data_specification& dataspec,
                                 data::enumerator_identifier_generator& id_generator,
-                                bool enumerate_infinite_sorts = true)
-    : super(r, sigma), m_dataspec(dataspec), m_enumerate_infinite_sorts(enumerate_infinite_sorts), E(*this, m_dataspec, r, id_generator, (std::numeric_limits<std::size_t>::max)())
+                                bool enumerate_infinite_sorts = true,
+                                enumerator_solution_cache* forall_cache = nullptr,
+                                enumerator_solution_cache* exists_cache = nullptr)
+    : super(r, sigma), m_dataspec(dataspec), m_enumerate_infinite_sorts(enumerate_infinite_sorts), E(*this, m_dataspec, r, id_generator, (std::numeric_limits<std::size_t>::max)()),
+      m_forall_cache(forall_cache), m_exists_cache(exists_cache)
   {
     id_generator.clear();
   }
@@ -101,16 +111,19 @@ struct enumerate_quantifiers_builder: public simplify_data_rewriter_builder<Deri
   {
     auto undo = undo_substitution(v);
     pbes_expression result = true_();
-    E.enumerate(enumerator_element(v, derived().apply(phi)),
-                sigma,
-                [&](const enumerator_element& p)
-                {
-                  result = data::optimized_and(result, p.expression());
-                  return is_false(result);
-                },
-                is_true,
-                is_false
-               );
+    auto report_solution = [&](const enumerator_element& p)
+                           {
+                             result = data::optimized_and(result, p.expression());
+                             return is_false(result);
+                           };
+    if (m_forall_cache)
+    {
+      E.enumerate(*m_forall_cache, enumerator_element(v, derived().apply(phi)), sigma, report_solution, is_true, is_false);
+    }
+    else
+    {
+      E.enumerate(enumerator_element(v, derived().apply(phi)), sigma, report_solution, is_true, is_false);
+    }
 
     redo_substitution(v, undo);
     return result;
@@ -120,16 +133,19 @@ struct enumerate_quantifiers_builder: public simplify_data_rewriter_builder<Deri
   {
     auto undo = undo_substitution(v);
     pbes_expression result = false_();
-    E.enumerate(enumerator_element(v, derived().apply(phi)),
-                sigma,
-                [&](const enumerator_element& p)
-                {
-                  result = data::optimized_or(result, p.expression());
-                  return is_true(result);
-                },
-                is_false,
-                is_true
-    );
+    auto report_solution = [&](const enumerator_element& p)
+                           {
+                             result = data::optimized_or(result, p.expression());
+                             return is_true(result);
+                           };
+    if (m_exists_cache)
+    {
+      E.enumerate(*m_exists_cache, enumerator_element(v, derived().apply(phi)), sigma, report_solution, is_false, is_true);
+    }
+    else
+    {
+      E.enumerate(enumerator_element(v, derived().apply(phi)), sigma, report_solution, is_false, is_true);
+    }
 
     redo_substitution(v, undo);
     return result;
@@ -205,8 +221,9 @@ struct apply_enumerate_builder: public Builder<apply_enumerate_builder<Builder,
   using super::enter;
   using super::leave;
 
-  apply_enumerate_builder(const DataRewriter& R, MutableSubstitution& sigma, const data::data_specification& dataspec, data::enumerator_identifier_generator& id_generator, bool enumerate_infinite_sorts)
-    : super(R, sigma, dataspec, id_generator, enumerate_infinite_sorts)
+  apply_enumerate_builder(const DataRewriter& R, MutableSubstitution& sigma, const data::data_specification& dataspec, data::enumerator_identifier_generator& id_generator, bool enumerate_infinite_sorts,
+                          enumerator_solution_cache* forall_cache = nullptr, enumerator_solution_cache* exists_cache = nullptr)
+    : super(R, sigma, dataspec, id_generator, enumerate_infinite_sorts, forall_cache, exists_cache)
   {}
 };
 
@@ -233,25 +250,48 @@ struct enumerate_quantifiers_rewriter
 
   mutable data::enumerator_identifier_generator m_id_generator;
 
+  /// \brief Caches of the enumerations of universal and existential quantifiers, that are shared by copies of the rewriter.
+  std::shared_ptr<enumerator_solution_cache> m_forall_cache;
+  std::shared_ptr<enumerator_solution_cache> m_exists_cache;
+
   typedef pbes_expression term_type;
   typedef data::variable variable_type;
 
-  enumerate_quantifiers_rewriter(const data::rewriter& R, const data::data_specification& dataspec, bool enumerate_infinite_sorts = true)
+  /// \param enumeration_cache_size The maximum number of cached enumerations per kind of quantifier, where zero disables caching.
+  enumerate_quantifiers_rewriter(const data::rewriter& R, const data::data_specification& dataspec, bool enumerate_infinite_sorts = true, std::size_t enumeration_cache_size = 0)
     : m_rewriter(R), m_dataspec(dataspec), m_enumerate_infinite_sorts(enumerate_infinite_sorts)
-  {}
+  {
+    if (enumeration_cache_size > 0)
+    {
+      m_forall_cache = std::make_shared<enumerator_solution_cache>(enumeration_cache_size);
+      m_exists_cache = std::make_shared<enumerator_solution_cache>(enumeration_cache_size);
+    }
+  }
 
   pbes_expression operator()(const pbes_expression& x) const
   {
     data::rewriter::substitution_type sigma;
     m_id_generator.clear();
-    return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, data::rewriter::substitution_type>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts).apply(x);
+    return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, data::rewriter::substitution_type>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts, m_forall_cache.get(), m_exists_cache.get()).apply(x);
   }
 
   template <typename MutableSubstitution>
   pbes_expression operator()(const pbes_expression& x, MutableSubstitution& sigma) const
   {
     m_id_generator.clear();
-    return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, MutableSubstitution>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts).apply(x);
+    return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, MutableSubstitution>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts, m_forall_cache.get(), m_exists_cache.get()).apply(x);
+  }
+
+  /// \returns The accumulated hits, misses and evictions of the enumeration caches.
+  utilities::cache_metric enumeration_cache_metrics() const
+  {
+    utilities::cache_metric result;
+    if (m_forall_cache)
+    {
+      result += m_forall_cache->metrics();
+      result += m_exists_cache->metrics();
+    }
+    return result;
   }
 };
 
@@ -14,6 +14,7 @@
 
 #include "mcrl2/pbes/structure_graph.h"
 #include "mcrl2/pbes/pbessolve_vertex_set.h"
+#include "mcrl2/utilities/indexed_set.h"
 
 namespace mcrl2 {
 
@@ -26,7 +27,7 @@ struct structure_graph_builder
   typedef structure_graph::index_type index_type;
 
   structure_graph& m_graph;
-  std::unordered_map<pbes_expression, index_type> m_vertex_map;
+  utilities::indexed_set<pbes_expression> m_vertex_map;
   pbes_expression m_initial_state; // The initial state.
 
   explicit structure_graph_builder(structure_graph& G)
@@ -87,8 +88,8 @@ struct structure_graph_builder
   {
     assert(m_vertex_map.find(x) == m_vertex_map.end());
     vertices().emplace_back(x, decoration(x));
-    index_type index = vertices().size() - 1;
-    m_vertex_map.insert({ x, index });
+    index_type index = m_vertex_map.insert(x).first->second;
+    assert(index == vertices().size() - 1);
     return index;
   }
 
@@ -219,11 +220,11 @@ struct structure_graph_builder
 
     vertices().erase(vertices().begin() + vertices().size() - U.size(), vertices().end());
 
-    // Recreate the index
+    // Recreate the index, inserting the vertices in order assigns index i to vertex i
     m_vertex_map.clear();
-    for (std::size_t i = 0; i < vertices().size(); i++)
+    for (const auto& v: vertices())
     {
-      m_vertex_map.insert({vertices()[i].formula, i});
+      m_vertex_map.insert(v.formula);
     }
   }
 };
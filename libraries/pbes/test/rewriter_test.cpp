@@ -367,6 +367,40 @@ BOOST_AUTO_TEST_CASE(test_enumerate_quantifiers_rewriter2)
   // R2(y) = X(e1) || X(e2)
 }
 
+BOOST_AUTO_TEST_CASE(test_enumerate_quantifiers_rewriter_with_cache)
+{
+  data::data_specification dataspec = data::data_specification();
+  dataspec.add_context_sort(data::sort_nat::nat());
+  data::rewriter datar(dataspec);
+  enumerate_quantifiers_rewriter R(datar, dataspec);
+  enumerate_quantifiers_rewriter R_cached(datar, dataspec, true, 100);
+
+  const std::vector<std::string> expressions = {
+    "forall b: Bool. forall n: Nat. val(n > 3) || Y(n)",
+    "exists b: Bool. W(b)",
+    "forall m: Nat. (val(!(m < 3)) || Y(m + n))",
+    "exists m: Nat. val(m < 3) && Y(m + n)",
+    "forall n: Nat. (val(n < 3) && (exists n: Nat. val(n < 3)))",
+    "forall b: Bool . val(b) || X1(b)"
+  };
+
+  // The second round is answered from the cache.
+  for (int round = 0; round < 2; round++)
+  {
+    for (const std::string& sigma: { "n: Nat := 1", "n: Nat := 2" })
+    {
+      rewriter_with_substitution<enumerate_quantifiers_rewriter> r1(R_cached, sigma);
+      rewriter_with_substitution<enumerate_quantifiers_rewriter> r2(R, sigma);
+      for (const std::string& x: expressions)
+      {
+        test_rewriters(N(r1), N(r2), x, x);
+      }
+    }
+  }
+  BOOST_CHECK(R_cached.enumeration_cache_metrics().hit_count() > 0);
+  BOOST_CHECK_EQUAL(R.enumeration_cache_metrics().hit_count(), 0u);
+}
+
 BOOST_AUTO_TEST_CASE(test_enumerate_quantifiers_rewriter_finite)
 {
   data::data_specification data_spec = data::data_specification();
@@ -21,10 +21,17 @@
 #include "mcrl2/utilities/exception.h"
 #include "mcrl2/utilities/hash_utility.h"
 #include <algorithm>
+#include <cassert>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <vector>
 
+// Use 128 bit machine arithmetic for the operations on single digits when it is available.
+#if defined(__SIZEOF_INT128__) && !defined(MCRL2_BIG_NUMBERS_NO_INT128)
+#define MCRL2_BIG_NUMBERS_INT128
+#endif
+
 // Prototype.
 namespace mcrl2
 {
@@ -45,6 +52,10 @@ namespace utilities
 namespace detail
 {
 
+#ifdef MCRL2_BIG_NUMBERS_INT128
+  __extension__ typedef unsigned __int128 double_digit;
+#endif
+
   // Calculate <carry,result>:=n1+n2+carry. The carry can be either 0 or 1, both
   // at the input and the output.
   inline std::size_t add_single_number(const std::size_t n1, const std::size_t n2, std::size_t& carry)
@@ -90,12 +101,16 @@ namespace detail
     }
     return result;
   }
-  
+
   // Calculate <carry,result>:=n1*n2+carry, where the lower bits of the calculation
   // are stored in the result, and the higher bits are stored in carry.
   inline std::size_t multiply_single_number(const std::size_t n1, const std::size_t n2, std::size_t& multiplication_carry)
   {
-    // TODO: It is more concise and efficient to use 128bit machine calculation when available.
+#ifdef MCRL2_BIG_NUMBERS_INT128
+    const double_digit result=static_cast<double_digit>(n1)*n2+multiplication_carry;
+    multiplication_carry=static_cast<std::size_t>(result>>std::numeric_limits<std::size_t>::digits);
+    return static_cast<std::size_t>(result);
+#else
     const int no_of_bits_per_digit=std::numeric_limits<std::size_t>::digits;
 
     // split input numbers into no_of_bits_per_digit/2 digits
@@ -103,7 +118,7 @@ namespace detail
     std::size_t n1ms = n1 >> (no_of_bits_per_digit/2);
     std::size_t n2ls = n2 & ((1LL<<(no_of_bits_per_digit/2))-1);
     std::size_t n2ms = n2 >> (no_of_bits_per_digit/2);
-    
+
     // First calculate the result of the least significant no_of_bits_per_digit.
     std::size_t local_carry=0;
     std::size_t result = add_single_number(n1ls*n2ls,multiplication_carry,local_carry);
@@ -122,34 +137,422 @@ namespace detail
     multiplication_carry=multiplication_carry+n1ms*n2ms;
 
     return result;
+#endif
+  }
+
+  // Calculate <carry,result>:=n1*n2+n3+carry. This cannot overflow two digits.
+  inline std::size_t multiply_add_single_number(const std::size_t n1, const std::size_t n2, const std::size_t n3, std::size_t& multiplication_carry)
+  {
+#ifdef MCRL2_BIG_NUMBERS_INT128
+    const double_digit result=static_cast<double_digit>(n1)*n2+n3+multiplication_carry;
+    multiplication_carry=static_cast<std::size_t>(result>>std::numeric_limits<std::size_t>::digits);
+    return static_cast<std::size_t>(result);
+#else
+    std::size_t result=multiply_single_number(n1,n2,multiplication_carry);
+    std::size_t carry=0;
+    result=add_single_number(result,n3,carry);
+    multiplication_carry=multiplication_carry+carry;
+    return result;
+#endif
+  }
+
+  // The number of zero bits below the least significant one in n, which must be non zero.
+  inline std::size_t count_trailing_zero_bits(std::size_t n)
+  {
+    assert(n!=0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(n));
+#else
+    std::size_t result=0;
+    for( ; (n & 1)==0; n=n>>1)
+    {
+      ++result;
+    }
+    return result;
+#endif
+  }
+
+  // The number of zero bits above the most significant one in n, which must be non zero.
+  inline std::size_t count_leading_zero_bits(std::size_t n)
+  {
+    assert(n!=0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_clzll(n));
+#else
+    std::size_t result=0;
+    for( ; (n >> (std::numeric_limits<std::size_t>::digits-1))==0; n=n<<1)
+    {
+      ++result;
+    }
+    return result;
+#endif
   }
-  
+
   // Calculate <result,remainder>:=(remainder * 2^64 + p) / q assuming the result
-  // fits in 64 bits. More concretely, q>remainder. 
+  // fits in 64 bits. More concretely, q>remainder.
   inline std::size_t divide_single_number(const std::size_t p, const std::size_t q, std::size_t& remainder)
   {
     assert(q>remainder);
-    const int no_of_bits_per_digit=std::numeric_limits<std::size_t>::digits;
+#ifdef MCRL2_BIG_NUMBERS_INT128
+    const double_digit n=(static_cast<double_digit>(remainder)<<std::numeric_limits<std::size_t>::digits) | p;
+    const std::size_t result=static_cast<std::size_t>(n/q);
+    remainder=static_cast<std::size_t>(n%q);
+    return result;
+#else
+    // Long division of a two digit number by a single digit, using digits of half the size
+    // (Warren, Hacker's Delight, divlu). The divisor is shifted such that its most significant bit is set.
+    const std::size_t no_of_bits_per_digit=std::numeric_limits<std::size_t>::digits;
+    const std::size_t half_base=std::size_t(1)<<(no_of_bits_per_digit/2);
+    const std::size_t half_mask=half_base-1;
+
+    const std::size_t shift=count_leading_zero_bits(q);
+    const std::size_t v=q<<shift;
+    const std::size_t vn1=v>>(no_of_bits_per_digit/2);
+    const std::size_t vn0=v & half_mask;
+    const std::size_t un32=(shift==0?remainder:(remainder<<shift) | (p>>(no_of_bits_per_digit-shift)));
+    const std::size_t un10=p<<shift;
+    const std::size_t un1=un10>>(no_of_bits_per_digit/2);
+    const std::size_t un0=un10 & half_mask;
+
+    std::size_t q1=un32/vn1;
+    std::size_t rhat=un32-q1*vn1;
+    while (q1>=half_base || q1*vn0>half_base*rhat+un1)
+    {
+      --q1;
+      rhat=rhat+vn1;
+      if (rhat>=half_base)
+      {
+        break;
+      }
+    }
+
+    const std::size_t un21=un32*half_base+un1-q1*v;
+    std::size_t q0=un21/vn1;
+    rhat=un21-q0*vn1;
+    while (q0>=half_base || q0*vn0>half_base*rhat+un0)
+    {
+      --q0;
+      rhat=rhat+vn1;
+      if (rhat>=half_base)
+      {
+        break;
+      }
+    }
+
+    remainder=(un21*half_base+un0-q0*v)>>shift;
+    return q1*half_base+q0;
+#endif
+  }
+
+  // The greatest common divisor of two machine numbers, using the binary gcd algorithm.
+  inline std::size_t greatest_common_divisor_single_number(std::size_t x, std::size_t y)
+  {
+    if (x==0) { return y; }
+    if (y==0) { return x; }
+    const std::size_t shift=count_trailing_zero_bits(x|y);
+    x=x>>count_trailing_zero_bits(x);
+    while (y!=0)
+    {
+      y=y>>count_trailing_zero_bits(y);
+      if (x>y)
+      {
+        std::swap(x,y);
+      }
+      y=y-x;
+    }
+    return x<<shift;
+  }
+
+  /* The following functions operate on sequences of digits, with the least significant digit first.
+     They are the kernels of the operations on big natural numbers. */
+
+  // Calculate r:=r+x where r has nr digits and x has nx<=nr digits. The result must fit in nr digits.
+  inline void add_digits(std::size_t* r, const std::size_t nr, const std::size_t* x, const std::size_t nx)
+  {
+    assert(nx<=nr);
+    std::size_t carry=0;
+    std::size_t i=0;
+    for( ; i<nx; ++i)
+    {
+      r[i]=add_single_number(r[i],x[i],carry);
+    }
+    for( ; carry>0 && i<nr; ++i)
+    {
+      r[i]=add_single_number(r[i],0,carry);
+    }
+    assert(carry==0);
+    static_cast<void>(nr); // Only used in assertions.
+  }
+
+  // Calculate r:=r-x where r has nr digits and x has nx<=nr digits. The result must not be negative.
+  inline void subtract_digits(std::size_t* r, const std::size_t nr, const std::size_t* x, const std::size_t nx)
+  {
+    assert(nx<=nr);
+    std::size_t carry=0;
+    std::size_t i=0;
+    for( ; i<nx; ++i)
+    {
+      r[i]=subtract_single_number(r[i],x[i],carry);
+    }
+    for( ; carry>0 && i<nr; ++i)
+    {
+      r[i]=subtract_single_number(r[i],0,carry);
+    }
+    assert(carry==0);
+    static_cast<void>(nr); // Only used in assertions.
+  }
+
+  // Calculate the na+nb digits of r:=a*b with the schoolbook method. The result may not overlap with a or b.
+  inline void multiply_digits_schoolbook(const std::size_t* a, const std::size_t na, const std::size_t* b, const std::size_t nb, std::size_t* r)
+  {
+    std::fill(r,r+na+nb,0);
+    for(std::size_t i=0; i<na; ++i)
+    {
+      if (a[i]==0)
+      {
+        continue;
+      }
+      std::size_t carry=0;
+      for(std::size_t j=0; j<nb; ++j)
+      {
+        r[i+j]=multiply_add_single_number(a[i],b[j],r[i+j],carry);
+      }
+      r[i+nb]=carry;
+    }
+  }
+
+  // Below this number of digits Karatsuba multiplication is slower than the schoolbook method.
+  const std::size_t karatsuba_threshold=32;
+
+  // Calculate the na+nb digits of r:=a*b using Karatsuba multiplication for large numbers.
+  // The result may not overlap with a or b.
+  inline void multiply_digits(const std::size_t* a, std::size_t na, const std::size_t* b, std::size_t nb, std::size_t* r)
+  {
+    if (na<nb)
+    {
+      std::swap(a,b);
+      std::swap(na,nb);
+    }
+    if (nb<karatsuba_threshold)
+    {
+      multiply_digits_schoolbook(a,na,b,nb,r);
+      return;
+    }
+
+    std::fill(r,r+na+nb,0);
+    if (2*nb<=na)
+    {
+      // The numbers are unbalanced, multiply b with parts of a of nb digits.
+      std::vector<std::size_t> part(2*nb);
+      for(std::size_t i=0; i<na; i+=nb)
+      {
+        const std::size_t n=(std::min)(nb,na-i);
+        multiply_digits(a+i,n,b,nb,part.data());
+        add_digits(r+i,na+nb-i,part.data(),n+nb);
+      }
+      return;
+    }
 
-    // Split input numbers into no_of_bits_per_digit/2 digits.
-    // First get the least significant part.
-    std::size_t pms = (p >> (no_of_bits_per_digit/2)) + (remainder << (no_of_bits_per_digit/2));
-    
-    // First divide the most significant part by q.
-    std::size_t resultms = pms/q;
-    assert((resultms >> (no_of_bits_per_digit/2)) == 0);
-    std::size_t remainderms = pms%q;
-
-    // Now obtain the least significant part.
-    std::size_t pls = (p & ((1LL<<(no_of_bits_per_digit/2))-1)) + (remainderms << (no_of_bits_per_digit/2));
-    
-    // Second divide the least significant part by q.
-    std::size_t resultls = pls/q;
-    remainder = pls%q;
-    assert((resultls >> (no_of_bits_per_digit/2)) == 0);
-
-    return resultls + (resultms << (no_of_bits_per_digit/2));
+    // Split a=a1*B^m+a0 and b=b1*B^m+b0, where B is the base. Then a*b=z2*B^2m+z1*B^m+z0 with z0=a0*b0,
+    // z2=a1*b1 and z1=(a0+a1)*(b0+b1)-z0-z2, which requires three instead of four multiplications.
+    const std::size_t m=(na+1)/2;
+    assert(m<=nb);
+    multiply_digits(a,m,b,m,r);                 // z0
+    multiply_digits(a+m,na-m,b+m,nb-m,r+2*m);   // z2
+
+    std::vector<std::size_t> sum_a(a,a+m), sum_b(b,b+m), z1(2*m+2);
+    sum_a.push_back(0);
+    sum_b.push_back(0);
+    add_digits(sum_a.data(),m+1,a+m,na-m);
+    add_digits(sum_b.data(),m+1,b+m,nb-m);
+    multiply_digits(sum_a.data(),m+1,sum_b.data(),m+1,z1.data());
+    subtract_digits(z1.data(),2*m+2,r,2*m);
+    subtract_digits(z1.data(),2*m+2,r+2*m,na+nb-2*m);
+
+    std::size_t n1=z1.size();
+    for( ; n1>0 && z1[n1-1]==0; --n1) {}
+    add_digits(r+m,na+nb-m,z1.data(),n1);
   }
+
+  /* \brief A sequence of digits that stores up to two digits without allocating memory on the heap.
+     \details It offers the part of the interface of std::vector that is used by big_natural_number.
+   */
+  class big_natural_number_digits
+  {
+    protected:
+      static const std::size_t inline_capacity=2;
+
+      std::size_t* m_data;  // Either refers to m_inline, or to memory on the heap.
+      std::size_t m_size;
+      std::size_t m_capacity;
+      std::size_t m_inline[inline_capacity];
+
+      bool is_inline() const
+      {
+        return m_data==m_inline;
+      }
+
+    public:
+      typedef std::size_t value_type;
+      typedef std::size_t* iterator;
+      typedef const std::size_t* const_iterator;
+      typedef std::reverse_iterator<iterator> reverse_iterator;
+      typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+      big_natural_number_digits()
+       : m_data(m_inline),
+         m_size(0),
+         m_capacity(inline_capacity)
+      {}
+
+      big_natural_number_digits(const big_natural_number_digits& other)
+       : big_natural_number_digits()
+      {
+        *this=other;
+      }
+
+      big_natural_number_digits(big_natural_number_digits&& other)
+       : big_natural_number_digits()
+      {
+        *this=std::move(other);
+      }
+
+      ~big_natural_number_digits()
+      {
+        if (!is_inline())
+        {
+          delete[] m_data;
+        }
+      }
+
+      big_natural_number_digits& operator=(const big_natural_number_digits& other)
+      {
+        if (this!=&other)
+        {
+          reserve(other.m_size);
+          std::copy(other.begin(),other.end(),m_data);
+          m_size=other.m_size;
+        }
+        return *this;
+      }
+
+      big_natural_number_digits& operator=(big_natural_number_digits&& other)
+      {
+        if (this==&other)
+        {
+          return *this;
+        }
+        if (other.is_inline())
+        {
+          std::copy(other.begin(),other.end(),m_data);
+        }
+        else
+        {
+          if (!is_inline())
+          {
+            delete[] m_data;
+          }
+          m_data=other.m_data;
+          m_capacity=other.m_capacity;
+          other.m_data=other.m_inline;
+          other.m_capacity=inline_capacity;
+        }
+        m_size=other.m_size;
+        other.m_size=0;
+        return *this;
+      }
+
+      void swap(big_natural_number_digits& other)
+      {
+        if (!is_inline() && !other.is_inline())
+        {
+          std::swap(m_data,other.m_data);
+          std::swap(m_size,other.m_size);
+          std::swap(m_capacity,other.m_capacity);
+          return;
+        }
+        big_natural_number_digits tmp(std::move(other));
+        other=std::move(*this);
+        *this=std::move(tmp);
+      }
+
+      void reserve(const std::size_t n)
+      {
+        if (n>m_capacity)
+        {
+          const std::size_t capacity=(std::max)(n,2*m_capacity);
+          std::size_t* data=new std::size_t[capacity];
+          std::copy(begin(),end(),data);
+          if (!is_inline())
+          {
+            delete[] m_data;
+          }
+          m_data=data;
+          m_capacity=capacity;
+        }
+      }
+
+      // Resizes the sequence, where new digits are zero.
+      void resize(const std::size_t n)
+      {
+        reserve(n);
+        if (n>m_size)
+        {
+          std::fill(m_data+m_size,m_data+n,0);
+        }
+        m_size=n;
+      }
+
+      void push_back(const std::size_t n)
+      {
+        if (m_size==m_capacity)
+        {
+          reserve(m_size+1);
+        }
+        m_data[m_size++]=n;
+      }
+
+      void pop_back()
+      {
+        assert(m_size>0);
+        --m_size;
+      }
+
+      void clear()
+      {
+        m_size=0;
+      }
+
+      std::size_t size() const { return m_size; }
+      bool empty() const { return m_size==0; }
+      std::size_t* data() { return m_data; }
+      const std::size_t* data() const { return m_data; }
+      std::size_t& operator[](const std::size_t i) { assert(i<m_size); return m_data[i]; }
+      const std::size_t& operator[](const std::size_t i) const { assert(i<m_size); return m_data[i]; }
+      std::size_t& front() { assert(m_size>0); return m_data[0]; }
+      const std::size_t& front() const { assert(m_size>0); return m_data[0]; }
+      std::size_t& back() { assert(m_size>0); return m_data[m_size-1]; }
+      const std::size_t& back() const { assert(m_size>0); return m_data[m_size-1]; }
+      iterator begin() { return m_data; }
+      iterator end() { return m_data+m_size; }
+      const_iterator begin() const { return m_data; }
+      const_iterator end() const { return m_data+m_size; }
+      reverse_iterator rbegin() { return reverse_iterator(end()); }
+      reverse_iterator rend() { return reverse_iterator(begin()); }
+      const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+      const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+      bool operator==(const big_natural_number_digits& other) const
+      {
+        return m_size==other.m_size && std::equal(begin(),end(),other.begin());
+      }
+
+      bool operator!=(const big_natural_number_digits& other) const
+      {
+        return !operator==(other);
+      }
+  };
+
 } // namespace detail
 
 class big_natural_number;
@@ -161,10 +564,11 @@ class big_natural_number
     friend inline void swap(big_natural_number& x, big_natural_number& y);
 
   protected:
-    // Numbers are stored as std::size_t words, with the most significant number last. 
+    // Numbers are stored as std::size_t words, with the most significant number last.
     // Note that the number representation is not unique. Numbers have no trailing
     // zero's, i.e., this->back()!=0 (if this->size()>0). Therefore their representation is unique.
-    std::vector<std::size_t> m_number;
+    // Numbers of at most two words are stored without allocating memory on the heap.
+    detail::big_natural_number_digits m_number;
 
     /* Multiply the current number by n and add the carry */
     void multiply_by(std::size_t n, std::size_t carry)
@@ -199,6 +603,76 @@ class big_natural_number
       assert(m_number.size()==0 || m_number.back()!=0);
     }
 
+    // Sets the number to the single digit n.
+    void set_single_digit(const std::size_t n)
+    {
+      m_number.clear();
+      if (n>0)
+      {
+        m_number.push_back(n);
+      }
+    }
+
+    // The number of zero bits below the least significant one. The number must not be zero.
+    std::size_t count_trailing_zero_bits() const
+    {
+      assert(!is_zero());
+      std::size_t i=0;
+      for( ; m_number[i]==0; ++i) {}
+      return i*std::numeric_limits<std::size_t>::digits+detail::count_trailing_zero_bits(m_number[i]);
+    }
+
+    // Divide the number by 2^n.
+    void shift_right(const std::size_t n)
+    {
+      const std::size_t no_of_bits_per_digit=std::numeric_limits<std::size_t>::digits;
+      const std::size_t digits=n/no_of_bits_per_digit;
+      const std::size_t bits=n%no_of_bits_per_digit;
+      if (digits>=m_number.size())
+      {
+        m_number.clear();
+        return;
+      }
+      const std::size_t size=m_number.size()-digits;
+      for(std::size_t i=0; i<size; ++i)
+      {
+        std::size_t digit=m_number[i+digits]>>bits;
+        if (bits>0 && i+digits+1<m_number.size())
+        {
+          digit=digit | (m_number[i+digits+1]<<(no_of_bits_per_digit-bits));
+        }
+        m_number[i]=digit;
+      }
+      m_number.resize(size);
+      remove_significant_digits_that_are_zero();
+      is_well_defined();
+    }
+
+    // Multiply the number by 2^n.
+    void shift_left(const std::size_t n)
+    {
+      if (is_zero())
+      {
+        return;
+      }
+      const std::size_t no_of_bits_per_digit=std::numeric_limits<std::size_t>::digits;
+      const std::size_t digits=n/no_of_bits_per_digit;
+      const std::size_t bits=n%no_of_bits_per_digit;
+      const std::size_t old_size=m_number.size();
+      m_number.resize(old_size+digits+1);
+      for(std::size_t i=old_size; i-->0; )
+      {
+        if (bits>0)
+        {
+          m_number[i+digits+1]=m_number[i+digits+1] | (m_number[i]>>(no_of_bits_per_digit-bits));
+        }
+        m_number[i+digits]=m_number[i]<<bits;
+      }
+      std::fill(m_number.begin(),m_number.begin()+digits,0);
+      remove_significant_digits_that_are_zero();
+      is_well_defined();
+    }
+
     // \brief This functions prints a number in internal represenation. This function is useful and only meant for debugging.
     void print_number(const std::string& s) const
     {
@@ -258,13 +732,21 @@ class big_natural_number
     bool is_number(std::size_t n) const
     {
       is_well_defined();
-      if (n==0) 
+      if (n==0)
       {
         return m_number.size()==0;
       }
       return m_number.size()==1 && m_number.front()==n;
     }
 
+    /** \brief Returns whether this number fits in a std::size_t.
+    */
+    bool is_single_digit() const
+    {
+      is_well_defined();
+      return m_number.size()<=1;
+    }
+
     /** \brief Sets the number to zero.
         \details This is more efficient than using an assignment x=0.
     */
@@ -275,7 +757,7 @@ class big_natural_number
     }
 
     /** \brief Transforms this number to a std::size_t, provided it is sufficiently small.
-               If not an mcrl2::runtime_error is thrown. 
+               If not an mcrl2::runtime_error is thrown.
     */
     explicit operator std::size_t() const
     {
@@ -296,7 +778,7 @@ class big_natural_number
     bool operator==(const big_natural_number& other) const
     {
       is_well_defined();
-      other.is_well_defined(); 
+      other.is_well_defined();
       return m_number==other.m_number;
     }
 
@@ -305,14 +787,14 @@ class big_natural_number
     bool operator!=(const big_natural_number& other) const
     {
       return !this->operator==(other);
-    } 
+    }
 
     /* \brief Standard comparison operator.
     */
     bool operator<(const big_natural_number& other) const
     {
       is_well_defined();
-      other.is_well_defined(); 
+      other.is_well_defined();
       if (m_number.size()<other.m_number.size())
       {
         return true;
@@ -322,8 +804,8 @@ class big_natural_number
         return false;
       }
       assert(m_number.size()==other.m_number.size());
-      std::vector<std::size_t>::const_reverse_iterator j=other.m_number.rbegin();
-      for(std::vector<std::size_t>::const_reverse_iterator i=m_number.rbegin(); i!=m_number.rend(); ++i, ++j)
+      detail::big_natural_number_digits::const_reverse_iterator j=other.m_number.rbegin();
+      for(detail::big_natural_number_digits::const_reverse_iterator i=m_number.rbegin(); i!=m_number.rend(); ++i, ++j)
       {
         if (*i < *j)
         {
@@ -364,7 +846,7 @@ class big_natural_number
     std::size_t divide_by(std::size_t n)
     {
       std::size_t remainder=0;
-      for(std::vector<std::size_t>::reverse_iterator i=m_number.rbegin(); i!=m_number.rend(); ++i)
+      for(detail::big_natural_number_digits::reverse_iterator i=m_number.rbegin(); i!=m_number.rend(); ++i)
       {
         *i=detail::divide_single_number(*i,n,remainder);
       }
@@ -373,7 +855,7 @@ class big_natural_number
       return remainder;
     }
 
-    // Add the argument to this big natural number 
+    // Add the argument to this big natural number
     void add(const big_natural_number& other)
     {
       is_well_defined();
@@ -391,6 +873,11 @@ class big_natural_number
         else if (i>=other.m_number.size())
         {
           m_number[i]=detail::add_single_number(m_number[i],0,carry);
+          if (carry==0)
+          {
+            // The remaining digits do not change.
+            break;
+          }
         }
         else
         {
@@ -417,9 +904,9 @@ class big_natural_number
       return result;
     }
 
-    /* \brief Standard subtraction. 
-       \detail Subtract other from this number. Throws an exception if 
-               the result is negative and cannot be represented. 
+    /* \brief Standard subtraction.
+       \detail Subtract other from this number. Throws an exception if
+               the result is negative and cannot be represented.
     */
     void subtract(const big_natural_number& other)
     {
@@ -437,6 +924,11 @@ class big_natural_number
       {
         if (i>=other.m_number.size())
         {
+          if (carry==0)
+          {
+            // The remaining digits do not change.
+            break;
+          }
           m_number[i]=detail::subtract_single_number(m_number[i],0,carry);
         }
         else
@@ -450,7 +942,7 @@ class big_natural_number
       }
       remove_significant_digits_that_are_zero();
       is_well_defined();
-    } 
+    }
 
     /* \brief Standard subtraction operator. Throws an exception if the result
      *        is negative and cannot be represented.
@@ -464,11 +956,10 @@ class big_natural_number
       return result;
     }
 
-    
-
     /* \brief Efficient multiplication operator that does not declare auxiliary vectors.
        \detail Initially result must be zero. At the end: result equals (*this)*other+result.
-               The calculation_buffer does not need to be initialised. 
+               The calculation_buffer does not need to be initialised.
+               Numbers with many digits are multiplied using Karatsuba multiplication.
      */
     void multiply(const big_natural_number& other,
                   big_natural_number& result,
@@ -476,22 +967,37 @@ class big_natural_number
     {
       is_well_defined();
       other.is_well_defined();
-      std::size_t offset=0; 
-      for(std::size_t digit: other.m_number)
-      {
-        // Move n2 to the multiplicand and multiply it with base^offset.
-        calculation_buffer_for_multiplicand.clear();
-        for(std::size_t i=0; i< offset; ++i) { calculation_buffer_for_multiplicand.m_number.push_back(0); }
-        for(std::size_t n: m_number)
-        { 
-          calculation_buffer_for_multiplicand.m_number.push_back(n);
+      if (is_zero() || other.is_zero())
+      {
+        return;
+      }
+
+      if (m_number.size()==1 && other.m_number.size()==1 && result.is_zero())
+      {
+        // Numbers that consist of a single digit are multiplied using machine arithmetic.
+        std::size_t carry=0;
+        const std::size_t n=detail::multiply_single_number(m_number.front(),other.m_number.front(),carry);
+        result.m_number.push_back(n);
+        if (carry>0)
+        {
+          result.m_number.push_back(carry);
         }
+        result.is_well_defined();
+        return;
+      }
 
-        // Multiply the multiplicand with digit.
-        calculation_buffer_for_multiplicand.multiply_by(digit,0);
-        // Add the multiplicand to the result.
+      calculation_buffer_for_multiplicand.m_number.resize(m_number.size()+other.m_number.size());
+      detail::multiply_digits(m_number.data(),m_number.size(),
+                              other.m_number.data(),other.m_number.size(),
+                              calculation_buffer_for_multiplicand.m_number.data());
+      calculation_buffer_for_multiplicand.remove_significant_digits_that_are_zero();
+      if (result.is_zero())
+      {
+        result.m_number.swap(calculation_buffer_for_multiplicand.m_number);
+      }
+      else
+      {
         result.add(calculation_buffer_for_multiplicand);
-        offset++;
       }
       result.is_well_defined();
     }
@@ -503,27 +1009,15 @@ class big_natural_number
       big_natural_number result, buffer;
       multiply(other,result,buffer);
       return result;
-    } 
-
-    // This is an auxiliary function getting the n-th digit,
-    // where digit 0 is the least significant one.
-    // It is not necessary that n is in range.
-    /* std::size_t getdigit(const std::size_t n) const
-    {
-      if (n>=m_number.size()) 
-      {
-        return 0;
-      }
-      return m_number[n];
-    } */
+    }
 
     /* \brief Efficient divide operator that does not declare auxiliary vectors.
-       \detail Initially result must be zero. At the end: result equals (*this)*other+result.
-               The calculation_buffer does not need to be initialised. 
-               The algorithm uses standard "primary school" division, except that
-               the digits in this case are 64 bits numbers. The calculation is tricky
-               as the most significant digit of this may be a remaining digit from
-               the previous calculation.
+       \detail At the end: (*this) equals result*other+remainder where remainder<other.
+               The calculation_buffer does not need to be initialised.
+               The algorithm is the long division of Knuth (The Art of Computer Programming,
+               Vol. 2, Algorithm 4.3.1.D), where the digits are 64 bit numbers. The divisor is
+               shifted such that its most significant bit is set, which guarantees that every
+               estimated digit of the result is at most two too large.
      */
     void div_mod(const big_natural_number& other,
                  big_natural_number& result,
@@ -534,161 +1028,107 @@ class big_natural_number
       other.is_well_defined();
       assert(!other.is_zero());
 
-      if (m_number.size()==1 && other.m_number.size()==1)
+      if (m_number.size()<other.m_number.size())
       {
-        std::size_t n=m_number.front()/other.m_number.front();      // Calculate div.
-        if (n==0)
-        {
-          result.clear();
-        }
-        else 
-        {
-          result.m_number.resize(1);
-          result.m_number[0]=n;
-        }
-        n=m_number.front() % other.m_number.front(); // Calculate mod. 
-        if (n==0)
-        {
-          remainder.clear();
-        }
-        else
+        result.clear();
+        remainder=*this;
+        return;
+      }
+
+      if (other.m_number.size()==1)
+      {
+        // Divide by a single digit.
+        if (&result!=this)
         {
-          remainder.m_number.resize(1);
-          remainder.m_number[0]=n;
+          result=*this;
         }
+        remainder.set_single_digit(result.divide_by(other.m_number.front()));
         result.is_well_defined();
         remainder.is_well_defined();
         return;
       }
 
-      // TODO: The procedure below works bitwise, as no efficient division algorithm has yet
-      // been implemented. A natural candidate is the algorithm in "Per Brinch Hansen, Multiple
-      // length division revisited: A tour of the minefield. Software practice and experience 24,
-      // 579-601, 1994.
-      result.clear();
+      // Normalise the divisor v and the dividend u such that the most significant bit of v is set.
+      const std::size_t shift=detail::count_leading_zero_bits(other.m_number.back());
+      big_natural_number& v=calculation_buffer_divisor;
+      v=other;
+      v.shift_left(shift);
       remainder=*this;
-
-      if (m_number.size()<other.m_number.size())
+      remainder.shift_left(shift);
+      detail::big_natural_number_digits& u=remainder.m_number;
+      const std::size_t n=v.m_number.size();
+      if (u.size()==m_number.size())
       {
-        result.is_well_defined();
-        remainder.is_well_defined();
-        return; 
+        u.push_back(0);
       }
-      const int no_of_bits_per_digit=std::numeric_limits<std::size_t>::digits;
-
-      big_natural_number divisor;
-      calculation_buffer_divisor.clear();
-      for(std::size_t i=0; i< (1+m_number.size())-other.m_number.size(); ++i) { calculation_buffer_divisor.m_number.push_back(0); }
+      const std::size_t m=u.size()-n-1;
+      const std::size_t v1=v.m_number[n-1];
+      const std::size_t v2=v.m_number[n-2];
 
-      // Place 0 digits at least significant position of the calculation_buffer_divisor to make it of comparable length as the remainder.
-      for(std::size_t i: other.m_number)
+      result.m_number.resize(m+1);
+      for(std::size_t j=m+1; j-->0; )
       {
-        calculation_buffer_divisor.m_number.push_back(i);
-      }
-      calculation_buffer_divisor.remove_significant_digits_that_are_zero();
-      
-      for(std::size_t i=0; i<=no_of_bits_per_digit*(m_number.size()-other.m_number.size()+1); ++i)
-      {
-        if (remainder<calculation_buffer_divisor)
+        // Estimate the digit of the result using the two most significant digits of the remainder.
+        std::size_t qhat;
+        std::size_t rhat;
+        bool rhat_overflow=false;
+        if (u[j+n]>=v1)
         {
-          // We cannot subtract the calculation_buffer_divisor from the remainder.
-          result.multiply_by(2,0); // result=result*2
+          qhat=std::numeric_limits<std::size_t>::max();
+          rhat=u[j+n-1]+v1;
+          rhat_overflow=rhat<v1;
         }
         else
         {
-          // We subtract the calculation_buffer_divisor from the remainder.
-          result.multiply_by(2,1); // result=result*2 + 1
-          remainder.subtract(calculation_buffer_divisor);
+          rhat=u[j+n];
+          qhat=detail::divide_single_number(u[j+n-1],v1,rhat);
+        }
+        while (!rhat_overflow)
+        {
+          // Check whether qhat*v2 > rhat*B+u[j+n-2].
+          std::size_t high=0;
+          const std::size_t low=detail::multiply_single_number(qhat,v2,high);
+          if (high<rhat || (high==rhat && low<=u[j+n-2]))
+          {
+            break;
+          }
+          --qhat;
+          rhat=rhat+v1;
+          rhat_overflow=rhat<v1;
         }
-        calculation_buffer_divisor.divide_by(2); // Shift the calculation_buffer_divisor one bit to the left.
-      }
-      
-      result.remove_significant_digits_that_are_zero();
-      result.is_well_defined();
-      remainder.is_well_defined();
-    }
-
-    /* void div_mod(const big_natural_number& other,
-                 big_natural_number& result,
-                 big_natural_number& remainder,
-                 big_natural_number& calculation_buffer_subtractor) const
-    {
-      is_well_defined();
-      other.is_well_defined();
-      assert(!other.is_zero());
-
-      result.clear();
-      remainder=*this;
 
-      if (m_number.size()<other.m_number.size())
-      {
-        return;
-      }
-this->print_number("div_mod: this: ");
-other.print_number("div_mod: other: ");
-      std::size_t remaining_digit=0;
-      for(std::size_t n=remainder.m_number.size()-1; n>=other.m_number.size(); n--)
-      {
-std::cerr << "Wat is n " << n << "\n";
-        std::size_t r=remainder.getdigit(n+1);
-        std::size_t divisor=detail::divide_single_number(
-                                            remainder.getdigit(n),
-                                            other.m_number.back(),
-                                            r);
-
-result.print_number("div_mod: result: ");
-remainder.print_number("div_mod: remainder: ");
-std::cerr << "dmwhile: divisor: " << divisor <<"\n";
-calculation_buffer_subtractor.is_well_defined();
-        calculation_buffer_subtractor.m_number=std::vector<std::size_t>(n-other.m_number.size(),0); Inefficient, want constructie
-        for(std::size_t i: other.m_number)
+        // Subtract qhat*v from the remainder.
+        std::size_t multiplication_carry=0;
+        std::size_t carry=0;
+        for(std::size_t i=0; i<n; ++i)
         {
-          calculation_buffer_subtractor.m_number.push_back(i);
+          const std::size_t p=detail::multiply_single_number(qhat,v.m_number[i],multiplication_carry);
+          u[j+i]=detail::subtract_single_number(u[j+i],p,carry);
         }
-        calculation_buffer_subtractor.multiply_by(divisor,0);
-calculation_buffer_subtractor.print_number("div_mod: subtractor: ");
-        if (remainder<calculation_buffer_subtractor)
+        u[j+n]=detail::subtract_single_number(u[j+n],multiplication_carry,carry);
+
+        if (carry>0)
         {
-          divisor=divisor-1;
-std::cerr << "dmwhile: divisor adapted: " << divisor <<"\n";
-          calculation_buffer_subtractor.m_number=std::vector<std::size_t>(n-other.m_number.size(),0);
-          for(std::size_t i: other.m_number)
+          // The estimate was one too large, add v back.
+          --qhat;
+          carry=0;
+          for(std::size_t i=0; i<n; ++i)
           {
-            calculation_buffer_subtractor.m_number.push_back(i);
+            u[j+i]=detail::add_single_number(u[j+i],v.m_number[i],carry);
           }
-          calculation_buffer_subtractor.multiply_by(divisor,0);
+          u[j+n]=u[j+n]+carry;
         }
-        result.m_number.push_back(divisor);
-remainder.print_number("remainder before assert");         
-calculation_buffer_subtractor.print_number("subtractor before assert");         
-        assert(remainder>=calculation_buffer_subtractor);
-        std::size_t old_remainder_size=remainder.m_number.size();
-        remainder.subtract(calculation_buffer_subtractor);
-        remaining_digit=(remaining_digit?
-                            remainder.m_number.size()+1==old_remainder_size:
-                            remainder.m_number.size()==old_remainder_size);
-      }
-result.print_number("div_mod: result voor swap: ");
-      if (result.m_number.size()==0)
-      {
-        return;
-      }
-      // Result must be reverted.
-      std::size_t begin = 0; 
-      std::size_t end = result.m_number.size()-1;
-      while (begin<end)
-      {
-        std::swap(result.m_number[begin],result.m_number[end]);
-        begin++; 
-        end--;
+        result.m_number[j]=qhat;
       }
+
       result.remove_significant_digits_that_are_zero();
-result.print_number("div_mod: result na swap: ");
+      remainder.remove_significant_digits_that_are_zero();
+      remainder.shift_right(shift);
       result.is_well_defined();
       remainder.is_well_defined();
-    } */
+    }
 
-    /* \brief Standard division operator. This is currently implemented by a bit wise subtraction. Can be optimized by a 64 bit calculation.
+    /* \brief Standard division operator.
        \detail. This routine is not particularly efficient as it declares three temporary vectors.
      */
     big_natural_number operator/(const big_natural_number& other) const
@@ -703,53 +1143,134 @@ result.print_number("div_mod: result na swap: ");
       {
         return *this;
       }
-      
+
       // Often numbers only consist of one digit. Deal with this using machine division.
       if (m_number.size()==1 && other.m_number.size()==1)
       {
         return big_natural_number(m_number.front()/other.m_number.front());
       }
-      
-      // Otherwise do a multiple digit division. 
+
+      // Otherwise do a multiple digit division.
       big_natural_number result, remainder, buffer;
       div_mod(other,result,remainder,buffer);
       return result;
-    } 
+    }
 
-    /* \brief Standard modulo operator. This is currently implemented by a bit wise subtraction. Can be optimized by a 64 bit calculation.
+    /* \brief Standard modulo operator.
        \detail. This routine is not particularly efficient as it declares three temporary vectors.
      */
     big_natural_number operator%(const big_natural_number& other) const
     {
-      // Modulo zero is yields the value itself. 
+      // Modulo zero is yields the value itself.
       // Zero modulo  something is zero.
       if (other.is_zero() || is_zero())
       {
         return *this;
       }
-      
+
       // Often numbers only consist of one digit. Deal with this using machine division.
       if (m_number.size()==1 && other.m_number.size()==1)
       {
         return big_natural_number(m_number.front()%other.m_number.front());
       }
-      
+
       big_natural_number result, remainder, buffer;
       div_mod(other,result,remainder,buffer);
       return remainder;
 
-    } 
+    }
+
+    /* \brief Replaces this number by the greatest common divisor of this number and other.
+       \detail The value of other is destroyed, and the buffers do not need to be initialised.
+               The binary gcd algorithm is used, which only requires shifts and subtractions. If the
+               numbers differ much in size they are first reduced by a division, and as soon as both
+               numbers fit in a single digit the calculation is finished using machine arithmetic.
+     */
+    void greatest_common_divisor(big_natural_number& other,
+                                 big_natural_number& calculation_buffer1,
+                                 big_natural_number& calculation_buffer2,
+                                 big_natural_number& calculation_buffer3)
+    {
+      is_well_defined();
+      other.is_well_defined();
+      if (is_zero())
+      {
+        m_number.swap(other.m_number);
+        return;
+      }
+      if (other.is_zero())
+      {
+        return;
+      }
+
+      big_natural_number& x=*this;
+      big_natural_number& y=other;
+      if (x<y)
+      {
+        x.m_number.swap(y.m_number);
+      }
+      if (x.m_number.size()>y.m_number.size()+1)
+      {
+        // x is much larger than y, so reduce it to x%y by a single division.
+        x.div_mod(y,calculation_buffer1,calculation_buffer2,calculation_buffer3);
+        x.m_number.swap(calculation_buffer2.m_number);
+        if (x.is_zero())
+        {
+          x.m_number.swap(y.m_number);
+          return;
+        }
+      }
+
+      const std::size_t x_zeros=x.count_trailing_zero_bits();
+      const std::size_t y_zeros=y.count_trailing_zero_bits();
+      const std::size_t shift=(std::min)(x_zeros,y_zeros);
+      x.shift_right(x_zeros);
+      y.shift_right(y_zeros);
+
+      // Invariant: x and y are odd, and gcd(x,y)*2^shift is the result.
+      while (x.m_number.size()>1 || y.m_number.size()>1)
+      {
+        if (x>y)
+        {
+          x.m_number.swap(y.m_number);
+        }
+        y.subtract(x);
+        if (y.is_zero())
+        {
+          x.shift_left(shift);
+          return;
+        }
+        y.shift_right(y.count_trailing_zero_bits());
+      }
+
+      x.set_single_digit(detail::greatest_common_divisor_single_number(x.m_number.front(),y.m_number.front()));
+      x.shift_left(shift);
+      x.is_well_defined();
+    }
 };
 
 inline std::ostream& operator<<(std::ostream& ss, const big_natural_number& l)
 {
-  static big_natural_number n; // This code is not re-entrant, but it avoids declaring a vector continuously. 
-  n=l;  
+  // The number is divided by 10^19, the largest power of 10 that fits in 64 bits, such that
+  // every division yields 19 decimal digits at once.
+  const std::size_t chunk_digits=std::numeric_limits<std::size_t>::digits10;
+  std::size_t chunk_divisor=1;
+  for(std::size_t i=0; i<chunk_digits; ++i)
+  {
+    chunk_divisor=chunk_divisor*10;
+  }
+
+  static big_natural_number n; // This code is not re-entrant, but it avoids declaring a vector continuously.
+  n=l;
   std::string s; // This string contains the number in reverse ordering.
   for( ; !n.is_zero() ; )
   {
-    std::size_t remainder = n.divide_by(10); /* This divides n by 10. */
-    s.push_back(static_cast<char>('0'+remainder));
+    std::size_t remainder = n.divide_by(chunk_divisor); /* This divides n by 10^19. */
+    for(std::size_t i=0; i<chunk_digits && (remainder>0 || !n.is_zero()); ++i)
+    {
+      s.push_back(static_cast<char>('0'+remainder%10));
+      remainder=remainder/10;
+    }
   }
   if (s.empty())
   {
@@ -784,12 +1305,17 @@ struct hash< mcrl2::utilities::big_natural_number >
 {
   std::size_t operator()(const mcrl2::utilities::big_natural_number& n) const
   {
-    hash<std::vector<std::size_t> > hasher;
-    return hasher(n.m_number);
+    hash<std::size_t> hasher;
+    std::size_t seed=0;
+    for(std::size_t i: n.m_number)
+    {
+      seed=mcrl2::utilities::detail::hash_combine(seed,hasher(i));
+    }
+    return seed;
   }
 };
 
-  
+
 } // namespace std
 
 namespace mcrl2
@@ -0,0 +1,217 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_UTILITIES_BITSTREAM_H_
+#define MCRL2_UTILITIES_BITSTREAM_H_
+
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/noncopyable.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief The number of bits needed to represent size, where zero and one need no bits at all. This suffices
+///        to store every index in the range [0, size).
+inline std::size_t bit_width(std::size_t size)
+{
+  std::size_t nr_bits = 0;
+  if (size <= 1)
+  {
+    return 0;
+  }
+
+  while (size)
+  {
+    size >>= 1;
+    nr_bits++;
+  }
+  return nr_bits;
+}
+
+/// \brief Writes individual bits to an output stream, where the most significant bits of each byte are written first.
+class obitstream : private noncopyable
+{
+public:
+  explicit obitstream(std::ostream& stream)
+    : m_stream(stream)
+  {}
+
+  /// \brief Writes the remaining bits, padded with zeroes to a full byte.
+  ~obitstream()
+  {
+    write_buffer();
+    m_stream.flush();
+  }
+
+  /// \brief Writes the number_of_bits least significant bits of value to the stream, with at most 64 bits.
+  void write_bits(std::size_t value, unsigned int number_of_bits)
+  {
+    while (number_of_bits > 0)
+    {
+      const unsigned int free_bits = 8 - m_bits_in_buffer;
+      const unsigned int bits = std::min(free_bits, number_of_bits);
+      number_of_bits -= bits;
+
+      const std::uint8_t part = static_cast<std::uint8_t>((value >> number_of_bits) & ((1u << bits) - 1));
+      m_buffer |= static_cast<std::uint8_t>(part << (free_bits - bits));
+      m_bits_in_buffer += bits;
+
+      if (m_bits_in_buffer == 8)
+      {
+        put(m_buffer);
+        m_buffer = 0;
+        m_bits_in_buffer = 0;
+      }
+    }
+  }
+
+  /// \brief Writes an unsigned integer using a variable number of bytes, seven bits per byte.
+  void write_integer(std::size_t value)
+  {
+    do
+    {
+      std::size_t part = value & 0x7f;
+      value >>= 7;
+      write_bits(value != 0 ? (part | 0x80) : part, 8);
+    }
+    while (value != 0);
+  }
+
+  /// \brief Writes the length of the string followed by its characters.
+  void write_string(const std::string& string)
+  {
+    write_integer(string.size());
+    for (char character : string)
+    {
+      write_bits(static_cast<unsigned char>(character), 8);
+    }
+  }
+
+  /// \brief Writes the remaining bits, padded with zeroes to a full byte, and flushes the underlying stream.
+  void flush()
+  {
+    write_buffer();
+    m_stream.flush();
+
+    if (m_stream.fail())
+    {
+      throw mcrl2::runtime_error("Failed to write the last byte to the output file/stream.");
+    }
+  }
+
+private:
+  /// \brief Writes a single byte to the stream buffer directly, which avoids constructing a sentry for every byte.
+  void put(std::uint8_t byte)
+  {
+    if (m_stream.rdbuf()->sputc(static_cast<char>(byte)) == std::char_traits<char>::eof())
+    {
+      m_stream.setstate(std::ios::badbit);
+    }
+  }
+
+  /// \brief Writes the bits in the buffer as a single byte.
+  void write_buffer()
+  {
+    if (m_bits_in_buffer > 0)
+    {
+      put(m_buffer);
+      m_buffer = 0;
+      m_bits_in_buffer = 0;
+    }
+  }
+
+  std::ostream& m_stream;
+  std::uint8_t m_buffer = 0;          ///< The bits that have not been written yet.
+  unsigned int m_bits_in_buffer = 0;  ///< The number of bits in m_buffer that are used.
+};
+
+/// \brief Reads individual bits from an input stream that was written by an obitstream.
+class ibitstream : private noncopyable
+{
+public:
+  explicit ibitstream(std::istream& stream)
+    : m_stream(stream)
+  {}
+
+  /// \brief Reads an unsigned integer of number_of_bits bits, with at most 64 bits.
+  /// \throws mcrl2::runtime_error when the end of the stream was reached.
+  std::size_t read_bits(unsigned int number_of_bits)
+  {
+    std::size_t value = 0;
+    while (number_of_bits > 0)
+    {
+      if (m_bits_in_buffer == 0)
+      {
+        // Reading from the stream buffer directly avoids constructing a sentry for every byte.
+        int byte = m_stream.rdbuf()->sbumpc();
+        if (byte == std::char_traits<char>::eof())
+        {
+          m_stream.setstate(std::ios::eofbit | std::ios::failbit);
+          throw mcrl2::runtime_error("Failed to read bits from the input file/stream, the end of the stream was reached unexpectedly.");
+        }
+
+        m_buffer = static_cast<std::uint8_t>(byte);
+        m_bits_in_buffer = 8;
+      }
+
+      const unsigned int bits = std::min(m_bits_in_buffer, number_of_bits);
+      number_of_bits -= bits;
+      m_bits_in_buffer -= bits;
+
+      value = (value << bits) | ((m_buffer >> m_bits_in_buffer) & ((1u << bits) - 1));
+    }
+
+    return value;
+  }
+
+  /// \brief Reads an unsigned integer that was written by obitstream::write_integer.
+  std::size_t read_integer()
+  {
+    std::size_t value = 0;
+    for (std::size_t shift = 0; ; shift += 7)
+    {
+      std::size_t part = read_bits(8);
+      value |= (part & 0x7f) << shift;
+
+      if ((part & 0x80) == 0)
+      {
+        return value;
+      }
+    }
+  }
+
+  /// \brief Reads a string that was written by obitstream::write_string.
+  std::string read_string()
+  {
+    std::string result(read_integer(), '\0');
+    for (char& character : result)
+    {
+      character = static_cast<char>(read_bits(8));
+    }
+    return result;
+  }
+
+private:
+  std::istream& m_stream;
+  std::uint8_t m_buffer = 0;          ///< The bits that have been read, but not yet returned.
+  unsigned int m_bits_in_buffer = 0;  ///< The number of bits in m_buffer that have not been returned.
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_BITSTREAM_H_
@@ -29,11 +29,33 @@ public:
   /// \brief Should be called when searching the cache was a miss.
   void miss() { ++m_miss_count; }
 
+  /// \brief Should be called when an element was evicted from the cache.
+  void evict() { ++m_eviction_count; }
+
+  /// \returns The number of times searching the cache was a hit.
+  std::size_t hit_count() const { return m_hit_count; }
+
+  /// \returns The number of times searching the cache was a miss.
+  std::size_t miss_count() const { return m_miss_count; }
+
+  /// \returns The number of elements that were evicted from the cache.
+  std::size_t eviction_count() const { return m_eviction_count; }
+
+  /// \brief Adds the counters of another cache, for example to report on a collection of caches.
+  cache_metric& operator+=(const cache_metric& other)
+  {
+    m_hit_count += other.m_hit_count;
+    m_miss_count += other.m_miss_count;
+    m_eviction_count += other.m_eviction_count;
+    return *this;
+  }
+
   /// \brief Resets the cache counters.
   void reset()
   {
     m_hit_count = 0;
     m_miss_count = 0;
+    m_eviction_count = 0;
   }
 
   /// \returns A message stating x hits, y misses (z %), where x,y,z indicate the number of hits, misses and percentage respectively.
@@ -41,13 +63,18 @@ public:
   {
     std::stringstream str;
     std::size_t total_count = m_hit_count + m_miss_count;
-    str << m_hit_count << " times found out of " << total_count << " calls (" << static_cast<double>(m_hit_count) / static_cast<double>(m_miss_count) * 100 << " %)";
+    str << m_hit_count << " times found out of " << total_count << " calls (" << (total_count == 0 ? 0.0 : static_cast<double>(m_hit_count) / static_cast<double>(total_count) * 100) << " %)";
+    if (m_eviction_count > 0)
+    {
+      str << ", " << m_eviction_count << " evictions";
+    }
     return str.str();
   }
 
 private:
   std::size_t m_hit_count = 0;
   std::size_t m_miss_count = 0;
+  std::size_t m_eviction_count = 0;
 
 };
 
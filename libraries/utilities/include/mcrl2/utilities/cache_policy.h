@@ -12,6 +12,12 @@
 
 #include "mcrl2/utilities/unordered_map.h"
 
+#include <forward_list>
+#include <limits>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 namespace mcrl2
 {
 namespace utilities
@@ -95,6 +101,11 @@ public:
     // Remove the first key (the first one to be inserted into the queue).
     auto it = map.find(m_queue.front());
     m_queue.erase_after(m_queue.before_begin());
+    if (m_queue.empty())
+    {
+      // The iterator to the last element was invalidated.
+      m_last_element_it = m_queue.before_begin();
+    }
     assert(it != map.end());
     return it;
   }
@@ -122,6 +133,171 @@ private:
   typename std::forward_list<Key>::iterator m_last_element_it;
 };
 
+/// \brief A policy that replaces the least recently used element, where both inserting and finding an element count as a use.
+template<typename Key, typename T>
+class lru_policy final : public replacement_policy<Key, T>
+{
+public:
+  using Map = typename replacement_policy<Key, T>::Map;
+
+  lru_policy() = default;
+
+  lru_policy(const lru_policy& other)
+    : m_queue(other.m_queue)
+  {
+    update_positions();
+  }
+
+  lru_policy& operator=(const lru_policy& other)
+  {
+    m_queue = other.m_queue;
+    update_positions();
+    return *this;
+  }
+
+  // Moving a std::list keeps the iterators stored in m_positions valid.
+  lru_policy(lru_policy&& other) noexcept = default;
+  lru_policy& operator=(lru_policy&& other) noexcept = default;
+
+  void clear() override
+  {
+    m_queue.clear();
+    m_positions.clear();
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_queue.empty());
+    // The back of the queue was used the longest time ago.
+    auto it = map.find(m_queue.back());
+    m_positions.erase(m_queue.back());
+    m_queue.pop_back();
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const Key& key) override
+  {
+    m_queue.push_front(key);
+    m_positions[key] = m_queue.begin();
+  }
+
+  void touch(const Key& key) override
+  {
+    auto it = m_positions.find(key);
+    if (it != m_positions.end())
+    {
+      // Move the key to the front without reallocating it.
+      m_queue.splice(m_queue.begin(), m_queue, it->second);
+    }
+  }
+
+private:
+  void update_positions()
+  {
+    m_positions.clear();
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+    {
+      m_positions[*it] = it;
+    }
+  }
+
+  std::list<Key> m_queue; ///< The keys ordered from the most to the least recently used.
+  std::unordered_map<Key, typename std::list<Key>::iterator> m_positions;
+};
+
+/// \brief A policy that approximates the least recently used policy with a reference bit per element (also known as second chance).
+/// \details The keys are placed on a circular buffer. A clock hand sweeps over the buffer, clearing the reference bits, and the
+///          first key that was not referenced since the previous sweep is replaced. In contrast to lru_policy the touch function
+///          only sets a bit.
+template<typename Key, typename T>
+class clock_policy final : public replacement_policy<Key, T>
+{
+public:
+  using Map = typename replacement_policy<Key, T>::Map;
+
+  void clear() override
+  {
+    m_clock.clear();
+    m_positions.clear();
+    m_hand = 0;
+    m_free_position = no_position;
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_clock.empty());
+    while (true)
+    {
+      if (m_hand >= m_clock.size())
+      {
+        m_hand = 0;
+      }
+
+      entry& candidate = m_clock[m_hand];
+      if (candidate.referenced)
+      {
+        // Give the key a second chance.
+        candidate.referenced = false;
+        ++m_hand;
+      }
+      else
+      {
+        auto it = map.find(candidate.key);
+        assert(it != map.end());
+        m_positions.erase(candidate.key);
+
+        // The next inserted key takes the place of the replaced key.
+        candidate.key = Key();
+        m_free_position = m_hand;
+        ++m_hand;
+        return it;
+      }
+    }
+  }
+
+  void inserted(const Key& key) override
+  {
+    if (m_free_position != no_position)
+    {
+      m_clock[m_free_position] = entry{key, false};
+      m_positions[key] = m_free_position;
+      m_free_position = no_position;
+    }
+    else
+    {
+      m_positions[key] = m_clock.size();
+      m_clock.push_back(entry{key, false});
+    }
+  }
+
+  void touch(const Key& key) override
+  {
+    auto it = m_positions.find(key);
+    if (it != m_positions.end())
+    {
+      m_clock[it->second].referenced = true;
+    }
+  }
+
+private:
+  struct entry
+  {
+    Key key;
+    bool referenced;
+  };
+
+  static constexpr std::size_t no_position = std::numeric_limits<std::size_t>::max();
+
+  std::vector<entry> m_clock;
+  std::unordered_map<Key, std::size_t> m_positions; ///< The position of every key on the clock.
+  std::size_t m_hand = 0;
+  std::size_t m_free_position = no_position;        ///< The position of the key that was replaced last, if any.
+};
+
+template<typename Key, typename T>
+constexpr std::size_t clock_policy<Key, T>::no_position;
+
 } // namespace utilities
 } // namespace mcrl2
 
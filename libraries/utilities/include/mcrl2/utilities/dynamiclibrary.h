@@ -146,8 +146,13 @@ class dynamic_library
         mCRL2log(mcrl2::log::error) << "Error while unloading dynamic library: " << error.what() << std::endl;
       }
     }
-  
-    library_proc proc_address(const std::string& name) 
+
+    const std::string& filename() const
+    {
+      return m_filename;
+    }
+
+    library_proc proc_address(const std::string& name)
     {
       if (m_library == 0)
       {
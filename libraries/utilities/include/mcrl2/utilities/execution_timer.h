@@ -13,12 +13,19 @@
 #define MCRL2_UTILITIES_EXECUTION_TIMER_H
 
 #include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/platform.h"
+#include <chrono>
 #include <ctime>
-#include <cmath>
 #include <fstream>
+#include <iostream>
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+#include <sys/resource.h>
+#endif
 
 namespace mcrl2
 {
@@ -26,71 +33,245 @@ namespace mcrl2
 namespace utilities
 {
 
-/// \brief Simple timer to time the CPU time used by a piece of code.
+/// \brief The formats in which an execution_timer can write its report.
+enum class timing_format
+{
+  yaml, ///< An entry in a YAML list, such that a file collects the timings of multiple runs.
+  json  ///< A JSON object on a single line, such that a file collects the timings of multiple runs.
+};
+
+/// \returns The timing format with the given name, i.e., yaml or json.
+inline timing_format parse_timing_format(const std::string& text)
+{
+  if (text == "yaml")
+  {
+    return timing_format::yaml;
+  }
+  else if (text == "json")
+  {
+    return timing_format::json;
+  }
+  throw mcrl2::runtime_error("Unknown timing format '" + text + "', expected yaml or json.");
+}
+
+/// \returns The peak resident set size of this process in bytes, or zero when it cannot be determined.
+inline std::size_t peak_resident_set_size()
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  struct rusage usage;
+  if (::getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef MCRL2_PLATFORM_MAC
+    // Reported in bytes on Mac OS.
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // Reported in kilobytes on Linux and the BSDs.
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
+/// \brief Simple timer to time the wall clock time, the CPU time and the peak memory usage of phases of a tool.
 ///
 /// Example usage:
 /// execution_timer timer("test_tool", "/path/to/file")
 /// timer.start("hint")
 /// ... (execute some code here) ...
+/// timer.start("nested hint")
+/// ... (execute some code here) ...
+/// timer.finish("nested hint")
 /// timer.finish("hint")
 /// timer.report()
 ///
-/// This will output the following to the file "/path/to/file", or
-/// standard error if filename is empty, assuming that the time between
-/// start and finish is n seconds (with precision of 2 decimal places).
+/// A phase that is started while another phase is running becomes a child of
+/// the most recently started phase that is still running. By default this will
+/// output the following to the file "/path/to/file", or standard error if
+/// filename is empty, where the times are in seconds and the peak resident set
+/// size of the process at the end of a phase is in bytes.
 /// - tool: test_tool
 ///   timing:
-///     hint: n
+///     hint:
+///       wall: n
+///       cpu: n
+///       peak_rss: n
+///       phases:
+///         nested hint:
+///           wall: n
+///           cpu: n
+///           peak_rss: n
 ///
 /// Note that this is an output format that can immediately be parsed using
-/// YAML (http://www.yaml.org/)
+/// YAML (http://www.yaml.org/). Alternatively, the same information is written
+/// as a JSON object on a single line.
+///
+/// The CPU time is the processor time of the whole process, so for phases that
+/// use multiple threads it can exceed the wall clock time, and a wall clock time
+/// that exceeds the CPU time indicates that the phase was waiting, e.g., for I/O.
 class execution_timer
 {
   protected:
+    typedef std::chrono::steady_clock clock_type;
 
-    /// \brief Pair of start and finish times
+    /// \brief The start and finish measurements of a phase.
     struct timing
     {
-      clock_t start;
-      clock_t finish;
+      std::string name;
+      std::size_t parent; ///< The index of the enclosing phase, or no_parent for a top level phase.
+      bool finished = false;
 
-      timing() :
-        start(0),
-        finish(0)
+      clock_type::time_point wall_start;
+      clock_type::time_point wall_finish;
+      clock_t cpu_start = 0;
+      clock_t cpu_finish = 0;
+      std::size_t peak_rss = 0;
+
+      timing(const std::string& name_, std::size_t parent_)
+        : name(name_),
+          parent(parent_)
       {}
     };
 
+    static constexpr std::size_t no_parent = static_cast<std::size_t>(-1);
+
     std::string m_tool_name; //!< name of the tool we are timing
     std::string m_filename; //!< name of the file to write timings to
-    std::map<std::string, timing> m_timings; //!< collection of timings
+    timing_format m_format; //!< the format of the report
+    std::vector<timing> m_timings; //!< collection of timings, in the order in which they were started
+    std::map<std::string, std::size_t> m_indices; //!< the index of each timing in m_timings
+    std::vector<std::size_t> m_running; //!< the timings that are running, the innermost one is last
 
-    /// \brief Write the report to an output stream.
-    /// \param[in] s The output stream to which the report is written.
-    void write_report(std::ostream& s)
+    static double seconds(clock_type::duration duration)
     {
-      std::ios::fmtflags oldflags = s.setf(std::ios::fixed, std::ios::floatfield);
-      s.precision((std::streamsize) (log10(CLOCKS_PER_SEC) + 0.95));
+      return std::chrono::duration<double>(duration).count();
+    }
+
+    static std::string escape_json(const std::string& text)
+    {
+      std::string result;
+      for (char c: text)
+      {
+        if (c == '"' || c == '\\')
+        {
+          result += '\\';
+        }
+        result += c;
+      }
+      return result;
+    }
+
+    /// \brief Checks that the timing has finished consistently.
+    void check(const timing& t) const
+    {
+      if (t.finished && (t.wall_start > t.wall_finish || t.cpu_start > t.cpu_finish))
+      {
+        throw mcrl2::runtime_error("Start of " + t.name + " occurred after finish.");
+      }
+    }
+
+    /// \brief Write the timing with the given index, and the timings nested in it, in YAML.
+    void write_yaml(std::ostream& s, std::size_t index, const std::string& indent) const
+    {
+      const timing& t = m_timings[index];
+      check(t);
+      if (!t.finished)
+      {
+        s << indent << t.name << ": did not finish. " << std::endl;
+        return;
+      }
+
+      s << indent << t.name << ":" << std::endl
+        << indent << "  wall: " << seconds(t.wall_finish - t.wall_start) << std::endl
+        << indent << "  cpu: " << static_cast<double>(t.cpu_finish - t.cpu_start) / CLOCKS_PER_SEC << std::endl
+        << indent << "  peak_rss: " << t.peak_rss << std::endl;
+
+      bool first = true;
+      for (std::size_t i = index + 1; i < m_timings.size(); ++i)
+      {
+        if (m_timings[i].parent == index)
+        {
+          if (first)
+          {
+            s << indent << "  phases:" << std::endl;
+            first = false;
+          }
+          write_yaml(s, i, indent + "    ");
+        }
+      }
+    }
 
-      s << "- tool: " << m_tool_name << std::endl
-        << "  timing:" << std::endl;
+    /// \brief Write the timing with the given index, and the timings nested in it, as a JSON member.
+    void write_json(std::ostream& s, std::size_t index) const
+    {
+      const timing& t = m_timings[index];
+      check(t);
+      s << "\"" << escape_json(t.name) << "\": {";
+      if (t.finished)
+      {
+        s << "\"wall\": " << seconds(t.wall_finish - t.wall_start)
+          << ", \"cpu\": " << static_cast<double>(t.cpu_finish - t.cpu_start) / CLOCKS_PER_SEC
+          << ", \"peak_rss\": " << t.peak_rss;
+      }
+      else
+      {
+        s << "\"finished\": false";
+      }
 
-      for (std::map<std::string, timing>::const_iterator i = m_timings.begin(); i != m_timings.end(); ++i)
+      bool first = true;
+      for (std::size_t i = index + 1; i < m_timings.size(); ++i)
       {
-        if (i->second.finish==0)
+        if (m_timings[i].parent == index)
         {
-          s << "    " << i->first << ": did not finish. " << std::endl;
+          s << (first ? ", \"phases\": {" : ", ");
+          first = false;
+          write_json(s, i);
         }
-        else if (i->second.start > i->second.finish)
+      }
+      if (!first)
+      {
+        s << "}";
+      }
+      s << "}";
+    }
+
+    /// \brief Write the report to an output stream.
+    /// \param[in] s The output stream to which the report is written.
+    void write_report(std::ostream& s) const
+    {
+      std::ios::fmtflags oldflags = s.setf(std::ios::fixed, std::ios::floatfield);
+      std::streamsize oldprecision = s.precision(6);
+
+      if (m_format == timing_format::json)
+      {
+        s << "{\"tool\": \"" << escape_json(m_tool_name) << "\", \"timing\": {";
+        bool first = true;
+        for (std::size_t i = 0; i < m_timings.size(); ++i)
         {
-          throw mcrl2::runtime_error("Start of " + i->first + " occurred after finish.");
+          if (m_timings[i].parent == no_parent)
+          {
+            s << (first ? "" : ", ");
+            first = false;
+            write_json(s, i);
+          }
         }
-        else
+        s << "}}" << std::endl;
+      }
+      else
+      {
+        s << "- tool: " << m_tool_name << std::endl
+          << "  timing:" << std::endl;
+
+        for (std::size_t i = 0; i < m_timings.size(); ++i)
         {
-          s << "    " << i->first << ": "
-            << static_cast<double>(i->second.finish - i->second.start) / CLOCKS_PER_SEC
-            << std::endl;
+          if (m_timings[i].parent == no_parent)
+          {
+            write_yaml(s, i, "    ");
+          }
         }
       }
+
+      s.precision(oldprecision);
       s.flags(oldflags);
     }
 
@@ -99,9 +280,11 @@ class execution_timer
     /// \brief Constructor of a simple execution timer
     /// \param[in] tool_name Name of the tool that does the measurements
     /// \param[in] filename Name of the file to which the measurements are written
-    execution_timer(const std::string& tool_name = "", std::string const& filename = "") :
+    /// \param[in] format The format in which the measurements are written
+    execution_timer(const std::string& tool_name = "", std::string const& filename = "", timing_format format = timing_format::yaml) :
       m_tool_name(tool_name),
-      m_filename(filename)
+      m_filename(filename),
+      m_format(format)
     {}
 
     /// \brief Destructor
@@ -111,16 +294,27 @@ class execution_timer
     /// \brief Start measurement with a hint
     /// \param[in] timing_name Name of the measurement being started
     /// \pre No start(timing_name) has occurred before
-    /// \post The current time has been recorded as starting time of timing_name
+    /// \post The current time has been recorded as starting time of timing_name, and
+    ///       timing_name is nested in the innermost running measurement
     void start(const std::string& timing_name)
     {
-      std::map<std::string, timing>::iterator t = m_timings.lower_bound(timing_name);
-      if (t != m_timings.end() && t->first == timing_name)
+      if (m_indices.find(timing_name) != m_indices.end())
       {
         throw mcrl2::runtime_error("Starting already known timing '" + timing_name + "'. This causes unreliable results.");
       }
-      t = m_timings.insert(t, make_pair(timing_name, timing()));
-      t->second.start = clock();
+
+      std::size_t parent = no_parent;
+      if (!m_running.empty())
+      {
+        parent = m_running.back();
+      }
+      m_indices[timing_name] = m_timings.size();
+      m_timings.emplace_back(timing_name, parent);
+      m_running.push_back(m_timings.size() - 1);
+
+      timing& t = m_timings.back();
+      t.cpu_start = clock();
+      t.wall_start = clock_type::now();
     }
 
     /// \brief Finish a measurement with a hint
@@ -129,17 +323,34 @@ class execution_timer
     /// \post The current time has been recorded as end time of timing_name
     void finish(const std::string& timing_name)
     {
-      clock_t finish = clock();
-      const std::map<std::string, timing>::iterator t = m_timings.find(timing_name);
-      if (t == m_timings.end())
+      const clock_type::time_point wall_finish = clock_type::now();
+      const clock_t cpu_finish = clock();
+
+      const std::map<std::string, std::size_t>::const_iterator i = m_indices.find(timing_name);
+      if (i == m_indices.end())
       {
         throw mcrl2::runtime_error("Finishing timing '" + timing_name + "' that was not started.");
       }
-      if (0 != t->second.finish)
+
+      timing& t = m_timings[i->second];
+      if (t.finished)
       {
         throw mcrl2::runtime_error("Finishing timing '" + timing_name + "' for the second time.");
       }
-      t->second.finish = finish;
+      t.finished = true;
+      t.wall_finish = wall_finish;
+      t.cpu_finish = cpu_finish;
+      t.peak_rss = peak_resident_set_size();
+
+      // Phases are not required to finish in the reverse order in which they started.
+      for (std::vector<std::size_t>::iterator j = m_running.begin(); j != m_running.end(); ++j)
+      {
+        if (*j == i->second)
+        {
+          m_running.erase(j);
+          break;
+        }
+      }
     }
 
     /// \brief Write all timing information that has been recorded.
@@ -147,7 +358,7 @@ class execution_timer
     /// Timing information is written to the filename that was provided in
     /// the constructor. If no filename was provided (i.e. the filename is
     /// empty) the information is written to standard error.
-    /// The output is in YAML compatible format.
+    /// The output is in YAML compatible format, or JSON.
     void report()
     {
       if (m_filename.empty())
@@ -163,6 +374,11 @@ class execution_timer
       }
     }
 
+    /// \brief Write all timing information that has been recorded to the given stream.
+    void report(std::ostream& out) const
+    {
+      write_report(out);
+    }
 };
 
 } // namespace utilities
@@ -10,6 +10,7 @@
 #ifndef MCRL2_UTILITIES_FIXED_SIZE_CACHE_H
 #define MCRL2_UTILITIES_FIXED_SIZE_CACHE_H
 
+#include "mcrl2/utilities/cache_metric.h"
 #include "mcrl2/utilities/cache_policy.h"
 
 namespace mcrl2
@@ -17,13 +18,26 @@ namespace mcrl2
 namespace utilities
 {
 
+/// \brief Estimates the number of bytes occupied by a cached key-value pair by its static size.
+template<typename Key, typename T>
+struct static_entry_size
+{
+  std::size_t operator()(const Key&, const T&) const
+  {
+    return sizeof(std::pair<Key, T>);
+  }
+};
+
 /// \brief A cache keeps track of key-value pairs similar to a map. The difference is that a cache
 ///        has (an optional) maximum size and a policy that determines what element gets evicted when
 ///        the cache is full.
-/// \details Works with arbirary maps that implement the unordered_map interface.
+/// \details Works with arbirary maps that implement the unordered_map interface. Next to the maximum
+///          number of elements the cache can be given a memory budget, in which case elements are evicted
+///          until the (approximate) size of the cached pairs, as determined by EntrySize, fits the budget.
 template<typename Key,
   typename T,
-  typename Policy = no_policy<Key, T>>
+  typename Policy = no_policy<Key, T>,
+  typename EntrySize = static_entry_size<Key, T>>
 class fixed_size_cache
 {
 private:
@@ -33,8 +47,11 @@ private:
 public:
   using iterator = typename Map::iterator;
 
-  explicit fixed_size_cache(std::size_t max_size = 1024)
-    : m_map(max_size)
+  /// \param max_size The maximum number of elements, where zero means unbounded.
+  /// \param memory_budget The maximum number of bytes occupied by the elements, where zero means unbounded.
+  explicit fixed_size_cache(std::size_t max_size = 1024, std::size_t memory_budget = 0)
+    : m_map(max_size),
+      m_memory_budget(memory_budget == 0 ? std::numeric_limits<std::size_t>::max() : memory_budget)
   {
     if (max_size == 0)
     {
@@ -51,13 +68,24 @@ public:
   iterator begin() { return m_map.begin(); }
   iterator end() { return m_map.end(); }
 
-  void clear() { m_map.clear(); m_policy.clear(); }
+  void clear() { m_map.clear(); m_policy.clear(); m_memory_usage = 0; }
 
   std::size_t count(const Key& key) const { return m_map.count(key); }
 
+  /// \brief Searches the key in the cache, which counts as a use of the key for the policy.
   iterator find(const Key& key)
   {
-    return m_map.find(key);
+    auto result = m_map.find(key);
+    if (result == m_map.end())
+    {
+      m_metrics.miss();
+    }
+    else
+    {
+      m_metrics.hit();
+      m_policy.touch(key);
+    }
+    return result;
   }
 
   /// \brief Stores the given key-value pair in the cache. Depending on the cache policy and capacity an existing elements
@@ -71,15 +99,21 @@ public:
     auto result = m_map.find(args...);
     if (result == m_map.end())
     {
-      // If the cache would be full after an inserted.
-      if (m_map.size() + 1 >= m_maximum_size)
+      const Pair pair(std::forward<Args>(args)...);
+      const std::size_t size = m_entry_size(pair.first, pair.second);
+
+      // Remove existing elements defined by the policy while the cache would be full after an insertion.
+      while (m_map.size() > 0 && (m_map.size() + 1 >= m_maximum_size || m_memory_usage + size > m_memory_budget))
       {
-        // Remove an existing element defined by the policy.
-        m_map.erase(m_policy.replacement_candidate(m_map));
+        auto candidate = m_policy.replacement_candidate(m_map);
+        m_memory_usage -= m_entry_size((*candidate).first, (*candidate).second);
+        m_map.erase(candidate);
+        m_metrics.evict();
       }
 
       // Insert an element and inform the policy that an element was inserted.
-      auto emplace_result = m_map.emplace(std::forward<Args>(args)...);
+      auto emplace_result = m_map.emplace(pair);
+      m_memory_usage += size;
       m_policy.inserted((*emplace_result.first).first);
       return emplace_result;
     }
@@ -88,17 +122,40 @@ public:
     return std::make_pair(result, false);
   }
 
+  std::size_t size() const { return m_map.size(); }
+
+  /// \returns The approximate number of bytes occupied by the cached elements.
+  std::size_t memory_usage() const { return m_memory_usage; }
+
+  /// \returns The number of hits, misses and evictions of this cache.
+  const cache_metric& metrics() const { return m_metrics; }
+
 private:
   Map    m_map;    ///< The underlying mapping from keys to their cached results.
   Policy m_policy; ///< The replacement policy for keys in the cache.
+  EntrySize m_entry_size;
 
   std::size_t m_maximum_size; ///< The maximum number of elements to cache.
+  std::size_t m_memory_budget; ///< The maximum number of bytes occupied by the cached elements.
+  std::size_t m_memory_usage = 0;
+
+  cache_metric m_metrics;
 };
 
 template<typename Key,
   typename T>
 using fifo_cache = fixed_size_cache<Key, T, fifo_policy<Key, T>>;
 
+template<typename Key,
+  typename T,
+  typename EntrySize = static_entry_size<Key, T>>
+using lru_cache = fixed_size_cache<Key, T, lru_policy<Key, T>, EntrySize>;
+
+template<typename Key,
+  typename T,
+  typename EntrySize = static_entry_size<Key, T>>
+using clock_cache = fixed_size_cache<Key, T, clock_policy<Key, T>, EntrySize>;
+
 } // namespace utilities
 } // namespace mcrl2
 
@@ -9,15 +9,75 @@
 #ifndef MCRL2_UTILITIES_INDEXED_SET_H
 #define MCRL2_UTILITIES_INDEXED_SET_H
 
-#include "mcrl2/utilities/unordered_map.h"
-#include "mcrl2/utilities/block_allocator.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace mcrl2
 {
 namespace utilities
 {
 
-/// \brief A set that assigns each element an unique index.
+/// \brief An iterator over the (key, index) pairs of an indexed_set in the order of their indices.
+template<typename Set>
+class indexed_set_iterator
+{
+public:
+  using value_type = typename Set::value_type;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::forward_iterator_tag;
+
+  indexed_set_iterator() = default;
+
+  indexed_set_iterator(const Set& set, std::size_t index)
+    : m_set(&set),
+      m_index(index)
+  {}
+
+  reference operator*() const { return m_set->element(m_index); }
+  pointer operator->() const { return &m_set->element(m_index); }
+
+  indexed_set_iterator& operator++()
+  {
+    ++m_index;
+    return *this;
+  }
+
+  indexed_set_iterator operator++(int)
+  {
+    indexed_set_iterator result = *this;
+    ++m_index;
+    return result;
+  }
+
+  bool operator==(const indexed_set_iterator& other) const { return m_index == other.m_index; }
+  bool operator!=(const indexed_set_iterator& other) const { return m_index != other.m_index; }
+
+private:
+  const Set* m_set = nullptr;
+  std::size_t m_index = 0;
+};
+
+/// \brief A set that assigns each element an unique index, where the indices are consecutive and start at zero.
+/// \details The elements are stored in segments that never move, so references to elements and their indices
+///          remain valid until the set is cleared. The hash table only stores the indices, tagged by sixteen
+///          bits of the hash, such that most mismatches are detected without accessing the element.
+///
+///          When ThreadSafe is true the set can be used by multiple threads concurrently. The insert function
+///          locks one of the stripes determined by the hash of the key, and an element is only published in
+///          the hash table after it has been constructed. As such, find, index and at never take a lock and
+///          concurrent inserts of the same key obtain the same index. Resizing the hash table locks all
+///          stripes, but lookups can continue in the previous table which is kept alive until the set is
+///          cleared. The functions clear, copy and assignment are not thread-safe.
 template<typename Key,
          typename Hash = std::hash<Key>,
          typename Equals = std::equal_to<Key>,
@@ -25,50 +85,153 @@ template<typename Key,
          bool ThreadSafe = false>
 class indexed_set
 {
+public:
+  using key_type = Key;
+  using value_type = std::pair<const Key, std::size_t>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equals;
+
+  using iterator = indexed_set_iterator<indexed_set>;
+  using const_iterator = iterator;
+
+  /// \brief The index that is returned when a key does not occur in the set.
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  indexed_set()
+    : indexed_set(128)
+  {}
+
+  explicit indexed_set(std::size_t initial_size, const hasher& hash = hasher(), const key_equal& equals = key_equal());
+
+  indexed_set(const indexed_set& other);
+  indexed_set& operator=(const indexed_set& other);
+
+  indexed_set(indexed_set&& other);
+  indexed_set& operator=(indexed_set&& other);
+
+  ~indexed_set();
+
+  /// \returns The index of the given key.
+  /// \throws std::out_of_range when the key does not occur in the set.
+  std::size_t at(const Key& key) const;
+
+  /// \returns The key with the given index, which must be smaller than size().
+  const Key& operator[](std::size_t index) const { return element(index).first; }
+
+  /// \returns The index of the given key, or npos when it does not occur in the set.
+  std::size_t index(const Key& key) const;
+
+  iterator begin() const { return iterator(*this, 0); }
+  iterator end() const { return iterator(*this, size()); }
+
+  /// \brief Removes all elements from the set, the indices start at zero again.
+  void clear();
+
+  /// \returns The number of elements equal to the given key, i.e., either zero or one.
+  std::size_t count(const Key& key) const { return index(key) == npos ? 0 : 1; }
+
+  /// \brief Inserts the given key when it does not yet occur in the set.
+  /// \returns An iterator to the (key, index) pair, and whether the key was inserted.
+  std::pair<iterator, bool> insert(const Key& key);
+
+  /// \returns An iterator to the (key, index) pair of the given key, or end() when it does not occur in the set.
+  iterator find(const Key& key) const;
+
+  /// \returns The number of indices that have been handed out.
+  /// \details For a thread-safe set the insertion of the last elements can still be in progress.
+  std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+  /// \returns The number of slots in the hash table.
+  std::size_t capacity() const { return m_table.load(std::memory_order_acquire)->slots.size(); }
+
 private:
-  using T = std::size_t;
-  using Map = unordered_map<Key, T, Hash, Equals, Allocator, ThreadSafe>;
+  friend class indexed_set_iterator<indexed_set>;
 
-  Map m_map;
-public:
-  using iterator = typename Map::iterator;
-  using const_iterator = typename Map::const_iterator;
+  using ElementAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+
+  /// \brief The number of elements in the first segment, every next segment is twice as large.
+  static constexpr std::size_t first_segment_bits = 10;
+  static constexpr std::size_t number_of_segments = std::numeric_limits<std::uint64_t>::digits - first_segment_bits;
+
+  /// \brief The number of mutexes that protect the insertions into the set.
+  static constexpr std::size_t number_of_stripes = 64;
 
-  // The interface of an unordered_map without the ability to remove individual elements.
+  /// \brief A slot stores the tag in its upper bits and the index in its lower bits.
+  static constexpr std::size_t tag_bits = 16;
+  static constexpr std::uint64_t index_mask = (static_cast<std::uint64_t>(1) << (64 - tag_bits)) - 1;
+  static constexpr std::uint64_t empty_slot = std::numeric_limits<std::uint64_t>::max();
 
-  indexed_set() {}
-  indexed_set(std::size_t initial_size) : m_map(initial_size) {}
+  /// \brief A hash table of slots using linear probing.
+  struct table
+  {
+    explicit table(std::size_t capacity);
 
-  const T& at(const Key& key) const { return m_map.at(key); }
+    std::vector<std::atomic<std::uint64_t>> slots;
+    std::size_t mask;
+    std::size_t shift;     ///< The first slot consists of the upper 64 - shift bits of the hash.
+    std::size_t threshold; ///< The number of elements after which the table is resized.
+  };
 
-  iterator begin() { return m_map.begin(); }
-  iterator end() { return m_map.end(); }
+  /// \brief The mutexes that are only used when ThreadSafe is true.
+  struct locks
+  {
+    std::array<std::mutex, number_of_stripes> stripes;
+    std::mutex segments;
+  };
 
-  const_iterator begin() const { return m_map.begin(); }
-  const_iterator end() const { return m_map.end(); }
+  /// \returns The (key, index) pair with the given index.
+  const value_type& element(std::size_t index) const;
 
-  void clear() { m_map.clear(); }
-  int count(const Key& key) { return m_map.count(key); }
+  /// \brief Constructs the (key, index) pair at the given index, allocating a new segment when necessary.
+  void construct_element(const Key& key, std::size_t index);
 
-  template<typename ...Args>
-  std::pair<iterator, bool> insert(const Key& key) { return m_map.emplace(key, size()); }
+  /// \brief Destroys all elements and frees the segments.
+  void destroy_elements();
 
-  iterator find(const Key& key) { return m_map.find(key); }
-  const_iterator find(const Key& key) const { return m_map.find(key); }
+  /// \returns The index of the key in the given table, or npos when it does not occur.
+  std::size_t find_in(const table& table, const Key& key, std::uint64_t hash) const;
 
-  std::size_t size() const { return m_map.size(); }
+  /// \brief Stores the index in the first empty slot in the probing sequence of the hash.
+  void place(table& table, std::uint64_t hash, std::size_t index);
+
+  /// \brief Doubles the size of the hash table when the threshold has been reached.
+  void resize();
+
+  /// \returns The hash of the key with its bits mixed, as the hashes of terms are derived from their addresses.
+  std::uint64_t mixed_hash(const Key& key) const;
+
+  /// \returns The slot value for the given index, which is tagged by the hash.
+  static std::uint64_t slot_value(std::uint64_t hash, std::size_t index);
+
+  /// \returns The stripe that protects the insertion of keys with this hash.
+  static std::size_t stripe(std::uint64_t hash);
+
+  std::atomic<table*> m_table;
+  std::vector<std::unique_ptr<table>> m_tables; ///< The current table is the last one, the others can still be read.
+
+  std::array<std::atomic<value_type*>, number_of_segments> m_segments;
+  std::atomic<std::size_t> m_size;
+
+  std::unique_ptr<locks> m_locks;
+  std::size_t m_initial_size;
+
+  Hash m_hash;
+  Equals m_equals;
+  ElementAllocator m_allocator;
 };
 
-/// \brief A specialization for large indexed sets that uses the block_allocator internally (by default).
+/// \brief A specialization for large indexed sets, which is equal to the indexed set as its elements are already stored in large segments.
 template<typename Key,
          typename Hash = std::hash<Key>,
          typename Equals = std::equal_to<Key>,
-         typename Allocator = mcrl2::utilities::block_allocator<Key>,
+         typename Allocator = std::allocator<Key>,
          bool ThreadSafe = false>
 using indexed_set_large = indexed_set<Key, Hash, Equals, Allocator, ThreadSafe>;
 
-}
-}
+} // namespace utilities
+} // namespace mcrl2
 
+#include "mcrl2/utilities/indexed_set_implementation.h"
 
 #endif // MCRL2_UTILITIES_INDEXED_SET_H
@@ -0,0 +1,412 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef MCRL2_UTILITIES_INDEXED_SET_IMPLEMENTATION_H
+#define MCRL2_UTILITIES_INDEXED_SET_IMPLEMENTATION_H
+#pragma once
+
+#define MCRL2_INDEXED_SET_TEMPLATES template<typename Key, typename Hash, typename Equals, typename Allocator, bool ThreadSafe>
+#define MCRL2_INDEXED_SET_CLASS indexed_set<Key, Hash, Equals, Allocator, ThreadSafe>
+
+#include "mcrl2/utilities/indexed_set.h"
+#include "mcrl2/utilities/power_of_two.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+namespace detail
+{
+
+/// \returns The position of the most significant bit of the given non-zero value.
+inline std::size_t most_significant_bit(std::uint64_t value)
+{
+  assert(value != 0);
+#ifdef __GNUC__
+  return static_cast<std::size_t>(std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(value));
+#else
+  std::size_t result = 0;
+  while (value >>= 1)
+  {
+    ++result;
+  }
+  return result;
+#endif
+}
+
+/// \brief Computes the segment that contains the given index and the offset of the index in that segment.
+/// \details Segment s contains 2^(first_segment_bits + s) elements, so the indices in it are offset by
+///          2^first_segment_bits * (2^s - 1).
+inline std::size_t indexed_set_segment(std::size_t index, std::size_t first_segment_bits, std::size_t& offset)
+{
+  const std::uint64_t shifted = static_cast<std::uint64_t>(index) + (static_cast<std::uint64_t>(1) << first_segment_bits);
+  const std::size_t bit = most_significant_bit(shifted);
+  offset = static_cast<std::size_t>(shifted - (static_cast<std::uint64_t>(1) << bit));
+  return bit - first_segment_bits;
+}
+
+} // namespace detail
+
+MCRL2_INDEXED_SET_TEMPLATES
+constexpr std::size_t MCRL2_INDEXED_SET_CLASS::npos;
+
+MCRL2_INDEXED_SET_TEMPLATES
+MCRL2_INDEXED_SET_CLASS::table::table(std::size_t capacity)
+  : slots(capacity),
+    mask(capacity - 1),
+    shift(std::numeric_limits<std::uint64_t>::digits - detail::most_significant_bit(capacity)),
+    threshold(capacity / 4 * 3)
+{
+  assert(is_power_of_two(capacity));
+  for (std::atomic<std::uint64_t>& slot : slots)
+  {
+    slot.store(empty_slot, std::memory_order_relaxed);
+  }
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+MCRL2_INDEXED_SET_CLASS::indexed_set(std::size_t initial_size, const hasher& hash, const key_equal& equals)
+  : m_size(0),
+    m_initial_size(initial_size),
+    m_hash(hash),
+    m_equals(equals)
+{
+  for (std::atomic<value_type*>& segment : m_segments)
+  {
+    segment.store(nullptr, std::memory_order_relaxed);
+  }
+
+  // The initial size must fit below the threshold of the initial table.
+  m_tables.emplace_back(new table(std::max<std::size_t>(round_up_to_power_of_two(initial_size + initial_size / 3 + 1), 16)));
+  m_table.store(m_tables.back().get(), std::memory_order_release);
+
+  if (ThreadSafe)
+  {
+    m_locks.reset(new locks());
+  }
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+MCRL2_INDEXED_SET_CLASS::indexed_set(const indexed_set& other)
+  : indexed_set(std::max(other.size(), other.m_initial_size), other.m_hash, other.m_equals)
+{
+  // Inserting the elements in the order of their indices results in the same indices.
+  for (const value_type& element : other)
+  {
+    insert(element.first);
+  }
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+MCRL2_INDEXED_SET_CLASS& MCRL2_INDEXED_SET_CLASS::operator=(const indexed_set& other)
+{
+  if (this != &other)
+  {
+    clear();
+    m_hash = other.m_hash;
+    m_equals = other.m_equals;
+
+    for (const value_type& element : other)
+    {
+      insert(element.first);
+    }
+  }
+
+  return *this;
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+MCRL2_INDEXED_SET_CLASS::indexed_set(indexed_set&& other)
+  : indexed_set(other.m_initial_size, other.m_hash, other.m_equals)
+{
+  *this = std::move(other);
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+MCRL2_INDEXED_SET_CLASS& MCRL2_INDEXED_SET_CLASS::operator=(indexed_set&& other)
+{
+  if (this != &other)
+  {
+    // Exchange the contents such that the moved-from set remains a valid (empty) set.
+    destroy_elements();
+    for (std::size_t i = 0; i < number_of_segments; ++i)
+    {
+      m_segments[i].store(other.m_segments[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      other.m_segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+    m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.m_size.store(0, std::memory_order_relaxed);
+
+    std::swap(m_tables, other.m_tables);
+    m_table.store(m_tables.back().get(), std::memory_order_release);
+    other.clear();
+    other.m_table.store(other.m_tables.back().get(), std::memory_order_release);
+
+    m_initial_size = other.m_initial_size;
+    m_hash = std::move(other.m_hash);
+    m_equals = std::move(other.m_equals);
+    m_allocator = std::move(other.m_allocator);
+  }
+
+  return *this;
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+MCRL2_INDEXED_SET_CLASS::~indexed_set()
+{
+  destroy_elements();
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+std::size_t MCRL2_INDEXED_SET_CLASS::at(const Key& key) const
+{
+  const std::size_t result = index(key);
+  if (result == npos)
+  {
+    throw std::out_of_range("indexed_set: the given key does not occur in the set.");
+  }
+
+  return result;
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+std::size_t MCRL2_INDEXED_SET_CLASS::index(const Key& key) const
+{
+  return find_in(*m_table.load(std::memory_order_acquire), key, mixed_hash(key));
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+void MCRL2_INDEXED_SET_CLASS::clear()
+{
+  destroy_elements();
+
+  // Only keep the current table, which is emptied.
+  std::unique_ptr<table> current = std::move(m_tables.back());
+  m_tables.clear();
+  for (std::atomic<std::uint64_t>& slot : current->slots)
+  {
+    slot.store(empty_slot, std::memory_order_relaxed);
+  }
+  m_tables.push_back(std::move(current));
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+std::pair<typename MCRL2_INDEXED_SET_CLASS::iterator, bool> MCRL2_INDEXED_SET_CLASS::insert(const Key& key)
+{
+  const std::uint64_t hash = mixed_hash(key);
+
+  // The table is resized beforehand, so the table that the index is placed into is never full. Concurrent
+  // insertions can exceed the threshold by at most the number of threads.
+  if (m_size.load(std::memory_order_relaxed) >= m_table.load(std::memory_order_acquire)->threshold)
+  {
+    resize();
+  }
+
+  // Keys with the same hash share their stripe, so they cannot be inserted twice concurrently.
+  std::unique_lock<std::mutex> guard;
+  if (ThreadSafe)
+  {
+    guard = std::unique_lock<std::mutex>(m_locks->stripes[stripe(hash)]);
+  }
+
+  // The table cannot change while this stripe is locked.
+  table& current = *m_table.load(std::memory_order_acquire);
+  std::size_t index = find_in(current, key, hash);
+  if (index != npos)
+  {
+    return std::make_pair(iterator(*this, index), false);
+  }
+
+  index = m_size.fetch_add(1, std::memory_order_acq_rel);
+  assert(index <= index_mask);
+  construct_element(key, index);
+  place(current, hash, index);
+  return std::make_pair(iterator(*this, index), true);
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+typename MCRL2_INDEXED_SET_CLASS::iterator MCRL2_INDEXED_SET_CLASS::find(const Key& key) const
+{
+  const std::size_t result = index(key);
+  return result == npos ? end() : iterator(*this, result);
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+const typename MCRL2_INDEXED_SET_CLASS::value_type& MCRL2_INDEXED_SET_CLASS::element(std::size_t index) const
+{
+  std::size_t offset;
+  const std::size_t segment = detail::indexed_set_segment(index, first_segment_bits, offset);
+  return m_segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+void MCRL2_INDEXED_SET_CLASS::construct_element(const Key& key, std::size_t index)
+{
+  std::size_t offset;
+  const std::size_t segment = detail::indexed_set_segment(index, first_segment_bits, offset);
+
+  value_type* elements = m_segments[segment].load(std::memory_order_acquire);
+  if (elements == nullptr)
+  {
+    std::unique_lock<std::mutex> guard;
+    if (ThreadSafe)
+    {
+      guard = std::unique_lock<std::mutex>(m_locks->segments);
+    }
+
+    elements = m_segments[segment].load(std::memory_order_acquire);
+    if (elements == nullptr)
+    {
+      elements = m_allocator.allocate(static_cast<std::size_t>(1) << (first_segment_bits + segment));
+      m_segments[segment].store(elements, std::memory_order_release);
+    }
+  }
+
+  std::allocator_traits<ElementAllocator>::construct(m_allocator, elements + offset, key, index);
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+void MCRL2_INDEXED_SET_CLASS::destroy_elements()
+{
+  const std::size_t size = m_size.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    std::allocator_traits<ElementAllocator>::destroy(m_allocator, const_cast<value_type*>(&element(i)));
+  }
+
+  for (std::size_t i = 0; i < number_of_segments; ++i)
+  {
+    value_type* elements = m_segments[i].load(std::memory_order_relaxed);
+    if (elements != nullptr)
+    {
+      m_allocator.deallocate(elements, static_cast<std::size_t>(1) << (first_segment_bits + i));
+      m_segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  m_size.store(0, std::memory_order_release);
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+std::size_t MCRL2_INDEXED_SET_CLASS::find_in(const table& table, const Key& key, std::uint64_t hash) const
+{
+  const std::uint64_t tag = slot_value(hash, 0);
+  for (std::size_t position = static_cast<std::size_t>(hash >> table.shift); ; position = (position + 1) & table.mask)
+  {
+    // The acquire ensures that the element of a published index has been constructed.
+    const std::uint64_t value = table.slots[position].load(std::memory_order_acquire);
+    if (value == empty_slot)
+    {
+      return npos;
+    }
+
+    // Only compare the keys when the tags are equal.
+    if ((value & ~index_mask) == tag)
+    {
+      const std::size_t index = static_cast<std::size_t>(value & index_mask);
+      if (m_equals(element(index).first, key))
+      {
+        return index;
+      }
+    }
+  }
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+void MCRL2_INDEXED_SET_CLASS::place(table& table, std::uint64_t hash, std::size_t index)
+{
+  const std::uint64_t value = slot_value(hash, index);
+  for (std::size_t position = static_cast<std::size_t>(hash >> table.shift); ; position = (position + 1) & table.mask)
+  {
+    std::atomic<std::uint64_t>& slot = table.slots[position];
+    if (ThreadSafe)
+    {
+      // Other stripes can claim the same slot concurrently.
+      std::uint64_t expected = empty_slot;
+      if (slot.compare_exchange_strong(expected, value, std::memory_order_release, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+    else if (slot.load(std::memory_order_relaxed) == empty_slot)
+    {
+      slot.store(value, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+void MCRL2_INDEXED_SET_CLASS::resize()
+{
+  // Lock all stripes, in order, to wait for the insertions that are in progress.
+  std::vector<std::unique_lock<std::mutex>> guards;
+  if (ThreadSafe)
+  {
+    guards.reserve(number_of_stripes);
+    for (std::mutex& mutex : m_locks->stripes)
+    {
+      guards.emplace_back(mutex);
+    }
+  }
+
+  // Another thread might have resized the table in the mean time.
+  table& current = *m_table.load(std::memory_order_acquire);
+  const std::size_t size = m_size.load(std::memory_order_acquire);
+  if (size < current.threshold)
+  {
+    return;
+  }
+
+  std::unique_ptr<table> resized(new table(2 * current.slots.size()));
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    place(*resized, mixed_hash(element(i).first), i);
+  }
+
+  m_table.store(resized.get(), std::memory_order_release);
+  if (!ThreadSafe)
+  {
+    // Without concurrent readers the previous table can be removed immediately.
+    m_tables.clear();
+  }
+  m_tables.push_back(std::move(resized));
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+std::uint64_t MCRL2_INDEXED_SET_CLASS::mixed_hash(const Key& key) const
+{
+  const std::uint64_t hash = static_cast<std::uint64_t>(m_hash(key));
+  return (hash ^ (hash >> 29)) * 11400714819323198485ull;
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+std::uint64_t MCRL2_INDEXED_SET_CLASS::slot_value(std::uint64_t hash, std::size_t index)
+{
+  // The lower bits of the multiplication are poorly mixed, and the upper bits determine the first slot.
+  return (((hash >> 8) & ((static_cast<std::uint64_t>(1) << tag_bits) - 1)) << (64 - tag_bits)) | static_cast<std::uint64_t>(index);
+}
+
+MCRL2_INDEXED_SET_TEMPLATES
+std::size_t MCRL2_INDEXED_SET_CLASS::stripe(std::uint64_t hash)
+{
+  return static_cast<std::size_t>((hash >> 24) & (number_of_stripes - 1));
+}
+
+#undef MCRL2_INDEXED_SET_CLASS
+#undef MCRL2_INDEXED_SET_TEMPLATES
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_INDEXED_SET_IMPLEMENTATION_H
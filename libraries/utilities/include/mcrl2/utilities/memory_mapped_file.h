@@ -0,0 +1,124 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_UTILITIES_MEMORY_MAPPED_FILE_H_
+#define MCRL2_UTILITIES_MEMORY_MAPPED_FILE_H_
+
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/noncopyable.h"
+#include "mcrl2/utilities/platform.h"
+
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief Maps the contents of a file read-only into memory for the lifetime of this object.
+/// \details On platforms without mmap the contents are read into memory instead.
+class memory_mapped_file : private noncopyable
+{
+public:
+  /// \throws mcrl2::runtime_error when the file cannot be opened or mapped.
+  explicit memory_mapped_file(const std::string& filename)
+  {
+#ifdef MCRL2_PLATFORM_WINDOWS
+    std::ifstream is(filename, std::ios::binary);
+    if (!is)
+    {
+      throw mcrl2::runtime_error("Could not open file " + filename + " for reading.");
+    }
+    m_contents.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    m_data = m_contents.data();
+    m_size = m_contents.size();
+#else
+    int descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor == -1)
+    {
+      throw mcrl2::runtime_error("Could not open file " + filename + " for reading.");
+    }
+
+    struct stat status;
+    if (::fstat(descriptor, &status) == -1)
+    {
+      ::close(descriptor);
+      throw mcrl2::runtime_error("Could not determine the size of file " + filename + ".");
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+
+    if (m_size > 0)
+    {
+      void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (address == MAP_FAILED)
+      {
+        ::close(descriptor);
+        throw mcrl2::runtime_error("Could not map file " + filename + " into memory.");
+      }
+
+      // The contents are read sequentially, which allows the kernel to read ahead aggressively.
+      ::madvise(address, m_size, MADV_SEQUENTIAL);
+      m_data = static_cast<const char*>(address);
+    }
+
+    // The mapping remains valid after the file descriptor has been closed.
+    ::close(descriptor);
+#endif
+  }
+
+  ~memory_mapped_file()
+  {
+#ifndef MCRL2_PLATFORM_WINDOWS
+    if (m_data != nullptr)
+    {
+      ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+  }
+
+  /// \returns A pointer to the first byte of the file.
+  const char* data() const { return m_data; }
+
+  /// \returns The number of bytes in the file.
+  std::size_t size() const { return m_size; }
+
+private:
+  const char* m_data = nullptr;
+  std::size_t m_size = 0;
+
+#ifdef MCRL2_PLATFORM_WINDOWS
+  std::vector<char> m_contents;
+#endif
+};
+
+/// \brief A read-only stream buffer for a contiguous region of memory, which does not copy its contents.
+class memory_streambuf : public std::streambuf
+{
+public:
+  memory_streambuf(const char* data, std::size_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_MEMORY_MAPPED_FILE_H_
@@ -12,6 +12,7 @@
 
 #include "mcrl2/utilities/detail/free_list.h"
 #include "mcrl2/utilities/noncopyable.h"
+#include "mcrl2/utilities/page_allocator.h"
 #include "mcrl2/utilities/spinlock.h"
 
 #include <array>
@@ -28,7 +29,9 @@ namespace utilities
 {
 
 /// \brief The memory pool allocates elements of size T from blocks.
-/// \details When ThreadSafe is true then the thread-safe guarantees will be satisfied.
+/// \details When ThreadSafe is true then the thread-safe guarantees will be satisfied. The blocks are
+///          obtained from a page_allocator, so they are backed by huge pages when these are enabled
+///          by set_page_backing() or the MCRL2_HUGE_PAGES environment variable.
 template <class T, 
           std::size_t ElementsPerBlock = 1024, 
           bool ThreadSafe = false>
@@ -115,8 +118,18 @@ public:
   /// \brief Free the memory used by the given pointer that has been allocated by this pool.
   void deallocate(T* pointer)
   {
+    if (ThreadSafe)
+    {
+      m_block_mutex.lock();
+    }
+
     assert(contains(pointer));
     m_freelist.push_front(reinterpret_cast<Slot&>(*pointer));
+
+    if (ThreadSafe)
+    {
+      m_block_mutex.unlock();
+    }
   }
 
   /// \brief Frees blocks that are no longer storing elements of T.
@@ -204,7 +217,7 @@ private:
   SizeType m_number_of_blocks = 0;
 
   /// \brief The list of blocks allocated by this pool.
-  std::forward_list<Block> m_blocks;
+  std::forward_list<Block, page_allocator<Block>> m_blocks;
 
   /// \brief Ensures that the block list is only modified by a single thread.
   mcrl2::utilities::spinlock m_block_mutex = {};
@@ -0,0 +1,358 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef MCRL2_UTILITIES_OPEN_ADDRESSING_SET_H
+#define MCRL2_UTILITIES_OPEN_ADDRESSING_SET_H
+
+#include "mcrl2/utilities/unordered_set.h"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+namespace detail
+{
+
+/// \brief The control bytes of a group of slots in an open_addressing_set.
+/// \details A full slot is marked by a seven bit tag of its hash, so its control byte is non-negative. Empty
+///          and deleted slots have their most significant bit set. All operations return a bit mask where
+///          the i-th bit corresponds to the i-th slot in the group.
+class control_group
+{
+public:
+  static constexpr std::size_t width = 16;
+
+  static constexpr std::int8_t empty = -128;
+  static constexpr std::int8_t deleted = -2;
+
+  explicit control_group(const std::int8_t* position)
+#ifdef __SSE2__
+    : m_control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position)))
+#else
+    : m_position(position)
+#endif
+  {}
+
+  /// \returns A mask of the slots with the given tag.
+  std::uint32_t match(std::int8_t tag) const
+  {
+#ifdef __SSE2__
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_control, _mm_set1_epi8(tag))));
+#else
+    return match_if([tag](std::int8_t control) { return control == tag; });
+#endif
+  }
+
+  /// \returns A mask of the empty slots.
+  std::uint32_t match_empty() const
+  {
+    return match(empty);
+  }
+
+  /// \returns A mask of the slots that are empty or deleted, i.e., the slots that are not full.
+  std::uint32_t match_empty_or_deleted() const
+  {
+#ifdef __SSE2__
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(m_control));
+#else
+    return match_if([](std::int8_t control) { return control < 0; });
+#endif
+  }
+
+private:
+#ifdef __SSE2__
+  __m128i m_control;
+#else
+  template<typename Predicate>
+  std::uint32_t match_if(Predicate predicate) const
+  {
+    std::uint32_t result = 0;
+    for (std::size_t i = 0; i < width; ++i)
+    {
+      if (predicate(m_position[i]))
+      {
+        result |= 1u << i;
+      }
+    }
+    return result;
+  }
+
+  const std::int8_t* m_position;
+#endif
+};
+
+/// \returns The index of the least significant bit that is set in a non-zero mask.
+inline std::size_t lowest_bit(std::uint32_t mask)
+{
+  assert(mask != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+  std::size_t result = 0;
+  while ((mask & 1u) == 0)
+  {
+    mask >>= 1;
+    ++result;
+  }
+  return result;
+#endif
+}
+
+} // namespace detail
+
+/// \brief An iterator over all elements in the open addressing set.
+template<typename Key, bool Constant = false>
+class open_addressing_set_iterator
+{
+private:
+  using slot_pointer = typename std::conditional<Constant, Key* const*, Key**>::type;
+
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Key;
+  using difference_type = std::ptrdiff_t;
+  using reference = typename std::conditional<Constant, const Key&, Key&>::type;
+  using pointer = typename std::conditional<Constant, const Key*, Key*>::type;
+
+  /// \brief Construct an iterator that points to the first full slot at or after the given index.
+  open_addressing_set_iterator(const std::int8_t* control, slot_pointer slots, std::size_t index, std::size_t capacity)
+    : m_control(control), m_slots(slots), m_index(index), m_capacity(capacity)
+  {
+    goto_next_full();
+  }
+
+  /// \brief A non constant iterator can be converted to a constant iterator.
+  template<bool C = Constant, typename std::enable_if<C>::type* = nullptr>
+  open_addressing_set_iterator(const open_addressing_set_iterator<Key, false>& other)
+    : m_control(other.m_control), m_slots(other.m_slots), m_index(other.m_index), m_capacity(other.m_capacity)
+  {}
+
+  open_addressing_set_iterator& operator++()
+  {
+    ++m_index;
+    goto_next_full();
+    return *this;
+  }
+
+  reference operator*() const
+  {
+    assert(m_index < m_capacity && m_control[m_index] >= 0);
+    return *m_slots[m_index];
+  }
+
+  pointer operator->() const
+  {
+    return &**this;
+  }
+
+  bool operator==(const open_addressing_set_iterator& other) const
+  {
+    return m_index == other.m_index;
+  }
+
+  bool operator!=(const open_addressing_set_iterator& other) const
+  {
+    return !(*this == other);
+  }
+
+  /// \returns The index of the slot that this iterator points to.
+  std::size_t index() const { return m_index; }
+
+private:
+  friend class open_addressing_set_iterator<Key, true>;
+
+  /// \brief Moves the iterator forward until it points to a full slot or the end.
+  void goto_next_full()
+  {
+    while (m_index < m_capacity && m_control[m_index] < 0)
+    {
+      ++m_index;
+    }
+  }
+
+  const std::int8_t* m_control;
+  slot_pointer m_slots;
+  std::size_t m_index;
+  std::size_t m_capacity;
+};
+
+/// \brief A hash set with the same interface as unordered_set that uses open addressing instead of chaining.
+/// \details The slots are grouped into groups of sixteen consecutive slots. For every slot a control byte stores
+///          seven bits of the hash of its element, or whether it is empty or deleted. A lookup first compares
+///          the control bytes of a whole group to the tag of the searched element, using a single SSE2
+///          comparison when available, and only compares the elements whose tag matches. The control bytes
+///          of a group fit in a single cache line, so a lookup typically only dereferences the element that
+///          it finds. Groups are probed using triangular numbers, which visits every group once.
+///
+///          The elements themselves are allocated individually, so their addresses are stable under
+///          insertions and removals, as the term pool requires. Also supports allocators with a specialized
+///          allocate_args(args...), like unordered_set.
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename Equals = std::equal_to<Key>,
+         typename Allocator = std::allocator<Key>,
+         bool ThreadSafe = false>
+class open_addressing_set
+{
+private:
+  using KeyAllocator = typename Allocator::template rebind<Key>::other;
+  using group = detail::control_group;
+
+public:
+  using iterator = open_addressing_set_iterator<Key, false>;
+  using const_iterator = open_addressing_set_iterator<Key, true>;
+
+  /// \brief Constructs an open_addressing_set that can store initial_size number of elements before resizing.
+  explicit open_addressing_set(std::size_t initial_size) { resize(minimum_capacity(initial_size)); }
+  open_addressing_set() { resize(static_cast<std::size_t>(group::width)); }
+
+  // Copy operators.
+  open_addressing_set(const open_addressing_set& set);
+  open_addressing_set& operator=(const open_addressing_set& set);
+
+  // Move operators, the moved-from set is left without slots.
+  open_addressing_set(open_addressing_set&& other) noexcept;
+  open_addressing_set& operator=(open_addressing_set&& other) noexcept;
+
+  ~open_addressing_set();
+
+  /// \returns An iterator over all keys.
+  iterator begin() { return iterator(m_control.data(), m_slots.data(), 0, capacity()); }
+  iterator end() { return iterator(m_control.data(), m_slots.data(), capacity(), capacity()); }
+
+  /// \returns A const iterator over all keys.
+  const_iterator begin() const { return const_iterator(m_control.data(), m_slots.data(), 0, capacity()); }
+  const_iterator end() const { return const_iterator(m_control.data(), m_slots.data(), capacity(), capacity()); }
+
+  /// \brief Removes all elements from the set.
+  /// \details Does not free the slots themselves.
+  void clear();
+
+  /// \brief Counts the number of occurrences of the given key (1 when it exists and 0 otherwise).
+  template<typename ...Args>
+  std::size_t count(const Args&... args) const;
+
+  /// \brief Inserts an element Key(args...) into the set if it did not already exist.
+  /// \returns A pair of the iterator pointing to the element and a boolean that is true iff
+  ///         a new element was inserted (as opposed to it already existing in the set).
+  template<typename ...Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  /// \brief Erases the given key from the set.
+  /// \details Needs to find the key first.
+  void erase(Key& key);
+
+  /// \brief Erases the element pointed to by the iterator.
+  /// \returns An iterator to the next key.
+  iterator erase(iterator it);
+
+  /// \brief Searches whether an object Key(args...) occurs in the set.
+  /// \returns An iterator to the matching element or the end when this object does not exist.
+  template<typename...Args>
+  const_iterator find(const Args&... args) const;
+
+  template<typename...Args>
+  iterator find(const Args&... args);
+
+  /// \brief Prints various information about the slots and the probe lengths.
+  void print_performance_statistics() const;
+
+  /// \returns A histogram where the i-th entry is the number of slots that store i keys, i.e., the first
+  ///          entry counts the slots that are not full and the second entry the slots that are.
+  std::vector<std::size_t> bucket_length_histogram() const;
+
+  /// \returns The amount of elements stored in this set.
+  std::size_t size() const noexcept { return m_number_of_elements; }
+
+  /// \returns The number of slots, which is larger than the number of elements that can be stored before resizing.
+  std::size_t capacity() const noexcept { return m_slots.size(); }
+
+  /// \returns A reference to the local allocator.
+  const KeyAllocator& allocator() const noexcept { return m_allocator; }
+  KeyAllocator& allocator() noexcept { return m_allocator; }
+
+private:
+  /// \returns The smallest capacity that can store the given number of elements without resizing.
+  static std::size_t minimum_capacity(std::size_t number_of_elements)
+  {
+    return std::max<std::size_t>(round_up_to_power_of_two(number_of_elements + number_of_elements / 7), static_cast<std::size_t>(group::width));
+  }
+
+  /// \returns The first group in the probe sequence of the given hash.
+  /// \details Like unordered_set this uses the lowest bits of the hash, so that elements with consecutive
+  ///          hashes, such as terms whose arguments were allocated consecutively, are stored close together.
+  ///          However, two consecutive hashes share a group instead of sixteen, as otherwise consecutive
+  ///          hashes fill complete groups and all other elements of those groups must be probed elsewhere.
+  std::size_t first_group(std::size_t hash) const noexcept
+  {
+    return (hash >> 1) & m_groups_mask;
+  }
+
+  /// \returns The tag stored in the control byte of a full slot, which consists of seven bits of the hash.
+  /// \details The tag is taken from the highest bits of the Fibonacci hash, which are independent of the
+  ///          lowest bits of the hash that determine the group.
+  static std::int8_t tag(std::size_t hash) noexcept
+  {
+    return static_cast<std::int8_t>((hash * static_cast<std::size_t>(11400714819323198485ULL)) >> (std::numeric_limits<std::size_t>::digits - 7));
+  }
+
+  /// \returns The index of the slot with an element equivalent to Key(args...), or the capacity when it does not exist.
+  template<typename ...Args>
+  std::size_t find_impl(std::size_t hash, const Args&... args) const;
+
+  /// \returns The index of the first slot in the probe sequence of hash that is not full.
+  std::size_t find_free_slot(std::size_t hash) const;
+
+  /// \brief Marks the given slot as full and stores the element in it.
+  void set_full(std::size_t index, std::size_t hash, Key* element);
+
+  /// \brief Removes the element from the given slot.
+  void erase_impl(std::size_t index);
+
+  /// \brief Resizes or cleans up the deleted slots when no empty slot can be used without exceeding the maximum load.
+  void resize_if_needed();
+
+  /// \brief Resizes the set to the given number of slots, which also removes all deleted slots.
+  void resize(std::size_t new_capacity);
+
+  /// \returns The maximum number of full and deleted slots, which is seven eighth of the capacity.
+  std::size_t maximum_load() const noexcept { return capacity() - capacity() / 8; }
+
+  /// \brief The number of elements stored in this set.
+  std::size_t m_number_of_elements = 0;
+
+  /// \brief The number of slots that are marked as deleted.
+  std::size_t m_number_of_deleted = 0;
+
+  /// \brief Always equal to capacity() / group::width - 1.
+  std::size_t m_groups_mask = 0;
+
+  std::vector<std::int8_t> m_control;
+  std::vector<Key*> m_slots;
+  KeyAllocator m_allocator;
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#include "open_addressing_set_implementation.h"
+
+#endif // MCRL2_UTILITIES_OPEN_ADDRESSING_SET_H
@@ -0,0 +1,377 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef MCRL2_UTILITIES_OPEN_ADDRESSING_SET_IMPLEMENTATION_H
+#define MCRL2_UTILITIES_OPEN_ADDRESSING_SET_IMPLEMENTATION_H
+#pragma once
+
+#define MCRL2_OPEN_ADDRESSING_SET_TEMPLATES template<typename Key, typename Hash, typename Equals, typename Allocator, bool ThreadSafe>
+#define MCRL2_OPEN_ADDRESSING_SET_CLASS open_addressing_set<Key, Hash, Equals, Allocator, ThreadSafe>
+
+#include "mcrl2/utilities/open_addressing_set.h"
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS::open_addressing_set(const open_addressing_set& set)
+{
+  resize(minimum_capacity(set.size()));
+
+  for (auto& element : set)
+  {
+    emplace(element);
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS& MCRL2_OPEN_ADDRESSING_SET_CLASS::operator=(const open_addressing_set& set)
+{
+  if (this != &set)
+  {
+    clear();
+    resize(minimum_capacity(set.size()));
+
+    for (auto& element : set)
+    {
+      emplace(element);
+    }
+  }
+
+  return *this;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS::open_addressing_set(open_addressing_set&& other) noexcept
+  : m_number_of_elements(other.m_number_of_elements),
+    m_number_of_deleted(other.m_number_of_deleted),
+    m_groups_mask(other.m_groups_mask),
+    m_control(std::move(other.m_control)),
+    m_slots(std::move(other.m_slots)),
+    m_allocator(std::move(other.m_allocator))
+{
+  other.m_control.clear();
+  other.m_slots.clear();
+  other.m_number_of_elements = 0;
+  other.m_number_of_deleted = 0;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS& MCRL2_OPEN_ADDRESSING_SET_CLASS::operator=(open_addressing_set&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (m_slots.size() > 0)
+    {
+      clear();
+    }
+
+    m_number_of_elements = other.m_number_of_elements;
+    m_number_of_deleted = other.m_number_of_deleted;
+    m_groups_mask = other.m_groups_mask;
+    m_control = std::move(other.m_control);
+    m_slots = std::move(other.m_slots);
+    m_allocator = std::move(other.m_allocator);
+
+    other.m_control.clear();
+    other.m_slots.clear();
+    other.m_number_of_elements = 0;
+    other.m_number_of_deleted = 0;
+  }
+
+  return *this;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+MCRL2_OPEN_ADDRESSING_SET_CLASS::~open_addressing_set()
+{
+  // This open_addressing_set is not moved-from.
+  if (m_slots.size() > 0)
+  {
+    clear();
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::clear()
+{
+  for (std::size_t index = 0; index < capacity(); ++index)
+  {
+    if (m_control[index] >= 0)
+    {
+      std::allocator_traits<KeyAllocator>::destroy(m_allocator, m_slots[index]);
+      std::allocator_traits<KeyAllocator>::deallocate(m_allocator, m_slots[index], 1);
+      m_slots[index] = nullptr;
+    }
+  }
+
+  std::fill(m_control.begin(), m_control.end(), static_cast<std::int8_t>(group::empty));
+  m_number_of_elements = 0;
+  m_number_of_deleted = 0;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+std::size_t MCRL2_OPEN_ADDRESSING_SET_CLASS::count(const Args&... args) const
+{
+  return find(args...) != end();
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+std::pair<typename MCRL2_OPEN_ADDRESSING_SET_CLASS::iterator, bool> MCRL2_OPEN_ADDRESSING_SET_CLASS::emplace(Args&&... args)
+{
+  const std::size_t hash = Hash()(args...);
+  std::size_t index = find_impl(hash, args...);
+
+  if (index != capacity())
+  {
+    return std::make_pair(iterator(m_control.data(), m_slots.data(), index, capacity()), false);
+  }
+
+  // Construct the new element before changing the table, as the construction might throw.
+  Key* element = allocate<Key>(m_allocator, args...);
+  std::allocator_traits<KeyAllocator>::construct(m_allocator, element, std::forward<Args>(args)...);
+
+  resize_if_needed();
+  index = find_free_slot(hash);
+  set_full(index, hash, element);
+  ++m_number_of_elements;
+
+  return std::make_pair(iterator(m_control.data(), m_slots.data(), index, capacity()), true);
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+typename MCRL2_OPEN_ADDRESSING_SET_CLASS::iterator MCRL2_OPEN_ADDRESSING_SET_CLASS::erase(typename MCRL2_OPEN_ADDRESSING_SET_CLASS::iterator it)
+{
+  const std::size_t index = it.index();
+  erase_impl(index);
+
+  // The slot is no longer full, so the iterator moves to the next full slot.
+  return iterator(m_control.data(), m_slots.data(), index, capacity());
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::erase(Key& key)
+{
+  const std::size_t index = find_impl(Hash()(key), key);
+  if (index != capacity())
+  {
+    erase_impl(index);
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+typename MCRL2_OPEN_ADDRESSING_SET_CLASS::const_iterator MCRL2_OPEN_ADDRESSING_SET_CLASS::find(const Args&... args) const
+{
+  return const_iterator(m_control.data(), m_slots.data(), find_impl(Hash()(args...), args...), capacity());
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+typename MCRL2_OPEN_ADDRESSING_SET_CLASS::iterator MCRL2_OPEN_ADDRESSING_SET_CLASS::find(const Args&... args)
+{
+  return iterator(m_control.data(), m_slots.data(), find_impl(Hash()(args...), args...), capacity());
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+std::vector<std::size_t> MCRL2_OPEN_ADDRESSING_SET_CLASS::bucket_length_histogram() const
+{
+  std::vector<std::size_t> histogram(2, 0);
+  histogram[1] = m_number_of_elements;
+  histogram[0] = capacity() - m_number_of_elements;
+  return histogram;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::print_performance_statistics() const
+{
+  // Calculate a histogram of the number of groups that are probed to find each element.
+  std::vector<std::size_t> histogram;
+  for (std::size_t index = 0; index < capacity(); ++index)
+  {
+    if (m_control[index] >= 0)
+    {
+      const std::size_t hash = Hash()(*m_slots[index]);
+      std::size_t group_index = first_group(hash);
+
+      std::size_t probes = 1;
+      for (std::size_t step = 1; group_index != index / group::width; ++step)
+      {
+        group_index = (group_index + step) & m_groups_mask;
+        ++probes;
+      }
+
+      histogram.resize(std::max(histogram.size(), probes + 1));
+      ++histogram[probes];
+    }
+  }
+
+  mCRL2log(mcrl2::log::debug, "Performance") << "Table stores " << size() << " keys, using approximately "
+    << bytes_to_megabytes(m_allocator.capacity() * sizeof(Key)) << " MB for elements, and "
+    << bytes_to_megabytes(capacity() * (sizeof(Key*) + sizeof(std::int8_t))) << " MB for " << capacity() << " slots of which "
+    << m_number_of_deleted << " are deleted.\n";
+  for (std::size_t i = 1; i < histogram.size(); ++i)
+  {
+    mCRL2log(mcrl2::log::debug, "Performance") << "There are " << histogram[i] << " keys that are found after probing " << i << " groups.\n";
+  }
+}
+
+/// Private functions
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+template<typename ...Args>
+std::size_t MCRL2_OPEN_ADDRESSING_SET_CLASS::find_impl(std::size_t hash, const Args&... args) const
+{
+  const std::int8_t tag = this->tag(hash);
+  std::size_t group_index = first_group(hash);
+
+  // There is always an empty slot, because the number of full and deleted slots is bounded by the maximum load.
+  for (std::size_t step = 1; ; ++step)
+  {
+    const std::size_t offset = group_index * group::width;
+    const group control(m_control.data() + offset);
+
+    for (std::uint32_t mask = control.match(tag); mask != 0; mask &= mask - 1)
+    {
+      const std::size_t index = offset + detail::lowest_bit(mask);
+      if (Equals()(*m_slots[index], args...))
+      {
+        return index;
+      }
+    }
+
+    if (control.match_empty() != 0)
+    {
+      // The element would have been inserted into this group.
+      return capacity();
+    }
+
+    group_index = (group_index + step) & m_groups_mask;
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+std::size_t MCRL2_OPEN_ADDRESSING_SET_CLASS::find_free_slot(std::size_t hash) const
+{
+  std::size_t group_index = first_group(hash);
+
+  for (std::size_t step = 1; ; ++step)
+  {
+    const std::size_t offset = group_index * group::width;
+    const std::uint32_t mask = group(m_control.data() + offset).match_empty_or_deleted();
+    if (mask != 0)
+    {
+      return offset + detail::lowest_bit(mask);
+    }
+
+    group_index = (group_index + step) & m_groups_mask;
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::set_full(std::size_t index, std::size_t hash, Key* element)
+{
+  assert(m_control[index] < 0);
+  if (m_control[index] == group::deleted)
+  {
+    --m_number_of_deleted;
+  }
+
+  m_control[index] = tag(hash);
+  m_slots[index] = element;
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::erase_impl(std::size_t index)
+{
+  assert(m_control[index] >= 0);
+
+  std::allocator_traits<KeyAllocator>::destroy(m_allocator, m_slots[index]);
+  std::allocator_traits<KeyAllocator>::deallocate(m_allocator, m_slots[index], 1);
+  m_slots[index] = nullptr;
+  --m_number_of_elements;
+
+  // A lookup only stops at a group with an empty slot. When this group already has an empty slot every
+  // lookup stops here anyway, so the slot can become empty. Otherwise, lookups that continue past this
+  // group must still do so, so the slot is marked as deleted.
+  const std::size_t offset = index - index % group::width;
+  if (group(m_control.data() + offset).match_empty() != 0)
+  {
+    m_control[index] = group::empty;
+  }
+  else
+  {
+    m_control[index] = group::deleted;
+    ++m_number_of_deleted;
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::resize_if_needed()
+{
+  if (m_number_of_elements + m_number_of_deleted + 1 > maximum_load())
+  {
+    // When many slots are deleted it suffices to remove them, otherwise the number of slots is doubled.
+    if (m_number_of_elements + 1 <= maximum_load() / 2)
+    {
+      resize(capacity());
+    }
+    else
+    {
+      resize(capacity() * 2);
+    }
+  }
+}
+
+MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+void MCRL2_OPEN_ADDRESSING_SET_CLASS::resize(std::size_t new_capacity)
+{
+  assert(is_power_of_two(new_capacity) && new_capacity >= group::width);
+
+  // Keep the elements, but don't move or copy them.
+  std::vector<Key*> old_elements;
+  old_elements.reserve(m_number_of_elements);
+  for (std::size_t index = 0; index < capacity(); ++index)
+  {
+    if (m_control[index] >= 0)
+    {
+      old_elements.push_back(m_slots[index]);
+    }
+  }
+
+  {
+    // clear() doesn't actually free the memory used.
+    std::vector<std::int8_t>().swap(m_control);
+    std::vector<Key*>().swap(m_slots);
+  }
+  m_control.resize(new_capacity, static_cast<std::int8_t>(group::empty));
+  m_slots.resize(new_capacity, nullptr);
+  m_groups_mask = new_capacity / group::width - 1;
+  m_number_of_deleted = 0;
+
+  // Fill the set with all elements of the previous set, which are known to be unique.
+  for (Key* element : old_elements)
+  {
+    const std::size_t hash = Hash()(*element);
+    set_full(find_free_slot(hash), hash, element);
+  }
+
+  // The number of elements remain the same, so don't change this counter.
+}
+
+#undef MCRL2_OPEN_ADDRESSING_SET_CLASS
+#undef MCRL2_OPEN_ADDRESSING_SET_TEMPLATES
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_OPEN_ADDRESSING_SET_IMPLEMENTATION_H
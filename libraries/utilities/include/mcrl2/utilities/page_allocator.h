@@ -0,0 +1,441 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_UTILITIES_PAGE_ALLOCATOR_H_
+#define MCRL2_UTILITIES_PAGE_ALLOCATOR_H_
+
+#include "mcrl2/utilities/noncopyable.h"
+#include "mcrl2/utilities/platform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+#include <sys/resource.h>
+#endif
+
+#ifdef MCRL2_PLATFORM_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief Determines how the memory of the blocks of a memory_pool is obtained.
+enum class page_backing
+{
+  standard,               ///< Use the default allocator.
+  transparent_huge_pages, ///< Use regions that the kernel is advised to back by transparent huge pages.
+  huge_pages              ///< Use regions of explicitly reserved huge pages, or transparent huge pages when none are available.
+};
+
+/// \returns A textual representation of the page backing.
+inline std::string to_string(page_backing backing)
+{
+  switch (backing)
+  {
+    case page_backing::transparent_huge_pages: return "transparent_huge_pages";
+    case page_backing::huge_pages: return "huge_pages";
+    default: return "standard";
+  }
+}
+
+/// \brief Statistics about the memory obtained by page allocators and the page faults of this process.
+struct page_statistics
+{
+  page_backing backing = page_backing::standard;
+  std::size_t minor_page_faults = 0;   ///< Page faults that were served without I/O, since the start of the process.
+  std::size_t major_page_faults = 0;   ///< Page faults that required I/O, since the start of the process.
+  std::size_t regions = 0;             ///< The number of regions that are currently mapped.
+  std::size_t huge_page_regions = 0;   ///< The number of those regions that consist of explicitly reserved huge pages.
+  std::size_t bytes = 0;               ///< The number of bytes in those regions.
+  std::size_t huge_page_fallbacks = 0; ///< The number of times that no explicitly reserved huge pages were available.
+};
+
+namespace detail
+{
+
+/// \brief The process wide configuration and counters of the page allocators.
+struct page_configuration
+{
+  /// \brief Reads the initial configuration from the MCRL2_HUGE_PAGES environment variable, which
+  ///        can be set to "transparent" or "explicit" to enable huge pages.
+  page_configuration()
+  {
+    const char* value = std::getenv("MCRL2_HUGE_PAGES");
+    if (value != nullptr && std::strcmp(value, "transparent") == 0)
+    {
+      backing = page_backing::transparent_huge_pages;
+    }
+    else if (value != nullptr && std::strcmp(value, "explicit") == 0)
+    {
+      backing = page_backing::huge_pages;
+    }
+
+#ifdef MCRL2_PLATFORM_LINUX
+    // Only bind regions to NUMA nodes on systems that have more than one node.
+    numa_placement = ::access("/sys/devices/system/node/node1", F_OK) == 0;
+#endif
+  }
+
+  std::atomic<page_backing> backing{page_backing::standard};
+  std::atomic<bool> numa_placement{false};
+
+  std::atomic<std::size_t> regions{0};
+  std::atomic<std::size_t> huge_page_regions{0};
+  std::atomic<std::size_t> bytes{0};
+  std::atomic<std::size_t> huge_page_fallbacks{0};
+};
+
+/// \details The configuration is never destroyed, as memory pools are destroyed during static destruction.
+inline page_configuration& page_settings()
+{
+  static page_configuration* configuration = new page_configuration();
+  return *configuration;
+}
+
+/// \returns The NUMA node of the processor that the calling thread currently runs on.
+inline unsigned int current_numa_node()
+{
+#if defined(MCRL2_PLATFORM_LINUX) && defined(SYS_getcpu)
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+  {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+/// \brief Hands out chunks of a fixed size from large regions of memory that are obtained from the
+///        operating system, optionally backed by huge pages and bound to the NUMA node of the thread
+///        that requires a new region.
+/// \details Chunks that are deallocated are reused for chunks of the same NUMA node. The regions are
+///          only returned to the operating system when the arena is destroyed.
+class page_arena : private mcrl2::utilities::noncopyable
+{
+public:
+  /// \brief The size of a (huge) page, which is also the alignment of the regions.
+  static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+  explicit page_arena(page_backing backing)
+    : m_backing(backing)
+  {}
+
+  ~page_arena()
+  {
+    for (const region& region : m_regions)
+    {
+      unmap(region);
+    }
+  }
+
+  /// \returns A chunk of memory of the given size, where all chunks of one arena must have the same size.
+  void* allocate(std::size_t size)
+  {
+    if (m_chunk_size == 0)
+    {
+      // Keep the chunks aligned to cache lines.
+      m_chunk_size = (size + 63) & ~static_cast<std::size_t>(63);
+    }
+    assert(size <= m_chunk_size);
+
+    const unsigned int node = page_settings().numa_placement ? current_numa_node() : 0;
+    if (node >= m_nodes.size())
+    {
+      m_nodes.resize(node + 1);
+    }
+
+    node_state& state = m_nodes[node];
+    if (state.free_chunks != nullptr)
+    {
+      free_chunk* chunk = state.free_chunks;
+      state.free_chunks = chunk->next;
+      return chunk;
+    }
+
+    if (state.current == nullptr || state.current + m_chunk_size > state.end)
+    {
+      region region = map(node);
+      state.current = region.begin;
+      state.end = region.begin + region.size;
+    }
+
+    void* result = state.current;
+    state.current += m_chunk_size;
+    return result;
+  }
+
+  /// \brief Makes the given chunk available for reuse.
+  /// \returns False when the chunk does not belong to this arena.
+  bool deallocate(void* pointer)
+  {
+    // The regions are sorted on their addresses, so find the last region that starts before the pointer.
+    char* address = static_cast<char*>(pointer);
+    auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address,
+      [](const char* address, const region& region) { return address < region.begin; });
+    if (it == m_regions.begin())
+    {
+      return false;
+    }
+
+    const region& region = *(--it);
+    if (address >= region.begin + region.size)
+    {
+      return false;
+    }
+
+    free_chunk* chunk = static_cast<free_chunk*>(pointer);
+    chunk->next = m_nodes[region.node].free_chunks;
+    m_nodes[region.node].free_chunks = chunk;
+    return true;
+  }
+
+private:
+  struct region
+  {
+    char* begin;
+    std::size_t size;
+    unsigned int node;
+    bool explicit_huge_pages;
+  };
+
+  struct free_chunk
+  {
+    free_chunk* next;
+  };
+
+  struct node_state
+  {
+    char* current = nullptr;
+    char* end = nullptr;
+    free_chunk* free_chunks = nullptr;
+  };
+
+  /// \brief Obtains a new region that fits at least one chunk.
+  region map(unsigned int node)
+  {
+    region result{nullptr, (m_chunk_size + huge_page_size - 1) / huge_page_size * huge_page_size, node, false};
+
+#ifdef MCRL2_PLATFORM_LINUX
+    void* address = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (m_backing == page_backing::huge_pages)
+    {
+      address = ::mmap(nullptr, result.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      result.explicit_huge_pages = address != MAP_FAILED;
+      if (address == MAP_FAILED)
+      {
+        ++page_settings().huge_page_fallbacks;
+      }
+    }
+#endif
+
+    if (address == MAP_FAILED)
+    {
+      // Map an additional page to be able to align the region to a huge page boundary, which is required
+      // to back it with transparent huge pages.
+      void* unaligned = ::mmap(nullptr, result.size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (unaligned == MAP_FAILED)
+      {
+        throw std::bad_alloc();
+      }
+
+      char* begin = static_cast<char*>(unaligned);
+      char* aligned = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(begin) + huge_page_size - 1) & ~(huge_page_size - 1));
+      if (aligned != begin)
+      {
+        ::munmap(begin, static_cast<std::size_t>(aligned - begin));
+      }
+      ::munmap(aligned + result.size, static_cast<std::size_t>(begin + huge_page_size - aligned));
+      address = aligned;
+
+#ifdef MADV_HUGEPAGE
+      ::madvise(address, result.size, MADV_HUGEPAGE);
+#endif
+    }
+
+#ifdef SYS_mbind
+    if (page_settings().numa_placement)
+    {
+      // Prefer the node of the current thread, which only fails when the kernel has no NUMA support.
+      constexpr int preferred_policy = 1; // MPOL_PREFERRED
+      unsigned long node_mask = 1ul << node;
+      ::syscall(SYS_mbind, address, result.size, preferred_policy, &node_mask, sizeof(node_mask) * 8, 0);
+    }
+#endif
+
+    result.begin = static_cast<char*>(address);
+#else
+    result.begin = static_cast<char*>(::operator new(result.size));
+#endif
+
+    m_regions.insert(std::upper_bound(m_regions.begin(), m_regions.end(), result.begin,
+      [](const char* address, const region& region) { return address < region.begin; }), result);
+    ++page_settings().regions;
+    page_settings().bytes += result.size;
+    if (result.explicit_huge_pages)
+    {
+      ++page_settings().huge_page_regions;
+    }
+    return result;
+  }
+
+  static void unmap(const region& region)
+  {
+#ifdef MCRL2_PLATFORM_LINUX
+    ::munmap(region.begin, region.size);
+#else
+    ::operator delete(region.begin);
+#endif
+
+    --page_settings().regions;
+    page_settings().bytes -= region.size;
+    if (region.explicit_huge_pages)
+    {
+      --page_settings().huge_page_regions;
+    }
+  }
+
+  page_backing m_backing;
+  std::size_t m_chunk_size = 0;
+  std::vector<region> m_regions;
+  std::vector<node_state> m_nodes;
+};
+
+} // namespace detail
+
+/// \brief Sets how the blocks of memory pools that are allocated from now on are obtained.
+/// \details The initial value is determined by the MCRL2_HUGE_PAGES environment variable.
+inline void set_page_backing(page_backing backing)
+{
+  detail::page_settings().backing = backing;
+}
+
+/// \returns How the blocks of memory pools are currently obtained.
+inline page_backing get_page_backing()
+{
+  return detail::page_settings().backing;
+}
+
+/// \brief Enables that regions of huge pages are bound to the NUMA node of the thread that requires them.
+/// \details Enabled by default on systems with more than one NUMA node.
+inline void enable_numa_placement(bool enable)
+{
+  detail::page_settings().numa_placement = enable;
+}
+
+/// \returns The statistics of the page allocators and the page faults of this process.
+inline page_statistics get_page_statistics()
+{
+  const detail::page_configuration& settings = detail::page_settings();
+
+  page_statistics result;
+  result.backing = settings.backing;
+  result.regions = settings.regions;
+  result.huge_page_regions = settings.huge_page_regions;
+  result.bytes = settings.bytes;
+  result.huge_page_fallbacks = settings.huge_page_fallbacks;
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+  struct rusage usage;
+  if (::getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    result.minor_page_faults = static_cast<std::size_t>(usage.ru_minflt);
+    result.major_page_faults = static_cast<std::size_t>(usage.ru_majflt);
+  }
+#endif
+
+  return result;
+}
+
+/// \brief An allocator that uses the default allocator, unless huge pages have been enabled by set_page_backing.
+///        In the latter case objects are allocated from a page_arena that is shared by all copies of this allocator.
+/// \details Only supports allocating one object at a time when huge pages are used. This is intended for
+///          the nodes of the list of blocks in a memory_pool.
+template<typename T>
+class page_allocator
+{
+public:
+  using value_type = T;
+  using pointer = T*;
+  using size_type = std::size_t;
+
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  template <class U>
+  struct rebind
+  {
+    typedef page_allocator<U> other;
+  };
+
+  page_allocator() = default;
+
+  template<typename U>
+  page_allocator(const page_allocator<U>& other)
+    : m_arena(other.m_arena)
+  {}
+
+  T* allocate(std::size_t n)
+  {
+    const page_backing backing = get_page_backing();
+    if (backing == page_backing::standard || n != 1)
+    {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    if (!m_arena)
+    {
+      m_arena = std::make_shared<detail::page_arena>(backing);
+    }
+    return static_cast<T*>(m_arena->allocate(sizeof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t)
+  {
+    // The backing might have changed since the allocation, so check where the pointer belongs to.
+    if (!m_arena || !m_arena->deallocate(pointer))
+    {
+      ::operator delete(pointer);
+    }
+  }
+
+  template<typename U>
+  bool operator==(const page_allocator<U>& other) const noexcept { return m_arena == other.m_arena; }
+
+  template<typename U>
+  bool operator!=(const page_allocator<U>& other) const noexcept { return m_arena != other.m_arena; }
+
+private:
+  template<typename U>
+  friend class page_allocator;
+
+  std::shared_ptr<detail::page_arena> m_arena;
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_PAGE_ALLOCATOR_H_
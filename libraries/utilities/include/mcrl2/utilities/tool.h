@@ -17,6 +17,7 @@
 #include "mcrl2/utilities/command_line_interface.h"
 #include "mcrl2/utilities/execution_timer.h"
 #include "mcrl2/utilities/platform.h"
+#include "mcrl2/utilities/trace.h"
 
 #include <cstdlib>
 #include <stdexcept>
@@ -66,6 +67,12 @@ class tool
     /// Determines whether timing output should be written
     bool m_timing_enabled;
 
+    /// The format in which timings are written
+    timing_format m_timing_format;
+
+    /// The filename to which trace events must be written, or empty if no trace is recorded
+    std::string m_trace_filename;
+
     /// \brief Add options to an interface description.
     /// \param desc An interface description
     virtual void add_options(interface_description& desc)
@@ -73,6 +80,13 @@ class tool
       desc.add_option("timings", make_optional_argument<std::string>("FILE", ""),
                       "append timing measurements to FILE. Measurements are written to "
                       "standard error if no FILE is provided");
+      desc.add_option("timings-format", make_mandatory_argument("FORMAT", "yaml"),
+                      "write the timing measurements in FORMAT, which is either yaml or json. The "
+                      "measurements consist of the wall clock time, the CPU time and the peak memory "
+                      "usage of every (nested) phase of the tool");
+      desc.add_option("trace-events", make_mandatory_argument("FILE"),
+                      "write trace events of the tool to FILE in the Chrome trace event format, "
+                      "which can be inspected with chrome://tracing or https://ui.perfetto.dev");
     }
 
     /// \brief Parse non-standard options
@@ -85,6 +99,14 @@ class tool
         log::mcrl2_logger::set_report_time_info();
         m_timing_filename = parser.option_argument("timings");
       }
+      if (parser.options.count("timings-format") > 0)
+      {
+        m_timing_format = parse_timing_format(parser.option_argument("timings-format"));
+      }
+      if (parser.options.count("trace-events") > 0)
+      {
+        m_trace_filename = parser.option_argument("trace-events");
+      }
     }
 
     /// \brief Executed only if run would be executed and invoked before run.
@@ -160,7 +182,8 @@ class tool
         m_known_issues(known_issues),
         m_timing_filename(""),
         m_timer(name),
-        m_timing_enabled(false)
+        m_timing_enabled(false),
+        m_timing_format(timing_format::yaml)
     {}
 
     /// \brief Destructor.
@@ -218,12 +241,22 @@ class tool
           {
             // Create timer, and by default measure running time of run()
             // method.
-            m_timer = execution_timer(m_name, timing_filename());
+            m_timer = execution_timer(m_name, timing_filename(), m_timing_format);
+
+            if (!m_trace_filename.empty())
+            {
+              tracer::enable(m_trace_filename);
+            }
 
             timer().start("total");
-            result = run();
+            {
+              trace_span span("run", "tool");
+              result = run();
+            }
             timer().finish("total");
 
+            tracer::flush();
+
             if (m_timing_enabled)
             {
               timer().report();
@@ -0,0 +1,101 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/trace.h
+/// \brief Records scoped spans and counters as Chrome trace events.
+
+#ifndef MCRL2_UTILITIES_TRACE_H
+#define MCRL2_UTILITIES_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief A global recorder of trace events, which are written in the Chrome trace event
+///        format such that they can be inspected with chrome://tracing or Perfetto.
+/// \details Recording is disabled by default, in which case every operation only checks a
+///          single flag. The events are buffered in memory and written by flush().
+class tracer
+{
+  public:
+    typedef std::chrono::steady_clock clock_type;
+
+    /// \brief Start recording trace events that are written to the given file by flush().
+    static void enable(const std::string& filename);
+
+    /// \returns True iff trace events are being recorded.
+    static bool enabled()
+    {
+      return m_enabled().load(std::memory_order_relaxed);
+    }
+
+    /// \brief Record a span with the given name and category from start until now.
+    /// \details The name and category must have static storage duration.
+    static void complete(const char* name, const char* category, clock_type::time_point start);
+
+    /// \brief Record the value of the counter with the given name.
+    static void counter(const char* name, std::int64_t value);
+
+    /// \brief Record an event without a duration.
+    static void instant(const char* name, const char* category);
+
+    /// \brief Write the recorded events to the file given to enable() and stop recording.
+    static void flush();
+
+  private:
+    static std::atomic<bool>& m_enabled()
+    {
+      static std::atomic<bool> enabled(false);
+      return enabled;
+    }
+};
+
+/// \brief Records the time from its construction to its destruction as a span in the trace.
+/// \details The name and category must have static storage duration, typically string literals.
+class trace_span
+{
+  public:
+    trace_span(const char* name, const char* category)
+      : m_name(name),
+        m_category(category),
+        m_enabled(tracer::enabled())
+    {
+      if (m_enabled)
+      {
+        m_start = tracer::clock_type::now();
+      }
+    }
+
+    ~trace_span()
+    {
+      if (m_enabled)
+      {
+        tracer::complete(m_name, m_category, m_start);
+      }
+    }
+
+    trace_span(const trace_span&) = delete;
+    trace_span& operator=(const trace_span&) = delete;
+
+  private:
+    const char* m_name;
+    const char* m_category;
+    bool m_enabled;
+    tracer::clock_type::time_point m_start;
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_TRACE_H
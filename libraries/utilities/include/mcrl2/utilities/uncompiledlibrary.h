@@ -26,11 +26,10 @@
  *
  * Remarks:
  *
- * The source is compiled using a script that must take two string arguments.
- * The first argument is the source file, the second is the destination file.
- * After (successful) termination, only the source and destination files must
- * remain on disk -- it is the responsibility of the script to remove any
- * temporary files.
+ * The source is compiled using a script that takes the source files as
+ * arguments, and links them into a single library. The script prints the
+ * files it produced, one per line, of which the last is the library. These
+ * files are removed when the library is no longer needed.
  *
  */
 
@@ -38,6 +37,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <list>
+#include <vector>
 #include <string>
 #include <sstream>
 #include <stdexcept>
@@ -54,10 +54,20 @@ class uncompiled_library : public dynamic_library
   public:
     uncompiled_library(const std::string& script) : m_compile_script(script) {}
 
-    void compile(const std::string& filename) 
+    void compile(const std::string& filename)
+    {
+      compile(std::vector<std::string>(1, filename));
+    }
+
+    void compile(const std::vector<std::string>& filenames)
     {
       std::stringstream commandline;
-      commandline << '"' << m_compile_script << "\" " << filename << " " << " 2>&1";
+      commandline << '"' << m_compile_script << "\" ";
+      for (const std::string& filename: filenames)
+      {
+        commandline << filename << " ";
+      }
+      commandline << " 2>&1";
       
       // Execute script.
       FILE* stream = popen(commandline.str().c_str(), "r");
@@ -112,6 +112,9 @@ public:
   /// \brief Prints various information about the underlying buckets.
   void print_performance_statistics() const;
 
+  /// \returns A histogram where the i-th entry is the number of buckets that store i keys.
+  std::vector<std::size_t> bucket_length_histogram() const;
+
   /// \returns The amount of elements stored in this set.
   std::size_t size() const noexcept { return m_number_of_elements; }
 
@@ -175,9 +175,8 @@ typename MCRL2_UNORDERED_SET_CLASS::iterator MCRL2_UNORDERED_SET_CLASS::find(con
 }
 
 MCRL2_UNORDERED_SET_TEMPLATES
-void MCRL2_UNORDERED_SET_CLASS::print_performance_statistics() const
+std::vector<std::size_t> MCRL2_UNORDERED_SET_CLASS::bucket_length_histogram() const
 {
-  // Calculate a histogram of the bucket lengths.
   std::vector<std::size_t> histogram;
 
   for (auto& bucket : m_buckets)
@@ -194,6 +193,15 @@ void MCRL2_UNORDERED_SET_CLASS::print_performance_statistics() const
     ++histogram[bucketLength];
   }
 
+  return histogram;
+}
+
+MCRL2_UNORDERED_SET_TEMPLATES
+void MCRL2_UNORDERED_SET_CLASS::print_performance_statistics() const
+{
+  // Calculate a histogram of the bucket lengths.
+  std::vector<std::size_t> histogram = bucket_length_histogram();
+
   mCRL2log(mcrl2::log::debug, "Performance") << "Table stores " << size() << " keys, using approximately "
     << bytes_to_megabytes(m_allocator.capacity() * sizeof(typename Bucket::node)) << " MB for elements, and "
     << bytes_to_megabytes(m_buckets.size() * sizeof(Bucket)) << " MB for buckets.\n";
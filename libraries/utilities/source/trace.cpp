@@ -0,0 +1,216 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file trace.cpp
+
+#include "mcrl2/utilities/trace.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/logger.h"
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+namespace
+{
+
+/// \brief A single trace event, the timestamps are in microseconds since tracing was enabled.
+struct trace_event
+{
+  char phase;
+  const char* name;
+  const char* category;
+  std::int64_t timestamp;
+  std::int64_t duration; // Only for complete events.
+  std::int64_t value;    // Only for counter events.
+  std::size_t thread;
+};
+
+struct trace_state
+{
+  std::mutex mutex;
+  std::string filename;
+  tracer::clock_type::time_point origin;
+  std::vector<trace_event> events;
+  std::map<std::thread::id, std::size_t> threads;
+  std::size_t dropped = 0;
+
+  // Bounds the memory that is used for the events of long runs.
+  static constexpr std::size_t max_events = std::size_t(1) << 24;
+
+  /// \pre The mutex is locked.
+  void record(char phase, const char* name, const char* category, std::int64_t timestamp, std::int64_t duration, std::int64_t value)
+  {
+    if (events.size() < max_events)
+    {
+      events.push_back(trace_event{phase, name, category, timestamp, duration, value, thread_index()});
+    }
+    else
+    {
+      ++dropped;
+    }
+  }
+
+  /// \returns A small number that identifies the calling thread in the trace.
+  /// \pre The mutex is locked.
+  std::size_t thread_index()
+  {
+    return threads.emplace(std::this_thread::get_id(), threads.size() + 1).first->second;
+  }
+
+  std::int64_t microseconds(tracer::clock_type::time_point time) const
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - origin).count();
+  }
+};
+
+constexpr std::size_t trace_state::max_events;
+
+trace_state& state()
+{
+  static trace_state state;
+  return state;
+}
+
+void write_string(std::ostream& out, const char* text)
+{
+  out << '"';
+  for (const char* c = text; *c != '\0'; ++c)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      out << '\\';
+    }
+    out << *c;
+  }
+  out << '"';
+}
+
+} // namespace
+
+void tracer::enable(const std::string& filename)
+{
+  trace_state& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.filename = filename;
+  s.origin = clock_type::now();
+  s.events.clear();
+  s.dropped = 0;
+  m_enabled().store(true, std::memory_order_relaxed);
+}
+
+void tracer::complete(const char* name, const char* category, clock_type::time_point start)
+{
+  if (!enabled())
+  {
+    return;
+  }
+
+  const clock_type::time_point finish = clock_type::now();
+  trace_state& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  if (enabled())
+  {
+    s.record('X', name, category, s.microseconds(start), s.microseconds(finish) - s.microseconds(start), 0);
+  }
+}
+
+void tracer::counter(const char* name, std::int64_t value)
+{
+  if (!enabled())
+  {
+    return;
+  }
+
+  const clock_type::time_point now = clock_type::now();
+  trace_state& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  if (enabled())
+  {
+    s.record('C', name, "counter", s.microseconds(now), 0, value);
+  }
+}
+
+void tracer::instant(const char* name, const char* category)
+{
+  if (!enabled())
+  {
+    return;
+  }
+
+  const clock_type::time_point now = clock_type::now();
+  trace_state& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  if (enabled())
+  {
+    s.record('i', name, category, s.microseconds(now), 0, 0);
+  }
+}
+
+void tracer::flush()
+{
+  trace_state& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  if (!enabled())
+  {
+    return;
+  }
+  m_enabled().store(false, std::memory_order_relaxed);
+
+  std::ofstream out(s.filename.c_str());
+  if (!out)
+  {
+    throw mcrl2::runtime_error("Could not open file " + s.filename + " to write the trace to.");
+  }
+
+  out << "{\"traceEvents\": [\n";
+  bool first = true;
+  for (const trace_event& event: s.events)
+  {
+    out << (first ? "" : ",\n") << "{\"name\": ";
+    first = false;
+    write_string(out, event.name);
+    out << ", \"cat\": ";
+    write_string(out, event.category);
+    out << ", \"ph\": \"" << event.phase << "\", \"ts\": " << event.timestamp
+        << ", \"pid\": 1, \"tid\": " << event.thread;
+
+    if (event.phase == 'X')
+    {
+      out << ", \"dur\": " << event.duration;
+    }
+    else if (event.phase == 'C')
+    {
+      out << ", \"args\": {\"value\": " << event.value << "}";
+    }
+    else if (event.phase == 'i')
+    {
+      out << ", \"s\": \"t\"";
+    }
+    out << "}";
+  }
+  out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+
+  mCRL2log(log::verbose) << "Written " << s.events.size() << " trace events to " << s.filename << "." << std::endl;
+  if (s.dropped > 0)
+  {
+    mCRL2log(log::warning) << "The trace is incomplete, " << s.dropped << " events were dropped because the trace exceeded "
+                           << trace_state::max_events << " events." << std::endl;
+  }
+  s.events.clear();
+}
+
+} // namespace utilities
+} // namespace mcrl2
@@ -127,6 +127,53 @@ BOOST_AUTO_TEST_CASE(cumulative_tests)
   test(big_number,big_number);
 }
 
+BOOST_AUTO_TEST_CASE(karatsuba_tests)
+{
+  // Numbers of more than karatsuba_threshold digits are multiplied using Karatsuba multiplication.
+  big_natural_number x(1), y(1), three(3), seven(7);
+  for(std::size_t i=0; i<3000; ++i)
+  {
+    x=x*three;
+  }
+  for(std::size_t i=0; i<2500; ++i)
+  {
+    y=y*seven;
+  }
+  test(pp(x),pp(y));
+  test(pp(x*y+x),pp(y*y));
+  BOOST_CHECK(x*(y+x)==x*y+x*x);
+  BOOST_CHECK((x*y)/y==x);
+  BOOST_CHECK((x*y+three)%y==three);
+}
+
+void test_gcd(const std::string& xs, const std::string& ys, const std::string& gs)
+{
+  big_natural_number x(xs), y(ys), buffer1, buffer2, buffer3;
+  std::cerr << "Check gcd " << xs << " and " << ys << "\n";
+  x.greatest_common_divisor(y,buffer1,buffer2,buffer3);
+  BOOST_CHECK(x==big_natural_number(gs));
+}
+
+BOOST_AUTO_TEST_CASE(gcd_tests)
+{
+  test_gcd("0","12","12");
+  test_gcd("12","0","12");
+  test_gcd("12","18","6");
+  test_gcd("1","123987498734298734987","1");
+  test_gcd("36893488147419103232","18446744073709551616","18446744073709551616");
+  test_gcd("340282366920938463463374607431768211456","4096","4096");
+  test_gcd("1400000000000000000021498639574985789345798","12000000000000000000123","1");
+  test_gcd("349857349587453098713409835719348571930857","349857349587453098713409835719348571930857","349857349587453098713409835719348571930857");
+
+  const big_natural_number g("34908657984275902384759028475908345");
+  const big_natural_number x("3498543032012938471093847103956139084710939873460195660129384601928560985360734958745309"),
+                           y("9814143168171749855338647743502805581079688153703315426474162988471604059161792979036100853758150719");
+  big_natural_number a=x*g, b=y*g, buffer1, buffer2, buffer3;
+  a.greatest_common_divisor(b,buffer1,buffer2,buffer3);
+  BOOST_CHECK((x*g)%a==big_natural_number(0));
+  BOOST_CHECK((y*g)%a==big_natural_number(0));
+  BOOST_CHECK(a%g==big_natural_number(0));
+}
 
 boost::unit_test::test_suite* init_unit_test_suite(int argc, char* argv[])
 {
@@ -0,0 +1,68 @@
+// Author(s): Jeroen Keiren
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/execution_timer.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+#include <algorithm>
+
+using namespace mcrl2::utilities;
+
+BOOST_AUTO_TEST_CASE(test_nested_yaml)
+{
+  execution_timer timer("test_tool");
+  timer.start("outer");
+  timer.start("inner");
+  timer.finish("inner");
+  timer.finish("outer");
+  timer.start("second");
+  timer.finish("second");
+
+  std::ostringstream out;
+  timer.report(out);
+  const std::string report = out.str();
+
+  BOOST_CHECK(report.find("- tool: test_tool\n  timing:\n    outer:\n      wall: ") == 0);
+  BOOST_CHECK(report.find("      phases:\n        inner:\n          wall: ") != std::string::npos);
+  BOOST_CHECK(report.find("\n    second:\n      wall: ") != std::string::npos);
+  BOOST_CHECK(report.find("peak_rss: ") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_json)
+{
+  execution_timer timer("test_tool", "", parse_timing_format("json"));
+  timer.start("outer");
+  timer.start("inner");
+  timer.finish("inner");
+  timer.start("unfinished");
+
+  std::ostringstream out;
+  timer.report(out);
+  const std::string report = out.str();
+
+  BOOST_CHECK(report.find("{\"tool\": \"test_tool\", \"timing\": {\"outer\": {\"finished\": false, \"phases\": {\"inner\": {\"wall\": ") == 0);
+  BOOST_CHECK(report.find("\"unfinished\": {\"finished\": false}}}}}\n") != std::string::npos);
+  BOOST_CHECK_EQUAL(std::count(report.begin(), report.end(), '\n'), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_errors)
+{
+  execution_timer timer;
+  timer.start("phase");
+  BOOST_CHECK_THROW(timer.start("phase"), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(timer.finish("other"), mcrl2::runtime_error);
+  timer.finish("phase");
+  BOOST_CHECK_THROW(timer.finish("phase"), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(parse_timing_format("xml"), mcrl2::runtime_error);
+}
+
+boost::unit_test::test_suite* init_unit_test_suite(int, char*[])
+{
+  return nullptr;
+}
@@ -0,0 +1,135 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/fixed_size_cache.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+
+using namespace mcrl2::utilities;
+
+/// \brief Every element occupies as many bytes as its value.
+struct value_size
+{
+  std::size_t operator()(int, int value) const
+  {
+    return static_cast<std::size_t>(value);
+  }
+};
+
+template<typename Cache>
+void check_bounded(Cache& cache)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    cache.emplace(i, i);
+    BOOST_CHECK(cache.size() < 16);
+  }
+
+  BOOST_CHECK_EQUAL(cache.metrics().eviction_count(), 100u - cache.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded)
+{
+  fifo_cache<int, int> fifo(16);
+  check_bounded(fifo);
+
+  lru_cache<int, int> lru(16);
+  check_bounded(lru);
+
+  clock_cache<int, int> clock(16);
+  check_bounded(clock);
+}
+
+BOOST_AUTO_TEST_CASE(test_fifo)
+{
+  fifo_cache<int, int> cache(4);
+  cache.emplace(1, 1);
+  cache.emplace(2, 2);
+  cache.emplace(3, 3);
+
+  // Finding an element does not change the order in which they are evicted.
+  BOOST_CHECK(cache.find(1) != cache.end());
+  cache.emplace(4, 4);
+  BOOST_CHECK_EQUAL(cache.count(1), 0u);
+  BOOST_CHECK_EQUAL(cache.count(2), 1u);
+
+  // Evicting the only element must leave the policy in a valid state.
+  fifo_cache<int, int> small(2);
+  for (int i = 0; i < 10; ++i)
+  {
+    small.emplace(i, i);
+    BOOST_CHECK_EQUAL(small.count(i), 1u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_lru)
+{
+  lru_cache<int, int> cache(4);
+  cache.emplace(1, 1);
+  cache.emplace(2, 2);
+  cache.emplace(3, 3);
+
+  // Element 2 is now the least recently used one.
+  BOOST_CHECK(cache.find(1) != cache.end());
+  cache.emplace(4, 4);
+  BOOST_CHECK_EQUAL(cache.count(1), 1u);
+  BOOST_CHECK_EQUAL(cache.count(2), 0u);
+
+  BOOST_CHECK_EQUAL(cache.metrics().hit_count(), 1u);
+  BOOST_CHECK(cache.find(2) == cache.end());
+  BOOST_CHECK_EQUAL(cache.metrics().miss_count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_clock)
+{
+  clock_cache<int, int> cache(4);
+  cache.emplace(1, 1);
+  cache.emplace(2, 2);
+  cache.emplace(3, 3);
+
+  // Element 1 is referenced, so it gets a second chance and element 2 is evicted.
+  BOOST_CHECK(cache.find(1) != cache.end());
+  cache.emplace(4, 4);
+  BOOST_CHECK_EQUAL(cache.count(1), 1u);
+  BOOST_CHECK_EQUAL(cache.count(2), 0u);
+
+  // The reference bit of element 1 was cleared, so now element 3 and then element 1 are evicted.
+  cache.emplace(5, 5);
+  BOOST_CHECK_EQUAL(cache.count(3), 0u);
+  cache.emplace(6, 6);
+  BOOST_CHECK_EQUAL(cache.count(1), 0u);
+  BOOST_CHECK_EQUAL(cache.count(4), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_memory_budget)
+{
+  lru_cache<int, int, value_size> cache(0, 10);
+  cache.emplace(1, 4);
+  cache.emplace(2, 4);
+  BOOST_CHECK_EQUAL(cache.memory_usage(), 8u);
+
+  // Both elements must be evicted to make room for the new one.
+  cache.emplace(3, 9);
+  BOOST_CHECK_EQUAL(cache.size(), 1u);
+  BOOST_CHECK_EQUAL(cache.memory_usage(), 9u);
+  BOOST_CHECK_EQUAL(cache.metrics().eviction_count(), 2u);
+
+  // An element that exceeds the budget by itself is still cached.
+  cache.emplace(4, 20);
+  BOOST_CHECK_EQUAL(cache.count(4), 1u);
+  BOOST_CHECK_EQUAL(cache.memory_usage(), 20u);
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.memory_usage(), 0u);
+}
+
+boost::unit_test::test_suite* init_unit_test_suite(int, char*[])
+{
+  return nullptr;
+}
@@ -0,0 +1,168 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/indexed_set.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+/// \brief A hash function that maps many keys to the same hash, which results in long probing sequences.
+struct colliding_hash
+{
+  std::size_t operator()(std::size_t value) const
+  {
+    return value % 13;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(test_trivial)
+{
+  indexed_set<std::string> set;
+  BOOST_CHECK_EQUAL(set.size(), 0u);
+  BOOST_CHECK(set.begin() == set.end());
+  BOOST_CHECK_EQUAL(set.index("a"), indexed_set<std::string>::npos);
+  BOOST_CHECK_THROW(set.at("a"), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_consecutive_indices)
+{
+  indexed_set<std::string> set;
+
+  auto result = set.insert("a");
+  BOOST_CHECK(result.second);
+  BOOST_CHECK_EQUAL(result.first->second, 0u);
+
+  BOOST_CHECK(set.insert("b").second);
+  BOOST_CHECK(!set.insert("a").second);
+  BOOST_CHECK_EQUAL(set.insert("c").first->second, 2u);
+
+  BOOST_CHECK_EQUAL(set.size(), 3u);
+  BOOST_CHECK_EQUAL(set.at("b"), 1u);
+  BOOST_CHECK_EQUAL(set[2], "c");
+  BOOST_CHECK_EQUAL(set.count("c"), 1u);
+  BOOST_CHECK_EQUAL(set.count("d"), 0u);
+  BOOST_CHECK(set.find("d") == set.end());
+
+  // The elements are iterated in the order of their indices.
+  std::size_t index = 0;
+  for (const auto& element : set)
+  {
+    BOOST_CHECK_EQUAL(element.second, index);
+    ++index;
+  }
+
+  set.clear();
+  BOOST_CHECK_EQUAL(set.size(), 0u);
+  BOOST_CHECK_EQUAL(set.insert("c").first->second, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_resize)
+{
+  indexed_set<std::size_t, colliding_hash> set(4);
+
+  // Crosses several segments and resizes of the hash table.
+  for (std::size_t i = 0; i < 5000; ++i)
+  {
+    BOOST_CHECK_EQUAL(set.insert(i * 3).first->second, i);
+  }
+
+  for (std::size_t i = 0; i < 5000; ++i)
+  {
+    BOOST_CHECK_EQUAL(set.index(i * 3), i);
+    BOOST_CHECK_EQUAL(set[i], i * 3);
+    BOOST_CHECK_EQUAL(set.index(i * 3 + 1), (indexed_set<std::size_t, colliding_hash>::npos));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_copy_and_move)
+{
+  indexed_set<std::string> set;
+  set.insert("a");
+  set.insert("b");
+
+  indexed_set<std::string> copy(set);
+  BOOST_CHECK_EQUAL(copy.at("b"), 1u);
+
+  indexed_set<std::string> moved(std::move(set));
+  BOOST_CHECK_EQUAL(moved.size(), 2u);
+  BOOST_CHECK_EQUAL(moved.at("a"), 0u);
+
+  // The moved-from set is empty, but can still be used.
+  BOOST_CHECK_EQUAL(set.size(), 0u);
+  BOOST_CHECK_EQUAL(set.insert("b").first->second, 0u);
+
+  copy = moved;
+  BOOST_CHECK_EQUAL(copy.size(), 2u);
+  BOOST_CHECK_EQUAL(copy.at("a"), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_insert)
+{
+  using concurrent_set = indexed_set<std::size_t, std::hash<std::size_t>, std::equal_to<std::size_t>, std::allocator<std::size_t>, true>;
+
+  const std::size_t number_of_threads = 4;
+  const std::size_t number_of_keys = 100003; // A prime, so every thread inserts a permutation of the keys.
+  concurrent_set set(16);
+
+  // Every thread inserts the same keys, in a different order, and looks up the keys that it inserted before.
+  std::vector<std::vector<std::size_t>> indices(number_of_threads, std::vector<std::size_t>(number_of_keys));
+  std::atomic<std::size_t> failed_lookups(0);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([&, t]()
+      {
+        for (std::size_t i = 0; i < number_of_keys; ++i)
+        {
+          const std::size_t key = (i * (2 * t + 1)) % number_of_keys;
+          indices[t][key] = set.insert(key).first->second;
+
+          const std::size_t previous = (i / 2 * (2 * t + 1)) % number_of_keys;
+          if (set.index(previous) != indices[t][previous])
+          {
+            ++failed_lookups;
+          }
+        }
+      });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  // All threads obtained the same index for every key, and the indices are consecutive.
+  BOOST_CHECK_EQUAL(failed_lookups.load(), 0u);
+  BOOST_CHECK_EQUAL(set.size(), number_of_keys);
+  std::vector<bool> used(number_of_keys, false);
+  for (std::size_t key = 0; key < number_of_keys; ++key)
+  {
+    const std::size_t index = indices[0][key];
+    BOOST_REQUIRE(index < number_of_keys);
+    BOOST_CHECK(!used[index]);
+    used[index] = true;
+    BOOST_CHECK_EQUAL(set[index], key);
+
+    for (std::size_t t = 1; t < number_of_threads; ++t)
+    {
+      BOOST_CHECK_EQUAL(indices[t][key], index);
+    }
+  }
+}
+
+boost::unit_test::test_suite* init_unit_test_suite(int, char*[])
+{
+  return nullptr;
+}
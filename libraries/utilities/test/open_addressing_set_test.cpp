@@ -0,0 +1,190 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/open_addressing_set.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <random>
+#include <unordered_set>
+
+using namespace mcrl2::utilities;
+
+/// \brief A hash function that maps many keys to the same hash, to test the probing of groups.
+struct colliding_hash
+{
+  std::size_t operator()(int value) const
+  {
+    return static_cast<std::size_t>(value % 7);
+  }
+};
+
+BOOST_AUTO_TEST_CASE(test_trivial)
+{
+  // Sanity check, default construction and destruction.
+  open_addressing_set<int> set;
+
+  for (auto& element : set)
+  {
+    (void)element;
+    BOOST_FAIL("There should be no elements in this set");
+  }
+}
+
+template<typename T>
+open_addressing_set<T> construct(std::initializer_list<T> list)
+{
+  open_addressing_set<T> set;
+
+  for (auto& element : list)
+  {
+    set.emplace(element);
+  }
+
+  return set;
+}
+
+BOOST_AUTO_TEST_CASE(test_small)
+{
+  // Test with inserting 5, 3, 2, 5 expected { 2,3,5 }
+  open_addressing_set<int> set = construct({5,3,2,5});
+
+  BOOST_CHECK_EQUAL(set.size(), 3);
+  BOOST_CHECK(set.find(5) != set.end());
+  BOOST_CHECK(set.find(2) != set.end());
+  BOOST_CHECK(set.find(3) != set.end());
+  BOOST_CHECK(set.find(4) == set.end());
+  BOOST_CHECK(!set.emplace(5).second);
+}
+
+BOOST_AUTO_TEST_CASE(test_large)
+{
+  // Test inserting and erasing a large number of elements (tests resize behaviour and deleted slots).
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(1, 10000);
+
+  open_addressing_set<int> test;
+
+  // Here, we assume that the standard library implementation is correct.
+  std::unordered_set<int> correct;
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    int value = dist(rng);
+    if (i % 3 == 0)
+    {
+      test.erase(value);
+      correct.erase(value);
+    }
+    else
+    {
+      BOOST_CHECK_EQUAL(test.emplace(value).second, correct.emplace(value).second);
+    }
+  }
+
+  // Check that both contain the same elements.
+  BOOST_CHECK_EQUAL(test.size(), correct.size());
+  for (auto& value : correct)
+  {
+    BOOST_CHECK(test.find(value) != test.end());
+  }
+
+  for (auto& value : test)
+  {
+    BOOST_CHECK(correct.find(value) != correct.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_collisions)
+{
+  // All elements end up in the same probe sequences, which requires probing multiple groups.
+  open_addressing_set<int, colliding_hash> set;
+  for (int i = 0; i < 1000; ++i)
+  {
+    set.emplace(i);
+  }
+
+  for (int i = 0; i < 1000; i += 2)
+  {
+    set.erase(i);
+  }
+
+  BOOST_CHECK_EQUAL(set.size(), 500);
+  for (int i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK_EQUAL(set.count(i), static_cast<std::size_t>(i % 2));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_copy)
+{
+  // Test the copy constructor.
+  open_addressing_set<int> set = construct({5,3,2,5});
+
+  open_addressing_set<int> copy(set);
+  set.clear();
+
+  BOOST_CHECK(set.find(5) == set.end());
+  BOOST_CHECK(copy.find(5) != copy.end());
+  BOOST_CHECK(copy.find(2) != copy.end());
+  BOOST_CHECK(copy.find(3) != copy.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_move)
+{
+  // Test the move constructor.
+  open_addressing_set<int> set = construct({5,3,2,5});
+  open_addressing_set<int> moved = std::move(set);
+
+  BOOST_CHECK_EQUAL(moved.size(), 3);
+  BOOST_CHECK(moved.find(3) != moved.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+  open_addressing_set<int> set(0);
+  for (int element : set)
+  {
+    (void)element;
+    BOOST_CHECK(false);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_erase_iterate)
+{
+  // Erase all even elements while iterating, as the term pool does during garbage collection.
+  open_addressing_set<int> set;
+  for (int i = 0; i < 1000; ++i)
+  {
+    set.emplace(i);
+  }
+
+  std::size_t visited = 0;
+  for (auto it = set.begin(); it != set.end(); )
+  {
+    ++visited;
+    if (*it % 2 == 0)
+    {
+      it = set.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  BOOST_CHECK_EQUAL(visited, 1000);
+  BOOST_CHECK_EQUAL(set.size(), 500);
+  BOOST_CHECK(set.find(2) == set.end());
+  BOOST_CHECK(set.find(3) != set.end());
+}
+
+boost::unit_test::test_suite* init_unit_test_suite(int, char*[])
+{
+  return nullptr;
+}
@@ -0,0 +1,108 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_allocator.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+/// \brief Allocates and deallocates a number of elements in a fresh block allocator, using the given backing.
+static void allocate_elements(page_backing backing)
+{
+  set_page_backing(backing);
+
+  {
+    block_allocator<std::size_t, 64> allocator;
+
+    std::vector<std::size_t*> elements;
+    for (std::size_t i = 0; i < 64000; ++i)
+    {
+      elements.push_back(allocator.allocate(1));
+      *elements.back() = i;
+    }
+
+    if (backing != page_backing::standard)
+    {
+      BOOST_CHECK(get_page_statistics().regions > 0);
+    }
+
+    for (std::size_t i = 0; i < elements.size(); ++i)
+    {
+      BOOST_CHECK_EQUAL(*elements[i], i);
+      allocator.deallocate(elements[i], 1);
+    }
+
+    // The blocks are returned to the arena and reused by the next allocations.
+    BOOST_CHECK_EQUAL(allocator.consolidate(), 1000);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      allocator.allocate(1);
+    }
+  }
+
+  // All regions are unmapped when the allocator is destroyed.
+  BOOST_CHECK_EQUAL(get_page_statistics().regions, 0);
+  BOOST_CHECK_EQUAL(get_page_statistics().bytes, 0);
+  set_page_backing(page_backing::standard);
+}
+
+BOOST_AUTO_TEST_CASE(test_standard)
+{
+  allocate_elements(page_backing::standard);
+}
+
+BOOST_AUTO_TEST_CASE(test_transparent_huge_pages)
+{
+  allocate_elements(page_backing::transparent_huge_pages);
+}
+
+BOOST_AUTO_TEST_CASE(test_huge_pages)
+{
+  // Falls back to transparent huge pages when no huge pages have been reserved.
+  allocate_elements(page_backing::huge_pages);
+  BOOST_CHECK(get_page_statistics().huge_page_fallbacks > 0 || get_page_statistics().huge_page_regions == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_changed_backing)
+{
+  // Blocks allocated before the backing changed are still deallocated correctly.
+  block_allocator<std::size_t, 64> allocator;
+  std::size_t* standard = allocator.allocate(1);
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    allocator.allocate(1);
+  }
+
+  set_page_backing(page_backing::transparent_huge_pages);
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    allocator.allocate(1);
+  }
+  set_page_backing(page_backing::standard);
+
+  allocator.deallocate(standard, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_page_faults)
+{
+  // The page faults are counted on all platforms with getrusage.
+  page_statistics statistics = get_page_statistics();
+  std::vector<char> memory(1 << 24, 1);
+#ifndef _WIN32
+  BOOST_CHECK(get_page_statistics().minor_page_faults > statistics.minor_page_faults);
+#endif
+}
+
+boost::unit_test::test_suite* init_unit_test_suite(int, char*[])
+{
+  return nullptr;
+}
@@ -0,0 +1,69 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/trace.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace mcrl2::utilities;
+
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream in(filename.c_str());
+  std::stringstream result;
+  result << in.rdbuf();
+  return result.str();
+}
+
+BOOST_AUTO_TEST_CASE(test_disabled)
+{
+  BOOST_CHECK(!tracer::enabled());
+  {
+    trace_span span("ignored", "test");
+  }
+  tracer::counter("ignored", 1);
+
+  // Flushing without enabling the tracer does not write anything.
+  tracer::flush();
+}
+
+BOOST_AUTO_TEST_CASE(test_events)
+{
+  const std::string filename = "trace_test.json";
+  tracer::enable(filename);
+  BOOST_CHECK(tracer::enabled());
+  {
+    trace_span outer("outer", "test");
+    trace_span inner("in\"ner", "test");
+    tracer::counter("size", 42);
+    tracer::instant("marker", "test");
+  }
+  tracer::flush();
+  BOOST_CHECK(!tracer::enabled());
+
+  const std::string trace = read_file(filename);
+  BOOST_CHECK(trace.find("{\"traceEvents\": [") == 0);
+  BOOST_CHECK(trace.find("{\"name\": \"outer\", \"cat\": \"test\", \"ph\": \"X\"") != std::string::npos);
+  BOOST_CHECK(trace.find("{\"name\": \"in\\\"ner\", \"cat\": \"test\", \"ph\": \"X\"") != std::string::npos);
+  BOOST_CHECK(trace.find("\"ph\": \"C\"") != std::string::npos);
+  BOOST_CHECK(trace.find("\"args\": {\"value\": 42}") != std::string::npos);
+  BOOST_CHECK(trace.find("{\"name\": \"marker\", \"cat\": \"test\", \"ph\": \"i\"") != std::string::npos);
+
+  // The inner span ends before the outer one, so it is recorded first.
+  BOOST_CHECK(trace.find("in\\\"ner") < trace.find("outer"));
+  std::remove(filename.c_str());
+}
+
+boost::unit_test::test_suite* init_unit_test_suite(int, char*[])
+{
+  return nullptr;
+}
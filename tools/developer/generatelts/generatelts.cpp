@@ -61,6 +61,9 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
 
       // copied from lps2lts
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-memory", utilities::make_mandatory_argument("NUM"),
+                 "limit the memory used by the enumeration caches to approximately NUM MB, where 0 means "
+                 "unbounded; the least recently used enumeration results are evicted first (default 1024). ");
       desc.add_option("max", utilities::make_mandatory_argument("NUM"), "explore at most NUM states", 'l');
       desc.add_option("todo-max", utilities::make_mandatory_argument("NUM"),
                  "keep at most NUM states in todo lists; this option is only relevant for "
@@ -178,6 +181,11 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
         options.todo_max = parser.option_argument_as<std::size_t>("todo-max");
       }
 
+      if (parser.has_option("cache-memory"))
+      {
+        options.cache_memory = parser.option_argument_as<std::size_t>("cache-memory");
+      }
+
       if (parser.has_option("out"))
       {
         output_format = lts::detail::parse_format(parser.option_argument("out"));
@@ -283,24 +291,40 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
       mCRL2log(log::verbose) << options << std::endl;
       options.trace_prefix = input_filename();
       lps::stochastic_specification stochastic_lpsspec;
+      timer().start("load");
       lps::load_lps(stochastic_lpsspec, input_filename());
+      timer().finish("load");
 
       if (lps::is_stochastic(stochastic_lpsspec))
       {
         std::unique_ptr<lts::stochastic_lts_builder> builder = create_stochastic_lts_builder(stochastic_lpsspec);
+        // The rewriter is created, and compiled for jittyc, when the generator is constructed.
+        timer().start("initialise");
         lts::stochastic_state_space_generator generator(stochastic_lpsspec, options);
+        timer().finish("initialise");
         current_explorer = &generator.explorer;
+        timer().start("explore");
         generator.explore(*builder);
+        timer().finish("explore");
+        timer().start("write");
         builder->save(output_filename());
+        timer().finish("write");
       }
       else
       {
         lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
         std::unique_ptr<lts::lts_builder> builder = create_lts_builder(lpsspec);
+        // The rewriter is created, and compiled for jittyc, when the generator is constructed.
+        timer().start("initialise");
         lts::state_space_generator generator(lpsspec, options);
+        timer().finish("initialise");
         current_explorer = &generator.explorer;
+        timer().start("explore");
         generator.explore(*builder);
+        timer().finish("explore");
+        timer().start("write");
         builder->save(output_filename());
+        timer().finish("write");
       }
       return true;
     }
@@ -62,6 +62,9 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
 
       // copied from lps2lts
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-memory", utilities::make_mandatory_argument("NUM"),
+                 "limit the memory used by the enumeration caches to approximately NUM MB, where 0 means "
+                 "unbounded; the least recently used enumeration results are evicted first (default 1024). ");
       desc.add_option("max", utilities::make_mandatory_argument("NUM"), "explore at most NUM states", 'l');
       desc.add_option("todo-max", utilities::make_mandatory_argument("NUM"),
                  "keep at most NUM states in todo lists; this option is only relevant for "
@@ -180,6 +183,11 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
         options.todo_max = parser.option_argument_as<std::size_t>("todo-max");
       }
 
+      if (parser.has_option("cache-memory"))
+      {
+        options.cache_memory = parser.option_argument_as<std::size_t>("cache-memory");
+      }
+
       if (parser.has_option("out"))
       {
         output_format = lts::detail::parse_format(parser.option_argument("out"));
@@ -284,10 +292,17 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
     template <bool Stochastic, bool Timed, typename Specification, typename LTSBuilder>
     void generate_state_space(const Specification& lpsspec, LTSBuilder& builder)
     {
+      // The rewriter is created, and compiled for jittyc, when the generator is constructed.
+      timer().start("initialise");
       lts::state_space_generator<Stochastic, Timed, Specification> generator(lpsspec, options);
+      timer().finish("initialise");
       current_explorer = &generator.explorer;
+      timer().start("explore");
       generator.explore(builder);
+      timer().finish("explore");
+      timer().start("write");
       builder.save(output_filename());
+      timer().finish("write");
     }
 
     bool run() override
@@ -295,7 +310,9 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
       mCRL2log(log::verbose) << options << std::endl;
       options.trace_prefix = input_filename();
       lps::stochastic_specification stochastic_lpsspec;
+      timer().start("load");
       lps::load_lps(stochastic_lpsspec, input_filename());
+      timer().finish("load");
       bool is_timed = stochastic_lpsspec.process().has_time();
 
       if (lps::is_stochastic(stochastic_lpsspec))
@@ -85,7 +85,9 @@ class lps2lts_tool : public lps2lts_base
                    "If the 'jittyc' rewriter is used, then the MCRL2_COMPILEREWRITER environment "
                    "variable (default value: 'mcrl2compilerewriter') determines the script that "
                    "compiles the rewriter, and MCRL2_COMPILEDIR (default value: '.') determines "
-                   "where temporary files are stored.\n"
+                   "where temporary files are stored. If MCRL2_JITTYC_CACHEDIR is set, compiled "
+                   "rewriters are kept in that directory and reused by later runs. MCRL2_JITTYC_UNITS "
+                   "sets the number of parts of the rewriter that are compiled in parallel.\n"
                    "\n"
                    "Note that lps2lts can deliver multiple transitions with the same label between"
                    "any pair of states. If this is not desired, such transitions can be removed by"
@@ -98,7 +100,9 @@ class lps2lts_tool : public lps2lts_base
                    "If the jittyc rewriter is used, then the MCRL2_COMPILEREWRITER environment "
                    "variable (default value: mcrl2compilerewriter) determines the script that "
                    "compiles the rewriter, and MCRL2_COMPILEDIR (default value: '.') "
-                   "determines where temporary files are stored."
+                   "determines where temporary files are stored. If MCRL2_JITTYC_CACHEDIR is set, "
+                   "compiled rewriters are kept in that directory and reused by later runs. "
+                   "MCRL2_JITTYC_UNITS sets the number of parts of the rewriter that are compiled in parallel."
                    "\n"
                    "Note that lps2lts can deliver multiple transitions with the same "
                    "label between any pair of states. If this is not desired, such "
@@ -115,7 +119,10 @@ class lps2lts_tool : public lps2lts_base
 
     bool run()
     {
+      timer().start("load");
       load_lps(m_options.specification, m_filename);
+      timer().finish("load");
+      m_options.timer = &timer();
       m_options.trace_prefix = m_filename.substr(0, m_options.trace_prefix.find_last_of('.'));
 
       m_options.validate_actions(); // Throws an exception if actions are not properly declared.
@@ -130,7 +130,9 @@ class ltsconvert_tool : public input_output_tool
       using namespace mcrl2::lts::detail;
 
       LTS_TYPE l;
+      timer().start("load");
       l.load(tool_options.infilename);
+      timer().finish("load");
       l.hide_actions(tool_options.tau_actions);
 
       if (tool_options.check_reach)
@@ -176,11 +176,12 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
     {
       //linearise infilename with options
       mcrl2::process::process_specification spec;
+      std::string text;
       if (input_filename().empty())
       {
         //parse specification from stdin
         mCRL2log(mcrl2::log::verbose) << "Reading input from stdin..." << std::endl;
-        spec = mcrl2::process::parse_process_specification(std::cin, !noalpha);
+        text = mcrl2::utilities::read_text(std::cin);
       }
       else
       {
@@ -192,9 +193,15 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
         {
           throw mcrl2::runtime_error("Cannot open input file: " + input_filename() + ".");
         }
-        spec = mcrl2::process::parse_process_specification(instream, !noalpha);
+        text = mcrl2::utilities::read_text(instream);
         instream.close();
       }
+      timer().start("parse");
+      spec = mcrl2::process::detail::parse_process_specification_new(text);
+      timer().finish("parse");
+      timer().start("typecheck");
+      mcrl2::process::detail::complete_process_specification(spec, !noalpha);
+      timer().finish("typecheck");
       //report on well-formedness (if needed)
       if (opt_check_only)
       {
@@ -211,12 +218,16 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
         return true;
       }
       //store the result
+      timer().start("linearise");
       mcrl2::lps::stochastic_specification linear_spec(mcrl2::lps::linearise(spec, m_linearisation_options));
+      timer().finish("linearise");
       mCRL2log(mcrl2::log::verbose) << "Writing LPS to "
                                     << (output_filename().empty() ? "stdout"
                                                                   : "file " + output_filename())
                                     << "..." << std::endl;
+      timer().start("write");
       mcrl2::lps::save_lps(linear_spec, output_filename());
+      timer().finish("write");
       return true;
     }
 };
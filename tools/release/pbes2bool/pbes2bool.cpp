@@ -238,7 +238,9 @@ class pbes2bool_tool: public rewriter_tool<pbes_input_tool<input_tool> >
 
       // load the pbes
       mcrl2::pbes_system::pbes p;
+      timer().start("load");
       mcrl2::bes::load_pbes(p, input_filename(), pbes_input_format());
+      timer().finish("load");
 
       pbes_system::algorithms::normalize(p);
       pbes_system::detail::instantiate_global_variables(p);
@@ -121,6 +121,10 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
       desc.add_hidden_option("no-replace-constants-by-variables", "Do not move constant expressions to a substitution.");
       desc.add_hidden_option("aggressive", "Apply optimizations 4 and 5 at every iteration.");
       desc.add_hidden_option("prune-todo-alternative", "Use a variation of todo list pruning.");
+      desc.add_option("enumeration-cache",
+                      utilities::make_optional_argument("NUM", "10000"),
+                      "Cache the solutions of at most NUM enumerations of quantifiers, which speeds up the instantiation "
+                      "if the same quantified expressions are encountered repeatedly.");
     }
 
 
@@ -135,6 +139,10 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
       options.prune_todo_alternative = parser.has_option("prune-todo-alternative");
       options.exploration_strategy = parser.option_argument_as<mcrl2::pbes_system::search_strategy>("search");
       options.rewrite_strategy = rewrite_strategy();
+      if (parser.has_option("enumeration-cache"))
+      {
+        options.enumeration_cache_size = parser.option_argument_as<std::size_t>("enumeration-cache");
+      }
 
       if (parser.has_option("file"))
       {
@@ -218,6 +226,10 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
       timer().start("instantiation");
       algorithm.run();
       timer().finish("instantiation");
+      if (options.enumeration_cache_size > 0)
+      {
+        mCRL2log(log::verbose) << "Enumeration cache: " << algorithm.rewriter().enumeration_cache_metrics().message() << std::endl;
+      }
 
       mCRL2log(log::verbose) << "Number of vertices in the structure graph: " << G.all_vertices().size() << std::endl;
 
@@ -265,7 +277,9 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
 
     bool run() override
     {
+      timer().start("load");
       pbes_system::pbes pbesspec = pbes_system::detail::load_pbes(input_filename());
+      timer().finish("load");
       pbes_system::algorithms::normalize(pbesspec);
 
       structure_graph G;